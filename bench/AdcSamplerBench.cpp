@@ -0,0 +1,56 @@
+#include "Bench.h"
+#include "AdcSampler.h"
+#include <vector>
+
+// One second of DMA output for channel 6: a 1.2 V level with 50 Hz hum
+// and conversion noise, in 1 KB frames as the driver delivers them.
+static std::vector<uint8_t> fakeSecond(uint32_t &seed) {
+    std::vector<uint8_t> out;
+    out.reserve(kAdcSampleHz * 4);
+    for(uint32_t i = 0; i < kAdcSampleHz; i++) {
+        seed = seed * 1664525 + 1013904223;
+        float hum = 40 * sinf(2 * (float)M_PI * 50 * i / kAdcSampleHz);
+        int code = 1489 + (int)hum + (int)(seed >> 27) - 16;
+        uint32_t w = (uint32_t)constrain(code, 0, 4095) | 6u << 13;
+        for(int b = 0; b < 4; b++) out.push_back(w >> (8 * b));
+    }
+    return out;
+}
+
+// Cost of decimating one second of conversions.
+BENCH(adc_decimate_1s) {
+    uint32_t seed = 1;
+    std::vector<uint8_t> data = fakeSecond(seed);
+    AdcDecimator *d = new AdcDecimator;
+    d->begin(6);
+    while(state.run())
+        for(size_t i = 0; i < data.size(); i += 1024) d->feed(data.data() + i, 1024);
+    state.counter("blocks", (double)d->blocks());
+    delete d;
+}
+
+// Spread of the smoothed value over a minute, in 12-bit codes; a single
+// analogRead() spreads over about 110 codes here.  The minute of data is
+// generated once, so only the decimator is timed.
+BENCH(adc_smoothed_spread) {
+    uint32_t seed = 1;
+    std::vector<uint8_t> minute;
+    for(int s = 0; s < 60; s++) {
+        std::vector<uint8_t> second = fakeSecond(seed);
+        minute.insert(minute.end(), second.begin(), second.end());
+    }
+    const size_t settle = 5 * kAdcSampleHz * 4;     // skip the first 5 s
+    AdcDecimator *d = new AdcDecimator;
+    double spread = 0;
+    while(state.run()) {
+        d->begin(6);
+        uint16_t lo = UINT16_MAX, hi = 0, v;
+        for(size_t i = 0; i < minute.size(); i += 1024) {
+            d->feed(minute.data() + i, 1024);
+            if(i >= settle && d->value(v)) { lo = min(lo, v); hi = max(hi, v); }
+        }
+        spread += (hi - lo) / 16.0;
+    }
+    delete d;
+    state.counter("codes", spread);
+}
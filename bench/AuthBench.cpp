@@ -0,0 +1,53 @@
+#include "Bench.h"
+#include "Firmware.h"
+#include "Auth.h"
+
+// "admin:admin", the factory default credentials.
+static const char *kGoodAuth = "Basic YWRtaW46YWRtaW4=";
+// "admin:wrong"
+static const char *kBadAuth = "Basic YWRtaW46d3Jvbmc=";
+
+static void authLoop(BenchState &state, const char *name, const char *value, bool expect) {
+    benchInitFirmware();
+    AsyncWebServerRequest req(HTTP_GET, "/api/settings");
+    if(name) req.hostSetHeader(name, value);
+    while(state.run()) {
+        if(authCheck(&req) != expect) abort();
+    }
+}
+
+// Basic credentials seen before: answered from the verified-header cache.
+BENCH(auth_basic_cached) { authLoop(state, "Authorization", kGoodAuth, true); }
+BENCH(auth_basic_badPassword) { authLoop(state, "Authorization", kBadAuth, false); }
+BENCH(auth_noHeader) { authLoop(state, nullptr, nullptr, false); }
+
+// First request with Basic credentials: decode and password hash.
+BENCH(auth_basic_cold) {
+    benchInitFirmware();
+    AsyncWebServerRequest req(HTTP_GET, "/api/settings");
+    req.hostSetHeader("Authorization", kGoodAuth);
+    while(state.run()) {
+        state.pause();
+        authReset();
+        state.resume();
+        if(!authCheck(&req)) abort();
+    }
+}
+
+static void sessionLoop(BenchState &state, bool cookie, bool basic = false) {
+    benchInitFirmware();
+    char token[kTokenLen + 1];
+    authIssue(token);
+    String value = cookie ? String("theme=dark; session=") + token : String("Bearer ") + token;
+    AsyncWebServerRequest req(HTTP_GET, "/api/settings");
+    req.hostSetHeader(cookie ? "Cookie" : "Authorization", value.c_str());
+    if(basic) req.hostSetHeader("Authorization", kGoodAuth);
+    while(state.run()) {
+        if(!authCheck(&req)) abort();
+    }
+}
+
+BENCH(auth_session_cookie) { sessionLoop(state, true); }
+BENCH(auth_session_bearer) { sessionLoop(state, false); }
+// The web UI: the cookie plus the Basic header the browser keeps sending.
+BENCH(auth_session_cookieAndBasic) { sessionLoop(state, true, true); }
@@ -0,0 +1,148 @@
+#include "Bench.h"
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ---- allocation counting ------------------------------------------------
+
+static std::atomic<uint64_t> allocCount{0};
+static std::atomic<uint64_t> allocBytes{0};
+
+uint64_t benchAllocCount() { return allocCount.load(std::memory_order_relaxed); }
+uint64_t benchAllocBytes() { return allocBytes.load(std::memory_order_relaxed); }
+
+static void *countedAlloc(size_t size) {
+    allocCount.fetch_add(1, std::memory_order_relaxed);
+    allocBytes.fetch_add(size, std::memory_order_relaxed);
+    void *p = malloc(size ? size : 1);
+    if(!p) throw std::bad_alloc();
+    return p;
+}
+
+void *operator new(size_t size) { return countedAlloc(size); }
+void *operator new[](size_t size) { return countedAlloc(size); }
+void *operator new(size_t size, const std::nothrow_t&) noexcept {
+    allocCount.fetch_add(1, std::memory_order_relaxed);
+    allocBytes.fetch_add(size, std::memory_order_relaxed);
+    return malloc(size ? size : 1);
+}
+void *operator new[](size_t size, const std::nothrow_t &t) noexcept { return operator new(size, t); }
+void operator delete(void *p) noexcept { free(p); }
+void operator delete[](void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+void operator delete[](void *p, size_t) noexcept { free(p); }
+
+// ---- harness ------------------------------------------------------------
+
+static uint64_t nowNs() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool BenchState::run() {
+    if(!running && done == 0) resume();
+    if(done < target) {
+        done++;
+        return true;
+    }
+    pause();
+    return false;
+}
+
+void BenchState::pause() {
+    if(!running) return;
+    elapsedNs += nowNs() - startNs;
+    allocs += benchAllocCount() - startAllocs;
+    allocBytes += benchAllocBytes() - startAllocBytes;
+    running = false;
+}
+
+void BenchState::resume() {
+    if(running) return;
+    running = true;
+    startAllocs = benchAllocCount();
+    startAllocBytes = benchAllocBytes();
+    startNs = nowNs();
+}
+
+void BenchState::counter(const char *name, double total) {
+    counterName = name;
+    counterTotal = total;
+}
+
+struct BenchEntry {
+    const char *name;
+    BenchFn fn;
+};
+
+static BenchEntry entries[128];
+static size_t entryCount = 0;
+
+BenchRegistrar::BenchRegistrar(const char *name, BenchFn fn) {
+    if(entryCount < sizeof(entries) / sizeof(entries[0])) entries[entryCount++] = {name, fn};
+}
+
+static int compareEntries(const void *a, const void *b) {
+    return strcmp(((const BenchEntry*)a)->name, ((const BenchEntry*)b)->name);
+}
+
+// Usage: bench [--csv] [--min-time=ms] [filter...]
+// Runs every benchmark whose name contains one of the filters.
+int main(int argc, char **argv) {
+    bool csv = false;
+    uint64_t minTimeNs = 200ULL * 1000 * 1000;
+    const char *filters[16];
+    size_t filterCount = 0;
+    for(int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "--csv") == 0) csv = true;
+        else if(strncmp(argv[i], "--min-time=", 11) == 0) minTimeNs = strtoull(argv[i] + 11, nullptr, 10) * 1000000ULL;
+        else if(filterCount < 16) filters[filterCount++] = argv[i];
+    }
+
+    qsort(entries, entryCount, sizeof(entries[0]), compareEntries);
+    if(csv) printf("name,iterations,ns_per_op,allocs_per_op,bytes_per_op,counter,counter_per_op\n");
+    else printf("%-40s %12s %12s %10s %10s\n", "benchmark", "iterations", "ns/op", "allocs/op", "B/op");
+
+    for(size_t i = 0; i < entryCount; i++) {
+        const BenchEntry &e = entries[i];
+        if(filterCount) {
+            bool match = false;
+            for(size_t f = 0; f < filterCount; f++)
+                if(strstr(e.name, filters[f])) match = true;
+            if(!match) continue;
+        }
+        // Grow the iteration count until one run takes at least minTime.
+        uint64_t n = 1;
+        BenchState *state = nullptr;
+        for(;;) {
+            delete state;
+            state = new BenchState(n);
+            e.fn(*state);
+            if(state->elapsedNs >= minTimeNs || n >= (1ULL << 30)) break;
+            uint64_t next = state->elapsedNs ? n * minTimeNs * 12 / 10 / state->elapsedNs : n * 100;
+            if(next <= n) next = n * 2;
+            if(next > n * 100) next = n * 100;
+            n = next;
+        }
+        double iters = (double)state->iterations();
+        double nsOp = state->elapsedNs / iters;
+        double allocOp = state->allocs / iters;
+        double bytesOp = state->allocBytes / iters;
+        if(csv) {
+            printf("%s,%llu,%.1f,%.2f,%.1f,%s,%.2f\n", e.name, (unsigned long long)state->iterations(),
+                   nsOp, allocOp, bytesOp, state->counterName ? state->counterName : "",
+                   state->counterName ? state->counterTotal / iters : 0.0);
+        } else {
+            printf("%-40s %12llu %12.1f %10.2f %10.1f", e.name,
+                   (unsigned long long)state->iterations(), nsOp, allocOp, bytesOp);
+            if(state->counterName) printf("  %s/op=%.1f", state->counterName, state->counterTotal / iters);
+            printf("\n");
+        }
+        fflush(stdout);
+        delete state;
+    }
+    return 0;
+}
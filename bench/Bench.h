@@ -0,0 +1,63 @@
+#ifndef BENCH_H
+#define BENCH_H
+#include <stddef.h>
+#include <stdint.h>
+
+// Tiny benchmark harness for the host-native build.  A benchmark body loops
+// while ``state.run()`` returns true; the harness picks the iteration count,
+// times the loop and counts heap allocations made inside it.  Setup that
+// must happen per iteration goes between ``pause()`` and ``resume()``.
+//
+//     BENCH(filter_sma5) {
+//         SMAFilter<float, 5> f;
+//         while(state.run()) f.add(1.0f);
+//     }
+
+class BenchState {
+public:
+    explicit BenchState(uint64_t iterations) : target(iterations) {}
+
+    bool run();
+    void pause();
+    void resume();
+    // Attach a custom per-operation counter, e.g. flash bytes written.
+    void counter(const char *name, double total);
+    uint64_t iterations() const { return target; }
+
+    uint64_t elapsedNs = 0;
+    uint64_t allocs = 0;
+    uint64_t allocBytes = 0;
+    const char *counterName = nullptr;
+    double counterTotal = 0;
+
+private:
+    uint64_t target;
+    uint64_t done = 0;
+    bool running = false;
+    uint64_t startNs = 0;
+    uint64_t startAllocs = 0;
+    uint64_t startAllocBytes = 0;
+};
+
+typedef void (*BenchFn)(BenchState &state);
+
+struct BenchRegistrar {
+    BenchRegistrar(const char *name, BenchFn fn);
+};
+
+// Heap allocations made through operator new since start-up.
+uint64_t benchAllocCount();
+uint64_t benchAllocBytes();
+
+// Keep the optimiser from discarding a computed value.
+template<typename T>
+inline void benchKeep(T const &value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+#define BENCH(name)                                                   \
+    static void bench_##name(BenchState &state);                      \
+    static BenchRegistrar bench_reg_##name(#name, bench_##name);      \
+    static void bench_##name(BenchState &state)
+
+#endif // BENCH_H
@@ -0,0 +1,126 @@
+#include "Bench.h"
+#include "Firmware.h"
+#include <LittleFS.h>
+#include "MsgBuffer.h"
+
+static const char *kTopic = "site/UNDEF/heartbeat";
+static const char *kPayload =
+    "{\"smoke\":12.5,\"lidar\":812.0,\"pressure\":-3.2,\"eco2\":455,\"tvoc\":21,"
+    "\"temp\":21.4,\"rh\":44.8,\"heap\":201344}";
+
+// Build an offline backlog of ``lines`` messages the way the firmware does:
+// stored while disconnected, spilled by bufferPoll() at the high-water mark.
+static void fill(size_t lines) {
+    mqtt.hostSetConnected(false);
+    for(size_t i = 0; i < lines; i++) {
+        bufferStore(kTopic, kPayload);
+        bufferPoll();
+    }
+    mqtt.hostSetConnected(true);
+}
+
+// Producer cost during an outage, spills included.
+BENCH(buffer_store) {
+    benchInitFirmware();
+    LittleFS.hostFormat();
+    bufferInit();
+    LittleFS.hostResetCounters();
+    mqtt.hostSetConnected(false);
+    while(state.run()) {
+        bufferStore(kTopic, kPayload);
+        bufferPoll();
+    }
+    mqtt.hostSetConnected(true);
+    state.counter("flashB", (double)LittleFS.hostBytesWritten());
+}
+
+// A few seconds of Wi-Fi roaming: 20 messages, then reconnect and flush.
+// Nothing should reach flash.
+BENCH(buffer_blip_20) {
+    benchInitFirmware();
+    mqtt.hostSetPublishHook(nullptr);
+    LittleFS.hostFormat();
+    bufferInit();
+    LittleFS.hostResetCounters();
+    while(state.run()) {
+        fill(20);
+        while(bufferFlush()) {}
+    }
+    state.counter("flashB", (double)LittleFS.hostBytesWritten());
+}
+
+// Replay a backlog of ``lines`` messages with the broker accepting all of
+// them.  One operation is one complete replay, batch after batch.
+static void flushAll(BenchState &state, size_t lines) {
+    benchInitFirmware();
+    mqtt.hostSetPublishHook(nullptr);
+    uint64_t written = 0;
+    while(state.run()) {
+        state.pause();
+        LittleFS.hostFormat();
+        bufferInit();
+        fill(lines);
+        LittleFS.hostResetCounters();
+        state.resume();
+        while(bufferFlush()) {}
+        written += LittleFS.hostBytesWritten();
+    }
+    state.counter("flashB", (double)written);
+}
+
+BENCH(buffer_flush_1000) { flushAll(state, 1000); }
+BENCH(buffer_flush_5000) { flushAll(state, 5000); }
+
+// The broker drops the connection half way through a 5000 line backlog.
+BENCH(buffer_flush_partial_5000) {
+    benchInitFirmware();
+    uint64_t written = 0;
+    while(state.run()) {
+        state.pause();
+        LittleFS.hostFormat();
+        bufferInit();
+        fill(5000);
+        LittleFS.hostResetCounters();
+        uint32_t sent = 0;
+        mqtt.hostSetPublishHook([&sent](const char*, const uint8_t*, unsigned int) {
+            return ++sent <= 2500;
+        });
+        state.resume();
+        while(bufferFlush()) {}
+        written += LittleFS.hostBytesWritten();
+    }
+    mqtt.hostSetPublishHook(nullptr);
+    state.counter("flashB", (double)written);
+}
+
+// A clog alarm raised at the end of an outage, behind 2000 heartbeats on
+// flash.  One operation is the whole paced replay through bufferPoll();
+// counts the messages published before the alarm.
+BENCH(buffer_alarm_first) {
+    benchInitFirmware();
+    uint64_t ahead = 0;
+    while(state.run()) {
+        state.pause();
+        LittleFS.hostFormat();
+        bufferInit();
+        fill(2000);
+        mqtt.hostSetConnected(false);
+        bufferStore("site/UNDEF/event/clog", "1.00");
+        mqtt.hostSetConnected(true);
+        uint32_t sent = 0;
+        bool seen = false;
+        mqtt.hostSetPublishHook([&](const char *topic, const uint8_t*, unsigned int) {
+            if(strstr(topic, "/event/clog")) seen = true;
+            else if(!seen) sent++;
+            return true;
+        });
+        state.resume();
+        while(bufferBacklogBytes()) {
+            nativeAdvanceMillis(kFlushIntervalMs);
+            bufferPoll();
+        }
+        ahead += sent;
+    }
+    mqtt.hostSetPublishHook(nullptr);
+    state.counter("ahead", (double)ahead);
+}
@@ -0,0 +1,77 @@
+#include "Bench.h"
+#include "ClogDetect.h"
+#include "Config.h"
+
+// Lidar noise of about ±20 mm with a short read now and then.
+static float noisyRead(float mm, uint32_t &seed) {
+    seed = seed * 1664525 + 1013904223;
+    if(seed % 29 == 0) return mm - 600;
+    return mm + (float)((seed >> 8) % 41) - 20;
+}
+
+// A chute at 1500 mm that stays empty for a day and then fills at
+// 3 mm/min; lidar every 10 min, pressure every minute drifting with the
+// fill.  leadMin: how long before the ClogMin alarm the first warning
+// (FILLING or PREDICTED) came.
+BENCH(clog_fill_lead) {
+    loadSettings();
+    double lead = 0;
+    while(state.run()) {
+        clogReset();
+        uint32_t seed = 1;
+        uint32_t warnMin = 0, blockMin = 0;
+        for(uint32_t t = 0; !blockMin && t < 2 * 24 * 60; t++) {
+            float fill = t < 24 * 60 ? 0 : (t - 24 * 60) * 3.0f;
+            clogAddPressure(20 + fill / 30 + (float)(seed % 3));
+            if(t % 10) continue;
+            clogAddLidar(t * 60000, noisyRead(1500 - fill, seed));
+            ClogLevel level = clogStatus().level;
+            if(level != CLOG_CLEAR && !warnMin) warnMin = t;
+            if(level == CLOG_BLOCKED) blockMin = t;
+        }
+        lead += blockMin - warnMin;
+    }
+    state.counter("leadMin", lead);
+}
+
+// Cost of one lidar read through the detector.
+BENCH(clog_add_lidar) {
+    loadSettings();
+    clogReset();
+    uint32_t seed = 1, t = 0;
+    while(state.run()) clogAddLidar(t += 600000, noisyRead(1500, seed));
+}
+
+// The same chute with the lidar cadence adapted by clogSamplePeriodMs()
+// between 5 s and 10 min, simulated in 1 s steps.
+static void adaptiveFill(BenchState &state, bool countReads) {
+    loadSettings();
+    double total = 0;
+    while(state.run()) {
+        clogReset();
+        uint32_t seed = 1, reads = 0, dueS = 0, blockS = 0;
+        double crossS = 86400 + (1500 - settings.clogMin) / 0.05;
+        for(uint32_t s = 0; !blockS && s < 2 * 86400; s++) {
+            float fill = s < 86400 ? 0 : (s - 86400) * 0.05f;
+            if(s % 60 == 0) clogAddPressure(20 + fill / 30);
+            if(s < dueS) continue;
+            clogAddLidar(s * 1000, noisyRead(1500 - fill, seed));
+            reads++;
+            dueS = s + clogSamplePeriodMs(5000, 600000) / 1000;
+            if(clogStatus().level == CLOG_BLOCKED) blockS = s;
+        }
+        total += countReads ? reads : blockS - crossS;
+    }
+    state.counter(countReads ? "reads" : "alarmLagS", total);
+}
+
+// Lidar reads over the quiet day and the fill (fixed 10 min: 181).
+BENCH(clog_adaptive_reads) {
+    adaptiveFill(state, true);
+}
+
+// Seconds from the true distance crossing ClogMin to the alarm, negative
+// when the noise trips it early (fixed 10 min with ClogHold 2: up to 20 min).
+BENCH(clog_adaptive_lag) {
+    adaptiveFill(state, false);
+}
@@ -0,0 +1,53 @@
+#include "Bench.h"
+#include "Config.h"
+#include <Preferences.h>
+
+// Boot with the settings blob in NVS.
+BENCH(settings_load) {
+    loadSettings();
+    while(state.run()) loadSettings();
+}
+
+// First boot after an update from the per-key layout: read every key,
+// then write the blob.
+BENCH(settings_load_migrate) {
+    while(state.run()) {
+        state.pause();
+        Preferences::hostReset();
+        state.resume();
+        loadSettings();
+    }
+    loadSettings();
+}
+
+// A settings POST that changes one threshold, written once debounced.
+BENCH(settings_save_changed) {
+    loadSettings();
+    uint32_t writes = Preferences::hostWrites();
+    uint32_t i = 0;
+    while(state.run()) {
+        settings.thr.smokeMax = 400 + (++i & 1);
+        settingsCommit();
+        settingsFlush();
+    }
+    state.counter("nvsWrites", Preferences::hostWrites() - writes);
+}
+
+// A POST that repeats the current values: nothing reaches NVS.
+BENCH(settings_save_unchanged) {
+    loadSettings();
+    uint32_t writes = Preferences::hostWrites();
+    while(state.run()) {
+        settingsCommit();
+        settingsFlush();
+    }
+    state.counter("nvsWrites", Preferences::hostWrites() - writes);
+}
+
+// A sensor task reading one threshold through a snapshot.
+BENCH(settings_snapshot_read) {
+    loadSettings();
+    float sum = 0;
+    while(state.run()) sum += SettingsRef()->thr.smokeMax;
+    benchKeep(sum);
+}
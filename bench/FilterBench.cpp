@@ -0,0 +1,36 @@
+#include "Bench.h"
+#include "Filter.h"
+
+// Feed a sawtooth with a spike every 16 samples so that the median has to
+// move samples across the two heaps as well as within them.
+template<typename F, typename T>
+static void filterAdd(BenchState &state) {
+    F f;
+    uint32_t i = 0;
+    while(state.run()) {
+        T v = (T)((i & 15) == 0 ? 1000 : (i * 37) % 200);
+        f.add(v);
+        i++;
+        benchKeep(f.value());
+    }
+}
+
+#define FILTER_BENCHES(name, F, T)                                           \
+    BENCH(filter_##name##_5) { filterAdd<F<T, 5>, T>(state); }               \
+    BENCH(filter_##name##_15) { filterAdd<F<T, 15>, T>(state); }             \
+    BENCH(filter_##name##_63) { filterAdd<F<T, 63>, T>(state); }             \
+    BENCH(filter_##name##_255) { filterAdd<F<T, 255>, T>(state); }
+
+FILTER_BENCHES(sma_float, SMAFilter, float)
+FILTER_BENCHES(sma_int16, SMAFilter, int16_t)
+FILTER_BENCHES(ema_float, EMAFilter, float)
+FILTER_BENCHES(median_float, MedianFilter, float)
+FILTER_BENCHES(median_int16, MedianFilter, int16_t)
+
+template<size_t N>
+using Q15 = EMAFilterQ15<N>;
+
+BENCH(filter_ema_q15_5) { filterAdd<Q15<5>, int16_t>(state); }
+BENCH(filter_ema_q15_15) { filterAdd<Q15<15>, int16_t>(state); }
+BENCH(filter_ema_q15_63) { filterAdd<Q15<63>, int16_t>(state); }
+BENCH(filter_ema_q15_255) { filterAdd<Q15<255>, int16_t>(state); }
@@ -0,0 +1,46 @@
+#include "Firmware.h"
+#include <Wire.h>
+#include "Config.h"
+#include "Crc.h"
+#include "Sensors.h"
+#include "MsgBuffer.h"
+#include "MqttPub.h"
+
+// SDP810-500Pa in continuous mode: 12.5 Pa, 21.0 °C, scale factor 60.
+static size_t sdp810Respond(uint8_t, uint8_t *buf, size_t len) {
+    const int16_t words[3] = {750, 4200, 60};
+    uint8_t frame[9];
+    for(int i = 0; i < 3; i++) {
+        frame[i * 3] = (uint8_t)(words[i] >> 8);
+        frame[i * 3 + 1] = (uint8_t)words[i];
+        frame[i * 3 + 2] = crc8Sensirion(&frame[i * 3], 2);
+    }
+    size_t n = len < sizeof(frame) ? len : sizeof(frame);
+    memcpy(buf, frame, n);
+    return n;
+}
+
+// ENS160 in standard mode with a new result on every read: status
+// (NEWDAT, validity normal), AQI 1, TVOC 21 ppb, eCO2 455 ppm.
+static size_t ens160Respond(uint8_t, uint8_t *buf, size_t len) {
+    const uint8_t regs[6] = {0x82, 1, 21, 0, 455 & 0xff, 455 >> 8};
+    size_t n = len < sizeof(regs) ? len : sizeof(regs);
+    memcpy(buf, regs, n);
+    return n;
+}
+
+void benchInitFirmware() {
+    static bool done = false;
+    if(done) return;
+    done = true;
+    Wire.hostSetResponder(0x25, sdp810Respond);
+    Wire.hostSetReceiver(0x25, [](uint8_t, const uint8_t*, size_t){});
+    Wire.hostSetResponder(0x53, ens160Respond);
+    Wire.hostSetReceiver(0x53, [](uint8_t, const uint8_t*, size_t){});
+    sensorsBegin();
+    nativeSetAnalog(34, 600);
+    mqtt.hostSetConnected(true);
+    bufferInit();
+    pubInit();
+    setupWeb();
+}
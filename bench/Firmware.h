@@ -0,0 +1,24 @@
+#ifndef BENCH_FIRMWARE_H
+#define BENCH_FIRMWARE_H
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <ESPAsyncWebServer.h>
+#include <PubSubClient.h>
+
+// Entry points and globals defined in src/main.cpp.  The firmware has no
+// header for them because nothing else on the device calls into main.cpp.
+extern PubSubClient mqtt;
+extern AsyncWebServer server;
+
+void checkSensors();
+void checkThreshold(const char *name, float value, float min, float max, bool &state);
+StaticJsonDocument<1280> buildSettingsJson();
+void publishEvent(const char *name, float value);
+void publishHeartbeat();
+void setupWeb();
+
+// Install host models for every I²C device, give the ADC a plausible MQ-2
+// voltage and register the web routes.  Safe to call more than once.
+void benchInitFirmware();
+
+#endif // BENCH_FIRMWARE_H
@@ -0,0 +1,47 @@
+#include "Bench.h"
+#include "History.h"
+#include <LittleFS.h>
+
+static const uint32_t kT0 = 1700000000;
+
+// One environmental cycle: six sensors every 60 s, the lidar every tenth.
+static void sample(uint32_t i) {
+    float v[HIST_COUNT];
+    v[HIST_LIDAR] = i % 10 ? NAN : 1500 - (i % 5000) * 0.2f;
+    v[HIST_SMOKE] = 100 + i % 7;
+    v[HIST_ECO2] = 450 + i % 13;
+    v[HIST_TVOC] = 20 + i % 5;
+    v[HIST_TEMP] = 20 + (i % 50) * 0.1f;
+    v[HIST_RH] = 45 - (i % 30) * 0.1f;
+    v[HIST_PRESSURE] = -3.2f;
+    historyAdd(kT0 + i * 60, v);
+}
+
+static void fresh() {
+    LittleFS.hostFormat();
+    LittleFS.begin(true);
+    historyInit();
+}
+
+// Steady-state cost per sample, rollups and block writes included.
+BENCH(history_add) {
+    fresh();
+    LittleFS.hostResetCounters();
+    uint32_t i = 0;
+    while(state.run()) sample(i++);
+    state.counter("flashB", (double)LittleFS.hostBytesWritten());
+}
+
+// A day of one sensor at 5-minute steps from the minute tier, rendered
+// as the JSON the endpoint streams.
+BENCH(history_query_day) {
+    fresh();
+    for(uint32_t i = 0; i < 3 * 1440; i++) sample(i);
+    uint8_t buf[1460];
+    while(state.run()) {
+        HistoryReader r(HIST_TEMP, kT0 + 86400, kT0 + 2 * 86400, 300);
+        size_t total = 0, n;
+        while((n = r.readJson(buf, sizeof(buf))) > 0) total += n;
+        benchKeep(total);
+    }
+}
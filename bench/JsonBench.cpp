@@ -0,0 +1,63 @@
+#include "Bench.h"
+#include "Firmware.h"
+#include "Config.h"
+#include "MqttPub.h"
+
+BENCH(json_settings_build) {
+    benchInitFirmware();
+    while(state.run()) {
+        StaticJsonDocument<1280> doc = buildSettingsJson();
+        String out;
+        serializeJson(doc, out);
+        benchKeep(out.length());
+    }
+}
+
+BENCH(json_heartbeat_publish) {
+    benchInitFirmware();
+    while(state.run()) publishHeartbeat();
+}
+
+BENCH(json_api_live) {
+    benchInitFirmware();
+    while(state.run()) {
+        AsyncWebServerRequest req(HTTP_GET, "/api/live");
+        server.hostDispatch(&req);
+        benchKeep(req.hostResponse());
+    }
+}
+
+BENCH(json_api_settings_get) {
+    benchInitFirmware();
+    while(state.run()) {
+        AsyncWebServerRequest req(HTTP_GET, "/api/settings");
+        req.hostSetHeader("Authorization", "Basic YWRtaW46YWRtaW4=");
+        server.hostDispatch(&req);
+        benchKeep(req.hostResponse());
+    }
+}
+
+// Heartbeat from the sensor task to the broker in each payload format:
+// bytes handed to the MQTT client per publish, and heap use on the way.
+static void heartbeatOnWire(BenchState &state, uint8_t format) {
+    benchInitFirmware();
+    mqtt.hostSetPublishHook(nullptr);
+    settings.mqttFormat = format;
+    settingsCommit();
+    mqtt.hostResetCounters();
+    while(state.run()) {
+        publishHeartbeat();
+        pubService(0);
+    }
+    state.counter("wireB", (double)mqtt.hostPublishedBytes());
+    settings.mqttFormat = MQTT_JSON;
+    settingsCommit();
+}
+
+BENCH(mqtt_heartbeat_json) {
+    heartbeatOnWire(state, MQTT_JSON);
+}
+
+BENCH(mqtt_heartbeat_msgpack) {
+    heartbeatOnWire(state, MQTT_MSGPACK);
+}
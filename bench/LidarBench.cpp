@@ -0,0 +1,31 @@
+#include "Bench.h"
+#include "Lidar.h"
+
+// A stretch of SF11/C output as captured on the chute: readings with and
+// without the unit, a lost-signal frame and a line cut by a UART overrun.
+static const char kRecording[] =
+    "0.81 m\r\n0.82 m\r\n 0.79 m\r\n0.80\r\n-1.00 m\r\n0.8#1 m\r\n"
+    "0.83 m\r\n0.81 m\r\n12.345 m\r\n0.80 m\r\n";
+
+BENCH(lidar_parse) {
+    LidarParser p;
+    int32_t sum = 0;
+    while(state.run()) {
+        for(const char *c = kRecording; *c; c++)
+            if(p.feed((uint8_t)*c) == LidarParser::FRAME) sum += p.mm();
+        benchKeep(sum);
+    }
+    state.counter("bytes", (double)state.iterations() * (sizeof(kRecording) - 1));
+}
+
+// Replay through the UART receive callback and read the average.
+BENCH(lidar_uart_replay) {
+    lidarBegin(Serial1, 9, 10);
+    LidarReading r;
+    while(state.run()) {
+        Serial1.hostFeed(kRecording);
+        lidarGet(r);
+        benchKeep(r.distance);
+    }
+    Serial1.onReceive(nullptr);
+}
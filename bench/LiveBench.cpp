@@ -0,0 +1,33 @@
+#include "Bench.h"
+#include "LivePush.h"
+#include "Readings.h"
+
+// Three browsers watching while the lidar and the servos report new
+// values, one of them on a link that only drains every tenth push.
+BENCH(live_push_delta) {
+    AsyncWebSocket ws("/ws");
+    ws.onEvent([](AsyncWebSocket *, AsyncWebSocketClient *c, AwsEventType type,
+                  void *, uint8_t *, size_t) { liveOnEvent(c, type); });
+    liveBegin(&ws);
+    AsyncWebSocketClient *fast[2] = {ws.hostConnect(), ws.hostConnect()};
+    AsyncWebSocketClient *slow = ws.hostConnect();
+    slow->hostSetQueueLimit(1);
+    LiveStats before = liveStats();
+    uint32_t i = 0;
+    while(state.run()) {
+        float v[READ_COUNT];
+        v[READ_LIDAR] = 800 + i % 7;
+        readingsPublish(1 << READ_LIDAR, v);
+        if(i % 4 == 0) readingsSetHead(90 + i % 3, 90);
+        nativeAdvanceMillis(100);   // the per-client minimum interval
+        livePush();
+        for(AsyncWebSocketClient *c : fast) c->hostDrain();
+        if(i % 10 == 0) slow->hostDrain();
+        i++;
+    }
+    LiveStats after = liveStats();
+    state.counter("wsB", after.bytes - before.bytes);
+    for(AsyncWebSocketClient *c : fast) ws.hostDisconnect(c);
+    ws.hostDisconnect(slow);
+    liveBegin(nullptr);
+}
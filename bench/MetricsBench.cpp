@@ -0,0 +1,33 @@
+#include "Bench.h"
+#include "Metrics.h"
+
+// Counts the bytes of a rendered page.
+class CountingPrint : public Print {
+public:
+    size_t write(uint8_t) override {
+        bytes++;
+        return 1;
+    }
+    size_t write(const uint8_t *, size_t len) override {
+        bytes += len;
+        return len;
+    }
+    size_t bytes = 0;
+};
+
+// Recording one latency sample, as every sensor read and publish does.
+BENCH(metrics_time) {
+    uint32_t us = 0;
+    while(state.run()) metricsTime(MET_READ_SDP810, (us += 37) & 0xffff);
+}
+
+// Rendering /api/metrics.
+BENCH(metrics_write) {
+    size_t bytes = 0;
+    while(state.run()) {
+        CountingPrint out;
+        metricsWrite(out);
+        bytes = out.bytes;
+    }
+    state.counter("bytes", bytes * state.iterations());
+}
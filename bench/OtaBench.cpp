@@ -0,0 +1,140 @@
+#include "Bench.h"
+#include "OtaStream.h"
+#include "mbedtls/ecdsa.h"
+#include <vector>
+
+static const size_t kImageLen = 256 * 1024;
+static const size_t kChunk = 1436;              // one TCP segment per upload callback
+// P-256 private key of the bench packages; its public half is also the
+// OTA_PUBLIC_KEY of the native build.
+static const uint8_t kPrivateKey[32] = {
+    0x6f, 0x74, 0x61, 0x2d, 0x62, 0x65, 0x6e, 0x63, 0x68, 0x2d, 0x6b, 0x65, 0x79, 0x2d, 0x6e, 0x6f,
+    0x74, 0x2d, 0x66, 0x6f, 0x72, 0x2d, 0x64, 0x65, 0x76, 0x69, 0x63, 0x65, 0x73, 0x2d, 0x30, 0x31,
+};
+
+// Something shaped like firmware: runs of a few hundred recurring
+// instruction words with literal data in between.
+static std::vector<uint8_t> fakeImage() {
+    std::vector<uint8_t> img;
+    uint32_t seed = 7;
+    auto next = [&]() { return seed = seed * 1664525 + 1013904223; };
+    uint32_t words[300];
+    for(uint32_t &w : words) w = next();
+    while(img.size() < kImageLen) {
+        uint32_t r = next();
+        uint32_t w = r % 5 ? words[(r >> 8) % 300] : next();
+        for(int i = 0; i < 4; i++) img.push_back(w >> (8 * i));
+    }
+    img.resize(kImageLen);
+    return img;
+}
+
+static void putBits(std::vector<uint8_t> &out, uint32_t &acc, uint8_t &bits, uint32_t v, uint8_t n) {
+    acc = (acc << n) | v;
+    bits += n;
+    while(bits >= 8) {
+        bits -= 8;
+        out.push_back(acc >> bits);
+    }
+}
+
+// Greedy heatshrink encoder (-w 11 -l 4) with one candidate per position,
+// enough to give the decoder realistic input.
+static std::vector<uint8_t> heatshrink(const std::vector<uint8_t> &in) {
+    const size_t window = 1 << 11, longest = 16;
+    std::vector<uint8_t> out;
+    std::vector<int32_t> last(65536, -1);
+    uint32_t acc = 0;
+    uint8_t bits = 0;
+    for(size_t i = 0; i < in.size();) {
+        size_t len = 0, dist = 0;
+        if(i + 2 <= in.size()) {
+            uint16_t key = in[i] | (in[i + 1] << 8);
+            int32_t j = last[key];
+            last[key] = i;
+            if(j >= 0 && i - j <= window) {
+                size_t limit = min(longest, in.size() - i);
+                while(len < limit && in[j + len] == in[i + len]) len++;
+                dist = i - j;
+            }
+        }
+        if(len >= 2) {
+            putBits(out, acc, bits, 0, 1);
+            putBits(out, acc, bits, dist - 1, 11);
+            putBits(out, acc, bits, len - 1, 4);
+            for(size_t k = 1; k < len && i + k + 2 <= in.size(); k++)
+                last[in[i + k] | (in[i + k + 1] << 8)] = i + k;
+            i += len;
+        } else {
+            putBits(out, acc, bits, 1, 1);
+            putBits(out, acc, bits, in[i], 8);
+            i++;
+        }
+    }
+    if(bits) out.push_back(acc << (8 - bits));
+    return out;
+}
+
+static int benchRandom(void*, unsigned char *buf, size_t len) {
+    static uint32_t seed = 1;
+    for(size_t i = 0; i < len; i++) buf[i] = (seed = seed * 1664525 + 1013904223) >> 24;
+    return 0;
+}
+
+// Manifest and body as tools/ota_pack.py writes them; ``publicKey`` gets
+// the key to verify them with.
+static std::vector<uint8_t> package(const std::vector<uint8_t> &img, bool compress,
+                                    uint8_t publicKey[kOtaPublicKeyLen]) {
+    std::vector<uint8_t> body = compress ? heatshrink(img) : img;
+    uint8_t h[kOtaHeaderLen] = {'C', 'H', 'P', 'O', 2, (uint8_t)compress, 11, 4};
+    uint32_t n = img.size();
+    memcpy(h + 8, &n, 4);
+    mbedtls_sha256_ret(img.data(), img.size(), h + 12, 0);
+    // ECDSA P-256 of the SHA-256 of the first 44 bytes, r || s.
+    uint8_t hash[32];
+    mbedtls_sha256_ret(h, 44, hash, 0);
+    mbedtls_ecp_group grp;
+    mbedtls_ecp_point q;
+    mbedtls_mpi d, r, s;
+    size_t len;
+    mbedtls_ecp_group_load(&grp, MBEDTLS_ECP_DP_SECP256R1);
+    mbedtls_mpi_read_binary(&d, kPrivateKey, sizeof(kPrivateKey));
+    mbedtls_ecp_mul(&grp, &q, &d, &grp.G, benchRandom, nullptr);
+    mbedtls_ecp_point_write_binary(&grp, &q, MBEDTLS_ECP_PF_UNCOMPRESSED, &len, publicKey, kOtaPublicKeyLen);
+    mbedtls_ecdsa_sign(&grp, &r, &s, &d, hash, sizeof(hash), benchRandom, nullptr);
+    mbedtls_mpi_write_binary(&r, h + 44, 32);
+    mbedtls_mpi_write_binary(&s, h + 76, 32);
+    std::vector<uint8_t> pkg(h, h + sizeof(h));
+    pkg.insert(pkg.end(), body.begin(), body.end());
+    return pkg;
+}
+
+static bool discard(const uint8_t*, size_t) {
+    return true;
+}
+
+// Decode, hash and verify one 256 KB package arriving in upload chunks.
+// Reports the upload size as a percentage of the image.
+static void runUpload(BenchState &state, bool compress) {
+    uint8_t publicKey[kOtaPublicKeyLen];
+    std::vector<uint8_t> pkg = package(fakeImage(), compress, publicKey);
+    OtaStream *ota = new OtaStream;
+    bool ok = true;
+    while(state.run()) {
+        ota->begin(discard, publicKey);
+        for(size_t i = 0; i < pkg.size(); i += kChunk)
+            ota->feed(pkg.data() + i, min(kChunk, pkg.size() - i));
+        ok &= ota->finish();
+    }
+    delete ota;
+    if(!ok) fprintf(stderr, "ota: verification failed\n");
+    state.counter("sizePct", 100.0 * pkg.size() / kImageLen * state.iterations());
+}
+
+BENCH(ota_heatshrink_256k) {
+    runUpload(state, true);
+}
+
+BENCH(ota_plain_256k) {
+    runUpload(state, false);
+}
@@ -0,0 +1,40 @@
+#include "Bench.h"
+#include "Firmware.h"
+#include "MqttPub.h"
+
+// Cost to a sensor task of publishing one event while the broker takes a
+// millisecond per publish.  The queue is drained outside the timed region,
+// as the publisher task would do on the other core.
+BENCH(pub_event_slow_broker) {
+    benchInitFirmware();
+    mqtt.hostSetPublishHook([](const char*, const uint8_t*, unsigned int) {
+        delayMicroseconds(1000);
+        return true;
+    });
+    uint64_t i = 0;
+    while(state.run()) {
+        publishEvent("smoke", 412.5f);
+        if((++i & 7) == 0) {
+            state.pause();
+            pubService(0);
+            state.resume();
+        }
+    }
+    state.pause();
+    pubService(0);
+    state.resume();
+    mqtt.hostSetPublishHook(nullptr);
+    state.counter("pubMaxUs", (double)pubStats().maxUs * state.iterations());
+}
+
+// Publisher side: drain a full queue into a fast broker.
+BENCH(pub_drain_16) {
+    benchInitFirmware();
+    mqtt.hostSetPublishHook(nullptr);
+    while(state.run()) {
+        state.pause();
+        for(int i = 0; i < 16; i++) pubEnqueue("site/UNDEF/event/smoke", "412.50");
+        state.resume();
+        pubService(0);
+    }
+}
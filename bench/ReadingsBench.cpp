@@ -0,0 +1,23 @@
+#include "Bench.h"
+#include "Readings.h"
+
+// A web handler taking the whole snapshot while nothing is being written.
+BENCH(readings_get) {
+    float sum = 0;
+    while(state.run()) {
+        Readings r;
+        readingsGet(r);
+        sum += r.value[READ_LIDAR];
+    }
+    benchKeep(sum);
+}
+
+// One environmental cycle publishing six readings.
+BENCH(readings_publish) {
+    float v[READ_COUNT] = {0};
+    uint32_t i = 0;
+    while(state.run()) {
+        v[READ_SMOKE] = (float)(i++ & 63);
+        readingsPublish(0x7e, v);
+    }
+}
@@ -0,0 +1,20 @@
+#include "Bench.h"
+#include "Scan.h"
+
+// Metrics of a full 15 x 15 map against the previous scan, with a few
+// empty cells and a blockage growing in one corner.
+BENCH(scan_compare_15x15) {
+    static DepthMap prev, cur;
+    prev.cols = cur.cols = kScanMaxDim;
+    prev.rows = cur.rows = kScanMaxDim;
+    prev.ms = 1;
+    for(int i = 0; i < kScanMaxDim * kScanMaxDim; i++) {
+        prev.mm[i] = (uint16_t)(900 + i % 7);
+        cur.mm[i] = i % 31 == 0 ? 0 : (uint16_t)(i < 40 ? 300 : 905);
+    }
+    ScanMetrics m;
+    while(state.run()) {
+        scanCompare(cur, &prev, 400, m);
+        benchKeep(m);
+    }
+}
@@ -0,0 +1,31 @@
+#include "Bench.h"
+#include "Scheduler.h"
+
+static void noop() {}
+
+// Cost of one wakeup: run the job that is due and find the next deadline,
+// with a full table of jobs on co-prime periods.
+BENCH(scheduler_runDue_8) {
+    Scheduler sched;
+    const uint32_t periods[Scheduler::kMaxJobs] = {7, 11, 13, 17, 19, 23, 29, 31};
+    for(int i = 0; i < Scheduler::kMaxJobs; i++) sched.add(noop, periods[i], 0);
+    uint32_t now = 0;
+    while(state.run()) {
+        sched.runDue(now);
+        now += sched.msUntilNext(now);
+        benchKeep(now);
+    }
+}
+
+// Servo moves pull the lidar job forward between its periodic runs.
+BENCH(scheduler_trigger) {
+    Scheduler sched;
+    sched.add(noop, 60000, 0);
+    int lidar = sched.add(noop, 600000, 0);
+    uint32_t now = 0;
+    while(state.run()) {
+        now += 100;
+        sched.trigger(lidar, now);
+        sched.runDue(now);
+    }
+}
@@ -0,0 +1,53 @@
+#include "Bench.h"
+#include "Firmware.h"
+#include "Config.h"
+#include "MqttPub.h"
+#include "Sensors.h"
+#include <Wire.h>
+
+// One environmental cycle with every reading inside its limits.
+BENCH(sensors_checkSensors) {
+    benchInitFirmware();
+    Settings saved = settings;
+    settings.thr.smokeMax = 1e6f;
+    settings.thr.presMin = -1e6f;
+    settings.thr.presMax = 1e6f;
+    settingsCommit();
+    while(state.run()) checkSensors();
+    settings = saved;
+    settingsCommit();
+}
+
+BENCH(sensors_checkThreshold_inBand) {
+    benchInitFirmware();
+    bool alarm = false;
+    float v = 100;
+    while(state.run()) {
+        checkThreshold("smoke", v, 0, 400, alarm);
+        benchKeep(alarm);
+    }
+}
+
+// Every call crosses the hysteresis band, so each one publishes an event.
+BENCH(sensors_checkThreshold_toggle) {
+    benchInitFirmware();
+    bool alarm = false;
+    uint64_t i = 0;
+    while(state.run()) {
+        checkThreshold("smoke", (i++ & 1) ? 100.0f : 900.0f, 0, 400, alarm);
+        if((i & 7) == 0) {
+            state.pause();
+            pubService(0);      // the publisher task would drain the queue
+            state.resume();
+        }
+    }
+}
+
+// One sampling cycle; the counter is I²C bytes moved per cycle.
+BENCH(sensors_sample) {
+    benchInitFirmware();
+    SensorSample s;
+    Wire.hostResetCounters();
+    while(state.run()) sensorsSample(s);
+    state.counter("i2cB", (double)Wire.hostBytes());
+}
@@ -0,0 +1,38 @@
+#include "Bench.h"
+#include "Config.h"
+#include "MqttPub.h"
+#include "Trace.h"
+
+// Cost to the caller of one servo record, what servoTask pays per step.
+BENCH(trace_record) {
+    int32_t i = 0;
+    while(state.run()) {
+        trace(TR_SERVO, i, -i);
+        i++;
+    }
+}
+
+// Trace task with the MQTT stream on: format a burst of 64 records into
+// rate-limited batches.  Reports the batches queued per burst.
+BENCH(trace_drain_64) {
+    loadSettings();
+    settings.debugEnable = true;
+    settingsCommit();
+    pubInit();
+    traceDrain();
+    double batches = 0;
+    while(state.run()) {
+        state.pause();
+        pubService(0);
+        for(int i = 0; i < 64; i++) trace(TR_SERVO, i, 90);
+        uint32_t before = pubStats().depth;
+        state.resume();
+        traceDrain();
+        state.pause();
+        batches += pubStats().depth - before;
+        state.resume();
+    }
+    settings.debugEnable = false;
+    settingsCommit();
+    state.counter("batches", batches);
+}
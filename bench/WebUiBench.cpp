@@ -0,0 +1,26 @@
+#include "Bench.h"
+#include "Firmware.h"
+
+// First load of the page and a reload by a browser holding the current
+// version, which costs a header round trip and no body.
+static void indexLoop(BenchState &state, bool cached) {
+    benchInitFirmware();
+    String etag;
+    {
+        AsyncWebServerRequest req(HTTP_GET, "/");
+        server.hostDispatch(&req);
+        etag = *req.hostResponse()->hostHeader("ETag");
+    }
+    size_t sent = 0;
+    while(state.run()) {
+        AsyncWebServerRequest req(HTTP_GET, "/");
+        if(cached) req.hostSetHeader("If-None-Match", etag.c_str());
+        server.hostDispatch(&req);
+        req.hostResponse()->hostRender();
+        sent += req.hostResponse()->hostBody().size();
+    }
+    state.counter("bodyB", sent);
+}
+
+BENCH(web_index_get) { indexLoop(state, false); }
+BENCH(web_index_not_modified) { indexLoop(state, true); }
@@ -0,0 +1,66 @@
+#ifndef ADC_SAMPLER_H
+#define ADC_SAMPLER_H
+#include <Arduino.h>
+#include <atomic>
+
+// Continuous oversampling of one ADC1 input.
+//
+// The ADC converts the pin in DMA mode at kAdcSampleHz without the CPU.  A
+// task sums each block of kAdcDecimation 12-bit conversions (one 50 Hz
+// mains period) into one 16-bit value and smooths the blocks with an
+// exponential average over 1 << kAdcSmoothShift blocks.  The arithmetic is
+// integer throughout; readers take the latest smoothed value without
+// waiting for a conversion.
+
+static const uint32_t kAdcSampleHz = 25600;
+static const uint16_t kAdcDecimation = 512;        // 20 ms per block
+static const uint8_t kAdcSmoothShift = 6;          // about 1.3 s
+static const uint16_t kAdcFullScale = 4095 << 4;   // value at the top code
+
+struct AdcSamplerStats {
+    uint32_t samples;       // conversions of the channel taken
+    uint32_t blocks;        // decimated values
+    uint32_t overruns;      // DMA buffer filled before the task read it
+};
+
+// Decimation and smoothing of the DMA output.  One task feeds it; any task
+// may read the value.  Nothing here touches the hardware, so it also runs
+// in the host build.
+class AdcDecimator {
+public:
+    // Start over for ADC1 ``channel``.
+    void begin(uint8_t channel);
+
+    // Consume ``len`` bytes of DMA output: 4-byte TYPE2 conversion words,
+    // data in bits 0..11, channel in 13..16, unit in 17.  Conversions of
+    // other channels are skipped.
+    void feed(const uint8_t *data, size_t len);
+
+    // The smoothed value, 0..kAdcFullScale.  False until the first block.
+    bool value(uint16_t &v) const;
+
+    uint32_t samples() const { return sampleCount; }
+    uint32_t blocks() const { return blockCount; }
+
+private:
+    uint8_t channel = 0;
+    uint32_t sum = 0;
+    uint16_t count = 0;
+    uint32_t smooth = 0;                // value << kAdcSmoothShift
+    std::atomic<int32_t> latest{-1};    // -1: no block yet
+    std::atomic<uint32_t> sampleCount{0};
+    std::atomic<uint32_t> blockCount{0};
+};
+
+// Start converting ``pin`` and the task that decimates it.  Returns false
+// when the pin is not on ADC1 or the driver refuses; the caller then reads
+// the pin directly.
+bool adcSamplerBegin(uint8_t pin);
+
+// The smoothed value of the pin, 0..kAdcFullScale.  False until the first
+// block is in or when the sampler is not running.
+bool adcSamplerValue(uint16_t &value);
+
+AdcSamplerStats adcSamplerStats();
+
+#endif // ADC_SAMPLER_H
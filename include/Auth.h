@@ -0,0 +1,43 @@
+#ifndef AUTH_H
+#define AUTH_H
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+
+// Web UI authentication.
+//
+// A request is let in with HTTP Basic credentials, checked against
+// settings.uiUser and the SHA-256 in settings.uiPass, or with a session
+// token from POST /api/login sent back as the ``session`` cookie or as
+// ``Authorization: Bearer <token>``.  A token is its expiry followed by a
+// SipHash tag of it under a key drawn on first use, so checking one needs
+// no password hash; a reboot or authReset() ends every session.  The
+// cookie is checked before Basic credentials sent alongside it.
+//
+// Basic headers that passed are remembered for a few minutes by their
+// SipHash under the same key, so a browser repeating the same header skips
+// the decode and the password hash.  Only tags are kept, never the
+// credentials.  Secrets are compared in constant time.
+//
+// Everything here runs on the web server task and is not locked.
+
+static const uint32_t kSessionSec = 3600;
+static const size_t kTokenLen = 8 + 1 + 16;    // hex expiry, '.', hex tag
+
+// SHA-256 of ``pwd`` as 64 lowercase hex digits, the form kept in
+// settings.uiPass.
+void authHashPassword(const char *pwd, char hex[65]);
+
+// True when the request carries valid credentials or a live session.
+bool authCheck(AsyncWebServerRequest *req);
+
+// Check a user name and password.
+bool authVerify(const char *user, const char *pass);
+
+// Write a new session token of kTokenLen characters and a terminator.
+void authIssue(char *token);
+
+// Draw new keys: ends all sessions and forgets cached credentials.  Call
+// after the user name or password changes.
+void authReset();
+
+#endif // AUTH_H
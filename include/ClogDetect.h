@@ -0,0 +1,62 @@
+#ifndef CLOG_DETECT_H
+#define CLOG_DETECT_H
+#include <Arduino.h>
+
+// Early clog detection from the lidar distance and the draught pressure.
+//
+// Each lidar read passes a median of three, which drops lone spikes, and
+// then updates, in constant time:
+//  * a Holt estimate (level and trend) of the distance, with gains scaled
+//    to the time between reads so that any cadence works.  The trend is
+//    the fill rate, and extrapolating it to ClogMin gives the time left;
+//  * a one-sided CUSUM of the drop below the empty-chute distance.  Small
+//    sustained drops add up, isolated noisy reads are forgotten, and one
+//    read adds at most a third of the alarm level.
+// Each pressure read updates a CUSUM of its deviation from a slowly
+// tracked baseline, since a blockage changes the draught in the chute.
+//
+// Grades: FILLING when the distance CUSUM reaches its alarm level, or the
+// pressure CUSUM does while the distance trends down; PREDICTED when the
+// trend also reaches ClogMin within the horizon; BLOCKED after ClogHold
+// consecutive reads below ClogMin, the hard alarm.  A grade above CLEAR is
+// kept until both CUSUMs fall below half their level; the sums stop at the
+// alarm level, so an emptied chute clears within a few reads.  Parameters are
+// Settings::detect, clogMin and clogHold.
+//
+// Feed from the sampling task only; clogStatus() is safe from any task.
+
+enum ClogLevel : uint8_t {
+    CLOG_CLEAR,
+    CLOG_FILLING,
+    CLOG_PREDICTED,
+    CLOG_BLOCKED
+};
+
+struct ClogStatus {
+    ClogLevel level;
+    float readMm;           // last lidar read
+    float distMm;           // smoothed distance, NAN before the first read
+    float rateMmMin;        // fill rate, positive while the distance shrinks
+    float etaMin;           // minutes until ClogMin at that rate, INFINITY if not filling
+    float lidarScore;       // distance CUSUM, mm
+    float presScore;        // pressure CUSUM, Pa
+};
+
+// Forget everything learnt, including the empty-chute distance.
+void clogReset();
+
+// Feed a lidar distance read at ``ms``.  True when the grade changed.
+bool clogAddLidar(uint32_t ms, float mm);
+
+// Feed a differential pressure.  True when the grade changed.
+bool clogAddPressure(float pa);
+
+// Lidar period for the current state, between ``fastMs`` and ``slowMs``:
+// slow while the chute is far from ClogMin, shorter in proportion as the
+// distance closes in, and at most a tenth of the predicted time left.
+// Call from the sampling task.
+uint32_t clogSamplePeriodMs(uint32_t fastMs, uint32_t slowMs);
+
+ClogStatus clogStatus();
+
+#endif // CLOG_DETECT_H
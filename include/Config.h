@@ -2,7 +2,8 @@
 #define CONFIG_H
 
 // Helper types to keep all runtime configuration in one place.
-// These structures are persisted to NVS by loadSettings()/saveSettings().
+// These structures are persisted to NVS by loadSettings()/settingsCommit()
+// as one CRC-protected blob; new fields go at the end of Settings.
 #include <Arduino.h>
 
 // Alarm limits for sensors.  Values outside of the min/max range
@@ -20,6 +21,34 @@ struct Thresholds {
     float presMax   = 500;
 };
 
+// Raster scan of the chute cross-section with the lidar head (see Scan.h).
+struct ScanSettings {
+    uint8_t xMin = 45;                  // Servo angles bounding the grid, degrees
+    uint8_t xMax = 135;
+    uint8_t yMin = 45;
+    uint8_t yMax = 135;
+    uint8_t cols = 15;                  // Grid points per axis, 2..kScanMaxDim
+    uint8_t rows = 15;
+    uint16_t periodMin = 60;            // Scheduled scan interval, 0 = on demand only
+};
+
+// Early clog detection from the lidar trend and the draught pressure (see
+// ClogDetect.h).  A read adds its excess over the drift allowance to a
+// running sum; the sum reaching the alarm level means the chute is filling.
+struct ClogDetectSettings {
+    uint16_t driftMm = 30;              // Drop below the empty-chute distance taken as noise
+    uint16_t alarmMm = 150;             // Summed excess drop that means filling
+    float driftPa = 2;                  // Pressure deviation taken as noise
+    float alarmPa = 40;                 // Summed excess deviation that backs a falling trend
+    uint16_t horizonMin = 120;          // Warn when ClogMin is this close at the fill rate
+};
+
+// Encoding of the heartbeat, event and scan payloads published to MQTT.
+enum MqttFormat : uint8_t {
+    MQTT_JSON,
+    MQTT_MSGPACK        // same fields as the JSON in fewer bytes
+};
+
 struct Settings {
     char siteName[25] = "UNDEF";        // Station identifier used in MQTT topics
     char wifiSSID[33] = "";             // Credentials for Wi‑Fi STA mode
@@ -29,23 +58,87 @@ struct Settings {
     char mqttUser[33] = "";             // MQTT auth
     char mqttPass[65] = "";
     uint8_t mqttQos = 0;                // Default QoS for publishes
+    uint8_t mqttFormat = MQTT_JSON;     // Payload encoding, see MqttFormat
+    uint16_t bufSpillSec = 30;          // Outage length before buffered messages go to flash
     char uiUser[17] = "admin";          // Web UI credentials (username)
     // Default password is "admin" with SHA-256 applied
     char uiPass[65] = "8c6976e5b5410415bde908bd4dee15dfb167a9c873fc4bb8a81f6f2ab448a918";
                                          // Web UI password (SHA256 hash)
-    bool debugEnable = false;           // If true, publish debug messages
+    bool debugEnable = false;           // If true, stream the trace log to MQTT
     Thresholds thr;                     // Per-sensor alarm limits
     uint16_t clogMin = 400;             // Distance below which chute clogging is detected (mm)
     uint8_t clogHold = 2;               // Number of consecutive readings before clog event
+    uint16_t envPeriodSec = 60;         // Gas/climate/pressure sampling period
+    uint16_t lidarPeriodSec = 600;      // Lidar period while the chute is empty and stable
+    ScanSettings scan;                  // Depth-map scan grid and schedule
+    ClogDetectSettings detect;          // Early warning ahead of the clogMin alarm
+    uint16_t lidarFastSec = 5;          // Shortest lidar period, close to clogMin
+};
+
+// Parts of Settings, reported to listeners when a commit changes them.
+enum SettingsSection : uint32_t {
+    SET_SITE        = 1 << 0,   // siteName
+    SET_WIFI        = 1 << 1,   // wifiSSID, wifiPass
+    SET_BROKER      = 1 << 2,   // mqttHost, mqttPort, mqttUser, mqttPass, mqttQos
+    SET_PUBLISH     = 1 << 3,   // mqttFormat, bufSpillSec, debugEnable
+    SET_UI          = 1 << 4,   // uiUser, uiPass
+    SET_THRESHOLDS  = 1 << 5,   // thr, clogMin, clogHold, detect
+    SET_PERIODS     = 1 << 6,   // envPeriodSec, lidarPeriodSec, lidarFastSec
+    SET_SCAN        = 1 << 7    // scan
 };
 
+// Working copy edited by setup() and the web server task, the only writers.
+// Other tasks must not read it: they take a SettingsRef, which sees whole
+// commits only.
 extern Settings settings;
 
+// Pin the current snapshot and release it; used by SettingsRef.
+uint8_t settingsPin();
+void settingsUnpin(uint8_t slot);
+const Settings &settingsSnapshot(uint8_t slot);
+
+// Read-only view of the settings as of the last settingsCommit().  Two
+// snapshots alternate: a commit fills the one nobody reads and then makes
+// it current, so readers take no lock and never see a half-written
+// struct.  Hold a ref only briefly (copy values out before blocking), as
+// the second commit after it waits for it to be dropped.
+class SettingsRef {
+public:
+    SettingsRef() : slot(settingsPin()) {}
+    ~SettingsRef() { settingsUnpin(slot); }
+    const Settings *operator->() const { return &settingsSnapshot(slot); }
+    const Settings &operator*() const { return settingsSnapshot(slot); }
+private:
+    SettingsRef(const SettingsRef &) = delete;
+    SettingsRef &operator=(const SettingsRef &) = delete;
+    uint8_t slot;
+};
+
+// Called with the SettingsSection bits a commit changed.  Runs in the
+// committing task, so it should only note the change (set a flag, notify
+// a task) and leave the work to the owner of the affected state.
+typedef void (*SettingsListener)(uint32_t changed);
+
+// Call ``fn`` after every commit that changes one of ``sections``.  At most
+// 8 listeners; returns false when full.  Register during setup().
+bool settingsSubscribe(uint32_t sections, SettingsListener fn);
+
 // Load the settings structure from NVS flash.  Must be called once on start-up
-// before using any fields of ::settings.
+// before using any fields of ::settings.  Converts the per-key layout of
+// older firmware on first boot.  Publishes the first snapshot without
+// calling the listeners.
 void loadSettings();
 
-// Persist the current contents of ::settings to NVS flash.
-void saveSettings();
+// Publish ::settings as the new snapshot, tell the listeners which sections
+// changed and schedule the save: the write happens in settingsService() once
+// no change has come in for 2 s, and only if NVS differs.  Returns the
+// changed sections, 0 when nothing changed.  Only the writers call this.
+uint32_t settingsCommit();
+
+// Write a scheduled save when it is due.  Call from loop().
+void settingsService();
+
+// Write a scheduled save now, e.g. before a restart.
+void settingsFlush();
 
 #endif // CONFIG_H
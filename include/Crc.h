@@ -0,0 +1,15 @@
+#ifndef CRC_H
+#define CRC_H
+#include <stddef.h>
+#include <stdint.h>
+
+// CRC-32 (IEEE 802.3, reflected, as used by zlib).  ``crc`` continues a
+// previous calculation so that a record can be checked in several pieces;
+// start with 0.
+uint32_t crc32Update(uint32_t crc, const void *data, size_t len);
+
+// CRC-8 used by Sensirion sensors on every 16-bit word (polynomial 0x31,
+// init 0xFF, no reflection).
+uint8_t crc8Sensirion(const uint8_t *data, size_t len);
+
+#endif // CRC_H
@@ -1,41 +1,237 @@
 #ifndef FILTER_H
 #define FILTER_H
 #include <stddef.h>
+#include <stdint.h>
+#include <type_traits>
+
+// Compile-time sized smoothing filters.  All of them share one interface:
+//
+//     void add(T v);        // append a sample
+//     T value() const;      // current output, zero before the first sample
+//     size_t size() const;  // samples currently in the window
+//     void reset();         // forget all samples
+//
+// so a sensor can switch filters by changing only its declaration.  None of
+// them allocate; state lives inside the object.
+
+namespace filter_detail {
+
+// Running sum that does not drift when values are added and removed for
+// months.  Floating-point types use Kahan compensation; integer types sum
+// exactly in a 64-bit accumulator.
+template<typename T, bool Float = std::is_floating_point<T>::value>
+class Accumulator {
+public:
+    void add(T v) {
+        T y = v - comp;
+        T t = sum + y;
+        comp = (t - sum) - y;
+        sum = t;
+    }
+    void sub(T v) { add(-v); }
+    T mean(size_t n) const { return sum / (T)n; }
+    void reset() { sum = 0; comp = 0; }
+private:
+    T sum = 0;
+    T comp = 0;
+};
+
+template<typename T>
+class Accumulator<T, false> {
+public:
+    void add(T v) { sum += v; }
+    void sub(T v) { sum -= v; }
+    T mean(size_t n) const { return (T)(sum / (int64_t)n); }
+    void reset() { sum = 0; }
+private:
+    int64_t sum = 0;
+};
+
+} // namespace filter_detail
 
 // Simple moving average filter over the last ``N`` values.
-// ``T`` must support addition and division by ``size_t``.
 template<typename T, size_t N>
 class SMAFilter {
 public:
     // Create a new filter with all entries initialised to zero.
-    SMAFilter() : count(0), index(0), sum(0) {
-        for(size_t i=0;i<N;i++) values[i]=0;
-    }
+    SMAFilter() { reset(); }
     // Append a new sample to the window.
     void add(T v) {
-        if(count < N) {
-            values[index] = v;
-            sum += v;
-            index = (index + 1) % N;
-            count++;
-        } else {
-            sum -= values[index];
-            values[index] = v;
-            sum += v;
-            index = (index + 1) % N;
-        }
+        if(count < N) count++;
+        else sum.sub(values[index]);
+        values[index] = v;
+        sum.add(v);
+        index = (index + 1) % N;
     }
     // Return the current average of all stored samples.  Returns zero when
     // no values have been added yet.
-    T average() const {
+    T value() const {
         if(count == 0) return 0;
-        return sum / count;
+        return sum.mean(count);
+    }
+    size_t size() const { return count; }
+    void reset() {
+        for(size_t i=0;i<N;i++) values[i]=0;
+        count = 0;
+        index = 0;
+        sum.reset();
     }
 private:
     T values[N];
     size_t count;
     size_t index;
-    T sum;
+    filter_detail::Accumulator<T> sum;
+};
+
+// Exponential moving average with the smoothing of an ``N`` sample SMA
+// (alpha = 2 / (N + 1)).  The first sample seeds the average.
+template<typename T, size_t N>
+class EMAFilter {
+    static_assert(std::is_floating_point<T>::value, "use EMAFilterQ15 for integer data");
+public:
+    void add(T v) {
+        if(count == 0) avg = v;
+        else avg += (v - avg) * kAlpha;
+        if(count < N) count++;
+    }
+    T value() const { return avg; }
+    size_t size() const { return count; }
+    void reset() { avg = 0; count = 0; }
+private:
+    static constexpr T kAlpha = (T)2 / (T)(N + 1);
+    T avg = 0;
+    size_t count = 0;
+};
+
+template<typename T, size_t N>
+constexpr T EMAFilter<T, N>::kAlpha;
+
+// Fixed-point EMA for raw ADC counts or q15 samples.  Alpha is a q15
+// constant and the state keeps 15 fractional bits, so small steps are not
+// lost to truncation the way they are in a plain integer EMA.
+template<size_t N>
+class EMAFilterQ15 {
+public:
+    void add(int16_t v) {
+        int32_t x = (int32_t)v * 32768;            // << 15 is UB for negative v
+        if(count == 0) acc = x;
+        else acc += (int32_t)(((int64_t)(x - acc) * kAlpha) >> 15);
+        if(count < N) count++;
+    }
+    // Rounded to the nearest sample value.
+    int16_t value() const { return (int16_t)((acc + (1 << 14)) >> 15); }
+    size_t size() const { return count; }
+    void reset() { acc = 0; count = 0; }
+private:
+    static constexpr int32_t kAlpha = (int32_t)((2 * 32768 + (N + 1) / 2) / (N + 1));
+    int32_t acc = 0;
+    size_t count = 0;
+};
+
+// Sliding median over the last ``N`` values, O(log N) per sample.
+//
+// Uses the "mediator" layout: one array holds a max-heap of the lower half
+// (negative indices), the median (index 0) and a min-heap of the upper half
+// (positive indices).  ``pos`` maps each slot of the circular window to its
+// heap index, so the sample leaving the window is replaced in place and
+// sifted up or down instead of being searched for.  With an even count the
+// two middle values are averaged.  Prefer odd ``N``.
+template<typename T, size_t N>
+class MedianFilter {
+    static_assert(N >= 3 && N < 32768, "window size out of range");
+public:
+    MedianFilter() { reset(); }
+
+    void add(T v) {
+        bool isNew = count < N;
+        int p = pos[index];
+        T old = data[index];
+        data[index] = v;
+        index = (index + 1) % N;
+        if(isNew) count++;
+        if(p > 0) {                 // slot is in the min-heap
+            if(!isNew && old < v) minSortDown(p * 2);
+            else if(minSortUp(p)) maxSortDown(-1);
+        } else if(p < 0) {          // slot is in the max-heap
+            if(!isNew && v < old) maxSortDown(p * 2);
+            else if(maxSortUp(p)) minSortDown(1);
+        } else {                    // slot is the median
+            if(maxCt()) maxSortDown(-1);
+            if(minCt()) minSortDown(1);
+        }
+    }
+
+    T value() const {
+        if(count == 0) return 0;
+        T v = data[heap(0)];
+        if((count & 1) == 0) v = (T)((v + data[heap(-1)]) / 2);
+        return v;
+    }
+    size_t size() const { return count; }
+
+    void reset() {
+        count = 0;
+        index = 0;
+        // Initial fill pattern: median, max, min, max, min, ...
+        for(size_t i = N; i-- > 0;) {
+            int p = (int)((i + 1) / 2) * ((i & 1) ? -1 : 1);
+            pos[i] = (int16_t)p;
+            heap(p) = (int16_t)i;
+            data[i] = 0;
+        }
+    }
+
+private:
+    // count never exceeds N; saying so lets the compiler bound the heaps.
+    int filled() const { return count < N ? (int)count : (int)N; }
+    int minCt() const { return (filled() - 1) / 2; }
+    int maxCt() const { return filled() / 2; }
+    int16_t &heap(int i) { return heapStore[i + (int)(N / 2)]; }
+    int16_t heap(int i) const { return heapStore[i + (int)(N / 2)]; }
+    bool less(int i, int j) const { return data[heap(i)] < data[heap(j)]; }
+
+    void exchange(int i, int j) {
+        int16_t t = heap(i);
+        heap(i) = heap(j);
+        heap(j) = t;
+        pos[heap(i)] = (int16_t)i;
+        pos[heap(j)] = (int16_t)j;
+    }
+    // Swap i and j when heap[i] < heap[j].  Returns true if swapped.
+    bool cmpExch(int i, int j) {
+        if(!less(i, j)) return false;
+        exchange(i, j);
+        return true;
+    }
+    // Sift away from the median.  ``i`` is the first child to compare
+    // with its parent; 1 and -1 compare against the median itself.
+    void minSortDown(int i) {
+        for(; i <= minCt(); i *= 2) {
+            if(i > 1 && i < minCt() && less(i + 1, i)) ++i;
+            if(!cmpExch(i, i / 2)) break;
+        }
+    }
+    void maxSortDown(int i) {
+        for(; i >= -maxCt(); i *= 2) {
+            if(i < -1 && i > -maxCt() && less(i, i - 1)) --i;
+            if(!cmpExch(i / 2, i)) break;
+        }
+    }
+    // Sift towards the median.  Return true when the median changed.
+    bool minSortUp(int i) {
+        while(i > 0 && cmpExch(i, i / 2)) i /= 2;
+        return i == 0;
+    }
+    bool maxSortUp(int i) {
+        while(i < 0 && cmpExch(i / 2, i)) i /= 2;
+        return i == 0;
+    }
+
+    T data[N];
+    int16_t pos[N];
+    int16_t heapStore[N];
+    size_t count;
+    size_t index;
 };
 
 #endif // FILTER_H
@@ -0,0 +1,98 @@
+#ifndef HISTORY_H
+#define HISTORY_H
+#include <Arduino.h>
+
+// On-flash time series of the sensor readings.
+//
+// Three tiers live in LittleFS next to the message buffer: raw samples as
+// they are taken, and 1-minute and 1-hour rollups holding min/max/avg.
+// Each tier is a log of sealed blocks of up to 512 bytes; a block stores
+// its rows as varint deltas of fixed-point values, so a raw row of all
+// sensors costs about a dozen bytes.  Blocks carry a CRC-32 and their
+// time span, so a query skips whole blocks outside its range and a block
+// torn by a power loss is ignored.  The block being filled stays in RAM
+// and is saved every 10 minutes; the oldest segment of a tier is dropped
+// when it reaches its size cap: roughly two days of raw samples at the
+// default 60 s period, six days of minutes and three months of hours.
+
+enum HistSensor : uint8_t {
+    HIST_LIDAR,
+    HIST_SMOKE,
+    HIST_ECO2,
+    HIST_TVOC,
+    HIST_TEMP,
+    HIST_RH,
+    HIST_PRESSURE,
+    HIST_COUNT
+};
+
+enum HistTier : uint8_t { HIST_RAW, HIST_MINUTE, HIST_HOUR, HIST_TIERS };
+
+// Name used by /api/live and /api/history, e.g. "lidar".
+const char *historySensorName(HistSensor s);
+bool historySensorFromName(const char *name, HistSensor &s);
+
+// Open the store and recover the state saved before the last reset.  Call
+// after bufferInit(), which mounts LittleFS.
+void historyInit();
+
+// Record the values measured at UNIX time ``t``; NAN marks a sensor that
+// was not measured.  Ignored until the clock has been set by NTP.
+void historyAdd(uint32_t t, const float v[HIST_COUNT]);
+
+// Save the blocks still being filled, e.g. before a restart.
+void historySave();
+
+struct HistPoint {
+    uint32_t t;         // start of the step
+    float min;
+    float max;
+    float avg;
+};
+
+// Range query over one sensor.  Points are aggregated into ``step``
+// second buckets from the coarsest tier that still resolves the step, so
+// a query costs the same however much history is kept.  Reads one block
+// at a time and never holds the result in memory.
+class HistoryReader {
+public:
+    HistoryReader(HistSensor sensor, uint32_t from, uint32_t to, uint32_t step);
+
+    // Next point in time order; false at the end of the range.
+    bool next(HistPoint &p);
+
+    // Write the next part of the JSON document
+    //     {"sensor":"lidar","step":60,"points":[[t,min,max,avg],...]}
+    // into ``buf``.  Returns the number of bytes written, 0 at the end.
+    // Suits AsyncWebServer's chunked response filler.
+    size_t readJson(uint8_t *buf, size_t maxLen);
+
+private:
+    bool loadBlock();
+    bool nextRow(uint32_t &t, float &lo, float &hi, float &avg);
+
+    HistSensor sensor;
+    HistTier tier;
+    uint32_t from, to, step;
+    // Position in the tier's log; the open block in RAM comes last.
+    uint32_t seq;
+    uint32_t offset = 0;
+    bool openDone = false;
+    // Decoder state of the current block.
+    uint8_t blk[512];
+    uint16_t len = 0, pos = 0, rows = 0;
+    uint32_t rowT = 0;
+    int32_t last[HIST_COUNT];
+    // Bucket being aggregated.
+    uint32_t bucket = 0;
+    float bMin = 0, bMax = 0, bSum = 0;
+    uint32_t bN = 0;
+    bool ended = false;
+    // JSON output not yet copied to the caller.
+    char pend[96];
+    uint8_t pendLen = 0, pendPos = 0;
+    uint8_t jsonState = 0;
+    uint32_t emitted = 0;
+};
+
+#endif // HISTORY_H
@@ -4,15 +4,23 @@
 
 // Simple LED state machine used to indicate system status.
 // A dedicated FreeRTOS task should call ``ledTask`` to blink
-// according to the current state set via ``ledSetState``.
+// according to the current state.  Each owner sets its own input: the
+// network manager the link, clog detection the alarm.  The LED shows the
+// worse of the two, an alarm before a link error.
 
 enum class LedState { NORMAL, ERROR, ALARM };
 
 // Configure which GPIO pin controls the indicator LED.
 void ledInit(uint8_t pin);
 
-// Change the current LED behaviour.
-void ledSetState(LedState s);
+// Wi-Fi and broker up (true) or not.  Starts down.
+void ledSetLink(bool up);
+
+// Raise or clear the clog alarm.
+void ledSetAlarm(bool on);
+
+// What the LED shows for the current inputs.
+LedState ledState();
 
 // RTOS task implementing the blinking patterns.  Intended to be
 // run on a separate thread.
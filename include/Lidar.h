@@ -0,0 +1,77 @@
+#ifndef LIDAR_H
+#define LIDAR_H
+#include <Arduino.h>
+
+// Driver for the LightWare SF11/C on a UART.
+//
+// The sensor streams one ASCII line per measurement ("12.34 m\r\n") at
+// the output rate configured on the device.  The driver parses the stream
+// as it arrives from the UART receive callback, keeps a running average
+// of the last kLidarAvg frames and never blocks the caller.  Distances are
+// reported in millimetres, the unit of the thresholds in Settings.
+
+static const uint8_t kLidarAvg = 8;             // frames in the average
+static const uint32_t kLidarStaleMs = 1000;     // reading expires after this
+
+// Incremental parser for SF11/C output lines.  Accepts optional leading
+// blanks, an optional sign, a decimal number in metres and an optional
+// "m" unit; '\r' is ignored and '\n' ends the line.  Keeps no buffer, so
+// a frame split across UART reads is handled without allocating.
+class LidarParser {
+public:
+    enum Result : uint8_t { NONE, FRAME, ERROR };
+
+    // Consume one byte.  Returns FRAME when a line with a number ended,
+    // ERROR when a malformed line ended and NONE otherwise.
+    Result feed(uint8_t c);
+    // Value of the last FRAME in millimetres.
+    int32_t mm() const { return value; }
+    void reset();
+
+private:
+    enum State : uint8_t { LEAD, INT, FRAC, TAIL };
+    State state = LEAD;
+    bool neg = false;
+    bool bad = false;
+    uint8_t len = 0;
+    uint8_t fracDigits = 0;
+    int32_t whole = 0;
+    int32_t frac = 0;
+    int32_t value = 0;
+};
+
+struct LidarReading {
+    uint32_t ms = 0;            // millis() of the newest valid frame
+    float distance = NAN;       // average of the newest kLidarAvg frames, mm
+    float last = NAN;           // newest single frame, mm
+    uint16_t samples = 0;       // valid frames since the last flush
+    bool valid = false;         // samples > 0 and the newest frame is recent
+};
+
+struct LidarStats {
+    uint32_t frames;            // valid frames since boot
+    uint32_t noTarget;          // frames outside the sensor's range
+    uint32_t errors;            // malformed lines
+};
+
+// Start the UART and register the receive callback.  Call once.
+void lidarBegin(HardwareSerial &port, int8_t rxPin, int8_t txPin);
+
+// Feed raw bytes from the sensor.  Called from the receive callback; the
+// host build uses it to replay recorded streams.
+void lidarFeed(const uint8_t *data, size_t len);
+
+// Copy the current reading.  Returns r.valid.
+bool lidarGet(LidarReading &r);
+
+// Restart the average, e.g. after the servos moved the sensor.
+void lidarFlush();
+
+// Wait up to ``timeoutMs`` until ``frames`` frames arrived since the last
+// flush.  Returns false on timeout; ``r`` then holds whatever was
+// collected.  Meant for one waiting task at a time.
+bool lidarWait(LidarReading &r, uint16_t frames, uint32_t timeoutMs);
+
+LidarStats lidarStats();
+
+#endif // LIDAR_H
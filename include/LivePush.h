@@ -0,0 +1,33 @@
+#ifndef LIVE_PUSH_H
+#define LIVE_PUSH_H
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+
+// Live values pushed to the web UI over the ``/ws`` socket.
+//
+// The values are taken from the shared Readings snapshot (see Readings.h).
+// livePush(), called often from one task, sends every connected client a
+// JSON object holding just the fields that changed since that client's
+// last frame, e.g. {"lidar":812,"x":91}; a new client first gets all of
+// them.  A client whose send queue is full is skipped and polled less
+// often until it drains, and because its frame is a diff against what it
+// last received, skipped updates coalesce instead of piling up.
+
+void liveBegin(AsyncWebSocket *ws);
+
+// Forward WS_EVT_CONNECT and WS_EVT_DISCONNECT from the socket handler.
+void liveOnEvent(AsyncWebSocketClient *client, AwsEventType type);
+
+// Send changes published since the last call.  Cheap when nothing
+// changed; call every loop().
+void livePush();
+
+struct LiveStats {
+    uint32_t frames;        // frames sent since boot
+    uint32_t bytes;         // payload bytes sent since boot
+    uint32_t throttled;     // sends skipped because a client was backed up
+};
+
+LiveStats liveStats();
+
+#endif // LIVE_PUSH_H
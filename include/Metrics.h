@@ -0,0 +1,102 @@
+#ifndef METRICS_H
+#define METRICS_H
+#include <Arduino.h>
+
+// Runtime health counters and latency histograms.
+//
+// Every counter and histogram has one slot per core.  A task adds to the
+// slot of the core it runs on with a relaxed atomic add, so recording
+// never takes a lock and never contends with the other core; readers sum
+// the two slots.  Histograms have fixed bucket bounds (kMetricBucketsUs)
+// and keep a 64-bit sum of microseconds as a 32-bit word plus a wrap
+// count.
+//
+// The heap and task stacks are sampled when the metrics are read; the
+// backlog and WebSocket gauges are set by their owners.  metricsWrite()
+// renders everything in the Prometheus text format for /api/metrics;
+// metricsSummary() gives the compact subset sent with the heartbeat.
+
+enum MetricCounter : uint8_t {
+    MET_WIFI_CONNECTS,          // Wi-Fi links brought up
+    MET_MQTT_CONNECTS,          // broker sessions established
+    MET_MQTT_LOST,              // broker sessions lost while online
+    MET_PUBLISH_FAILS,          // mqtt.publish() calls that failed
+    MET_COUNTER_COUNT
+};
+
+enum MetricTimer : uint8_t {
+    MET_SENSORS_LOOP,           // sensorsTask: one pass of due jobs
+    MET_READ_MQ2,               // ADC
+    MET_READ_ENS160,            // I2C
+    MET_READ_AHT21,             // I2C
+    MET_READ_SDP810,            // I2C
+    MET_READ_LIDAR,             // UART: waiting for the averaged frames
+    MET_MQTT_PUBLISH,           // one mqtt.publish() from the queue
+    MET_BUFFER_FLUSH,           // one bufferFlush()
+    MET_TIMER_COUNT
+};
+
+enum MetricGauge : uint8_t {
+    MET_WS_CLIENTS,             // WebSocket clients connected
+    MET_BUFFER_BACKLOG,         // bytes waiting in MsgBuffer
+    MET_GAUGE_COUNT
+};
+
+// Upper bounds of the histogram buckets; a last bucket takes the rest.
+static const uint8_t kMetricBuckets = 12;
+static const uint32_t kMetricBucketsUs[kMetricBuckets - 1] = {
+    100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000, 250000};
+
+void metricsCount(MetricCounter c, uint32_t n = 1);
+void metricsTime(MetricTimer t, uint32_t us);
+void metricsSet(MetricGauge g, int32_t value);
+
+// Time the enclosing scope into a histogram.
+class MetricsScope {
+public:
+    explicit MetricsScope(MetricTimer t) : timer(t), start(micros()) {}
+    ~MetricsScope() { metricsTime(timer, micros() - start); }
+
+private:
+    MetricsScope(const MetricsScope&);
+    MetricsScope &operator=(const MetricsScope&);
+    MetricTimer timer;
+    uint32_t start;
+};
+
+// Report the stack high-water mark of a task under ``name`` (a literal).
+// Up to kMetricTasks tasks; safe from any task.
+static const uint8_t kMetricTasks = 8;
+void metricsWatchTask(const char *name, TaskHandle_t task);
+
+struct MetricsHistogram {
+    uint32_t bucket[kMetricBuckets];    // not cumulative
+    uint32_t count;
+    uint64_t sumUs;
+
+    // Upper bound of the bucket holding quantile ``q``, in microseconds;
+    // 0 with no samples, UINT32_MAX in the overflow bucket.
+    uint32_t quantileUs(float q) const;
+};
+
+uint32_t metricsCounter(MetricCounter c);
+void metricsHistogram(MetricTimer t, MetricsHistogram &out);
+
+// Write every metric in the Prometheus text exposition format.
+void metricsWrite(Print &out);
+
+struct MetricsSummary {
+    uint32_t maxBlock;          // largest free heap block, bytes
+    uint32_t minStack;          // smallest stack high-water mark, bytes
+    uint32_t loopMs;            // p95 of the sensors loop, a bucket bound
+                                // rounded up; 4294967 beyond the last one
+    uint32_t publishMs;         // p95 of mqtt.publish()
+    uint32_t flushMs;           // p95 of bufferFlush()
+    int32_t backlog;            // MsgBuffer bytes
+    int32_t wsClients;
+    uint32_t reconnects;        // broker sessions lost since boot
+};
+
+MetricsSummary metricsSummary();
+
+#endif // METRICS_H
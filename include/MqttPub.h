@@ -0,0 +1,48 @@
+#ifndef MQTT_PUB_H
+#define MQTT_PUB_H
+#include <Arduino.h>
+
+// Single owner of the MQTT client.
+//
+// PubSubClient is not thread-safe, so only the publisher task touches
+// ``mqtt``: it drives NetMgr, replays the offline buffer and
+// publishes records that other tasks hand over through a bounded queue.
+// Producers never wait for the broker; when the queue is full, or the
+// client is offline, messages go to MsgBuffer instead.
+
+// Largest payload that goes through the queue; longer ones go straight to
+// MsgBuffer.  The heartbeat JSON with its metrics is about 240 bytes.
+static const size_t kPubMaxPayload = 384;
+
+// Create the publish queue.  Call once before any pubEnqueue().
+void pubInit();
+
+// Queue a message for publishing.  Never blocks.  With ``persist`` the
+// message falls back to MsgBuffer when it cannot be queued or the client
+// is offline; without it (debug output) the message is dropped instead.
+// Returns false when the message was neither queued nor buffered.
+bool pubEnqueue(const char *topic, const char *payload, bool persist = true);
+// Same for a payload of ``len`` bytes, which may be binary (MessagePack).
+bool pubEnqueueBytes(const char *topic, const char *payload, size_t len, bool persist = true);
+
+// One iteration of the publisher: service the connection and the offline
+// buffer, then publish queued messages, waiting up to ``wait`` ticks for
+// the first one.
+void pubService(TickType_t wait);
+
+// RTOS task running pubService() forever.  Pin it to core 0, next to the
+// Wi-Fi stack, so that core 1 is left to the sensor tasks.
+void pubTask(void*);
+
+struct PubStats {
+    uint32_t depth;         // messages waiting in the queue
+    uint32_t maxDepth;      // highest depth seen since boot
+    uint32_t sent;          // successful publishes since boot
+    uint32_t diverted;      // messages sent to MsgBuffer or dropped
+    uint32_t lastUs;        // duration of the last publish() call
+    uint32_t maxUs;         // slowest publish() call since boot
+};
+
+PubStats pubStats();
+
+#endif // MQTT_PUB_H
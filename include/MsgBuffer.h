@@ -3,18 +3,77 @@
 #include <Arduino.h>
 #include <LittleFS.h>
 
-// Simple persistent buffer for MQTT messages when the connection
-// is down.  Messages are stored in LittleFS and resent on reconnect.
+// Buffer for MQTT messages while the connection is down.
+//
+// Messages are first staged in a fixed-size RAM ring so that a short outage
+// (Wi-Fi roaming, a broker restart) never touches flash.  The ring is
+// spilled to flash in one batch when it passes its high-water mark or when
+// its oldest message is older than ``settings.bufSpillSec``; a reset loses
+// only what is still in RAM.
+//
+// On flash, messages are appended to a log in LittleFS that is split into fixed-size
+// segment files under ``/mbuf``.  Every record carries its length and a
+// CRC-32, so a record torn by a power loss is detected and skipped.  A read
+// cursor persisted next to the segments marks how far the log has been
+// sent; a partial flush only moves the cursor and deletes segments that
+// were fully sent.  When the log reaches its size cap the oldest segment is
+// dropped.
+//
+// Messages are kept in one lane per priority, each with its own log, so a
+// long heartbeat backlog can neither delay nor evict a clog alarm.  Replay
+// is paced: every bufferPoll() interval sends a small batch, alarms first,
+// then other events, then the bulk telemetry.  Each message keeps the time
+// it was captured and carries it as ``ts`` when replayed (MQTT 3.1.1 has no
+// message properties): as the first member of a JSON object or MessagePack
+// map, or by wrapping a scalar as {"value": ..., "ts": ...}.
 
-// Mount the filesystem used for buffering.
+enum BufferLane : uint8_t {
+    LANE_ALARM,             // event/clog*, event/filling
+    LANE_EVENT,             // the other events
+    LANE_BULK,              // heartbeat, scan results and anything else
+    LANE_COUNT
+};
+
+static const uint16_t kFlushMessages = 8;      // per bufferFlush() by default
+static const size_t kFlushBytes = 4 * 1024;
+static const uint32_t kFlushIntervalMs = 100;  // between batches in bufferPoll()
+
+// Mount the filesystem, recover the log left by the previous boot and
+// import a legacy ``/buf`` text file if present.
 void bufferInit();
 
-// Append a topic/payload pair to the buffer file.  Called when
-// the MQTT client is offline.
-void bufferStore(const String& topic, const String& payload);
+// Stage a topic/payload pair in RAM.  Called when the MQTT client is
+// offline; safe from any task and never blocks on flash.  Returns false
+// (and counts a drop) when the message is too large or the ring is full.
+bool bufferStore(const char* topic, const char* payload);
+// Same for a binary payload such as MessagePack.
+bool bufferStore(const char* topic, const char* payload, size_t payloadLen);
+
+// Service the buffer from the network task: send a batch every
+// kFlushIntervalMs when connected, otherwise spill RAM to flash if the spill
+// policy says so.  Cheap when idle; call it on every loop iteration.
+void bufferPoll();
+
+// Publish up to ``maxMessages`` buffered messages or about ``maxBytes`` of
+// payload, lane by lane; within a lane the flash log from its read cursor,
+// then the RAM ring.  Stops at the first failed publish and keeps the rest
+// for the next call.  Returns the number of messages sent.  Must be called
+// from the same task as bufferPoll().
+size_t bufferFlush(uint16_t maxMessages = kFlushMessages, size_t maxBytes = kFlushBytes);
+
+// The lane ``topic`` is buffered in.
+BufferLane bufferLaneOf(const char *topic);
+
+// Number of bytes not sent yet, in RAM and on flash (approximate: counted
+// in whole records, including headers).
+size_t bufferBacklogBytes();
+
+struct BufferStats {
+    uint32_t ram;           // messages currently held in RAM
+    uint32_t spilled;       // messages moved to flash since boot
+    uint32_t dropped;       // messages lost since boot (ring full, write failed)
+};
 
-// Send all buffered messages and clear the file.  Should be called
-// once after MQTT reconnects.
-void bufferFlush();
+BufferStats bufferStats();
 
 #endif
@@ -0,0 +1,37 @@
+#ifndef NET_MGR_H
+#define NET_MGR_H
+#include <Arduino.h>
+
+// Wi-Fi and MQTT connection manager.
+//
+// The Wi-Fi link is tracked through driver events; the MQTT session is a
+// small state machine advanced by netService().  Failed attempts are
+// retried with exponential backoff and full jitter, so a broker restart
+// does not make every node reconnect at the same instant.  Each state
+// change is mirrored on the status LED.
+//
+// Committed changes of the Wi-Fi credentials, the broker or the site name
+// are applied live: the affected connection is restarted with the new
+// values on the next netService().
+
+enum class NetState {
+    AP_MODE,        // no credentials: soft AP for the web UI
+    WIFI_DOWN,      // waiting for the station to get an IP address
+    MQTT_WAIT,      // link up, next broker connect is scheduled
+    ONLINE          // broker session established
+};
+
+// Register the Wi-Fi event handler and the settings listener and start
+// connecting.  Call once, after loadSettings().  Returns at once.
+void netBegin();
+
+// Advance the state machine.  Only ever called by the MQTT owner task;
+// does nothing until a retry is due, then makes a single attempt.
+void netService();
+
+NetState netState();
+
+// Consecutive failed attempts in the current state (0 when online).
+uint32_t netFailures();
+
+#endif // NET_MGR_H
@@ -1,5 +1,6 @@
 #ifndef NTPSYNC_H
 #define NTPSYNC_H
+#include <Arduino.h>
 
 // Initialise NTP and set the system time zone offset in hours.
 // Should be called once during start-up.
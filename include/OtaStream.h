@@ -0,0 +1,110 @@
+#ifndef OTA_STREAM_H
+#define OTA_STREAM_H
+#include <Arduino.h>
+#include "mbedtls/sha256.h"
+
+// Streaming decoder and verifier for firmware uploads.
+//
+// An upload is an .ota package made by tools/ota_pack.py: a
+// kOtaHeaderLen-byte manifest followed by the image, raw or
+// heatshrink-compressed.  The manifest carries the image size, its SHA-256
+// and an ECDSA P-256 signature of the manifest, which is checked against
+// the public key before the first byte reaches the writer; the private key
+// never leaves the machine that packs the image.  The image is
+// decompressed as the chunks arrive, with a window of at most
+// 1 << kOtaMaxWindow bytes, hashed on the way out and accepted by finish()
+// only when its size and hash match the manifest.
+//
+// Plain images and unsigned manifests are refused.  Nothing here touches
+// the flash, so the whole pipeline runs in the host build.
+
+static const size_t kOtaHeaderLen = 108;
+static const size_t kOtaPublicKeyLen = 65;      // uncompressed point: 04 || X || Y
+static const uint8_t kOtaMaxWindow = 11;        // heatshrink -w
+static const char kOtaMagic[4] = {'C', 'H', 'P', 'O'};
+
+enum OtaFormat : uint8_t {
+    OTA_PLAIN,              // image bytes as is
+    OTA_HEATSHRINK,         // heatshrink, window and lookahead from the manifest
+};
+
+enum OtaError : uint8_t {
+    OTA_OK,
+    OTA_BAD_MANIFEST,       // unknown version, format or parameters
+    OTA_BAD_SIGNATURE,
+    OTA_UNSIGNED,           // a plain image, not a package
+    OTA_TOO_LONG,           // more data than the manifest announced
+    OTA_TRUNCATED,          // less data than the manifest announced
+    OTA_BAD_HASH,
+    OTA_WRITE_FAILED,       // the writer refused a block
+};
+
+struct OtaManifest {
+    uint8_t version;
+    OtaFormat format;
+    uint8_t window;         // heatshrink parameters
+    uint8_t lookahead;
+    uint32_t imageSize;
+    uint8_t sha256[32];
+};
+
+class OtaStream {
+public:
+    // Receives the decoded image in order.  Returns false to abort.
+    typedef bool (*Writer)(const uint8_t *data, size_t len);
+
+    // Start a new upload signed for ``publicKey``, kOtaPublicKeyLen bytes
+    // kept by pointer.
+    void begin(Writer writer, const uint8_t *publicKey);
+
+    // Consume the next ``len`` bytes of the upload.  Returns false once an
+    // error has occurred; see error().
+    bool feed(const uint8_t *data, size_t len);
+
+    // End of the upload: check the size and hash.  Returns true when the
+    // image may be committed.
+    bool finish();
+
+    OtaError error() const { return err; }
+    // Valid once the writer has been called.
+    const OtaManifest &manifest() const { return man; }
+    // Image bytes handed to the writer so far.
+    uint32_t written() const { return total; }
+
+    static const char *errorText(OtaError e);
+
+private:
+    enum State : uint8_t { HEADER, PLAIN, TAG, LITERAL, INDEX, COUNT, DONE };
+
+    bool fail(OtaError e);
+    bool parseHeader();
+    bool emit(uint8_t b);
+    bool flush();
+    bool takeBits(uint8_t n, uint16_t &out);
+    bool decode();
+
+    Writer writer = nullptr;
+    const uint8_t *publicKey = nullptr;
+    OtaError err = OTA_OK;
+    State state = HEADER;
+    OtaManifest man;
+    mbedtls_sha256_context sha;
+    uint32_t total = 0;
+
+    uint8_t header[kOtaHeaderLen];
+    size_t headerLen = 0;
+
+    // Bit reader over the current feed() chunk.
+    const uint8_t *in = nullptr;
+    size_t inLen = 0;
+    uint32_t acc = 0;
+    uint8_t accBits = 0;
+
+    uint16_t index = 0;
+    uint8_t window[1 << kOtaMaxWindow];
+    uint16_t head = 0;          // next write position in the window
+    uint8_t out[256];           // decoded bytes waiting for the writer
+    size_t outLen = 0;
+};
+
+#endif // OTA_STREAM_H
@@ -0,0 +1,47 @@
+#ifndef READINGS_H
+#define READINGS_H
+#include <Arduino.h>
+
+// Latest sensor readings and head position, shared between tasks.
+//
+// The sensor and servo tasks publish into a single Readings struct under a
+// seqlock: its sequence number is odd while a write is in progress, and a
+// reader copies the struct and tries again if the number was odd or has
+// moved.  Readers (web handlers, the heartbeat, the live push) never make
+// the sampler wait and always get values from the same publish.  The two
+// writers are serialised by a short critical section.
+
+enum Reading : uint8_t {        // same order as HistSensor
+    READ_LIDAR,
+    READ_SMOKE,
+    READ_ECO2,
+    READ_TVOC,
+    READ_TEMP,
+    READ_RH,
+    READ_PRESSURE,
+    READ_COUNT
+};
+
+struct Readings {
+    uint32_t version;                   // bumped by every publish
+    float value[READ_COUNT];            // NAN until measured and after a failed one
+    uint32_t sampledMs[READ_COUNT];     // millis() of the last publish, 0 never
+    uint8_t valid;                      // bit per Reading: value was measured
+    int16_t headX;                      // servo angles, degrees
+    int16_t headY;
+
+    bool isValid(Reading r) const { return valid & (1 << r); }
+};
+
+// Publish ``values[r]`` for every Reading r whose bit is set in ``mask``,
+// all in one step.  A NAN marks a failed measurement.
+void readingsPublish(uint8_t mask, const float values[READ_COUNT]);
+
+// Publish a new head position.
+void readingsSetHead(int x, int y);
+
+// Copy the latest consistent set into ``out``.  Lock-free; safe from any
+// task.
+void readingsGet(Readings &out);
+
+#endif // READINGS_H
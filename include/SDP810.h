@@ -11,12 +11,20 @@ public:
     // sensor acknowledges the start measurement command.
     bool begin(TwoWire &w = Wire, uint8_t addr = 0x25);
 
-    // Read the differential pressure in Pascals.  Optionally returns the
-    // measured temperature via the pointer argument.
+    // Read the latest continuous-mode result in one bus transaction.  The
+    // scale factor never changes, so after the first full 9-byte read only
+    // the needed words are fetched: 3 bytes for pressure, 6 with
+    // temperature.  Every word is checked against its CRC-8.  Returns
+    // false on a short read or CRC error; the outputs are then untouched.
+    bool read(float &pressure, float *temperature = nullptr);
+
+    // Read the differential pressure in Pascals, NAN on error.  Optionally
+    // returns the measured temperature via the pointer argument.
     float readPressure(float *temperature = nullptr);
 private:
     TwoWire* wire = nullptr;
     uint8_t address = 0x25;
+    int16_t scale = 0;          // Pa^-1, cached from the first full read
 };
 
 #endif // SDP810_H
@@ -0,0 +1,62 @@
+#ifndef SCAN_H
+#define SCAN_H
+#include <Arduino.h>
+#include "Config.h"
+
+// Raster scan of the chute cross-section with the servo-mounted lidar.
+//
+// The head visits a cols x rows grid of servo angles in serpentine order
+// so that consecutive points are one step apart.  At each point the scan
+// waits for the servos to travel, then for two consecutive lidar frames
+// that agree; the next move is commanded as soon as that capture is in,
+// and bookkeeping for the finished point overlaps with the travel.  The
+// result is a depth map plus fill metrics against the previous scan.
+
+static const uint8_t kScanMaxDim = 15;
+
+struct DepthMap {
+    uint32_t ms = 0;                            // millis() at completion, 0 = none
+    uint8_t cols = 0;
+    uint8_t rows = 0;
+    uint16_t mm[kScanMaxDim * kScanMaxDim];     // row-major, 0 = no reading
+};
+
+struct ScanMetrics {
+    uint16_t minMm;         // closest reading, 0 when the map is empty
+    uint8_t validPct;       // cells with a reading
+    uint8_t blockedPct;     // valid cells closer than the clog distance
+    uint8_t changedPct;     // compared cells that moved by more than 50 mm
+    int16_t meanDeltaMm;    // mean change of compared cells; negative = closer
+    uint16_t compared;      // cells valid in this and the previous scan
+};
+
+struct ScanStatus {
+    bool running;
+    uint16_t done;          // points measured in the current or last scan
+    uint16_t total;
+    uint32_t durationMs;    // length of the last completed scan
+};
+
+typedef void (*ScanMoveFn)(int x, int y);
+typedef bool (*ScanAbortFn)();
+
+// Run one scan over ``grid`` from the calling task.  ``move`` positions
+// the servos; ``abort`` is polled between points.  On completion the map
+// becomes the latest result, compared against the previous one with
+// ``blockMm`` as the clog distance.  Returns false when aborted.
+bool scanRun(const ScanSettings &grid, uint16_t blockMm, ScanMoveFn move, ScanAbortFn abort);
+
+// Fill metrics of ``cur`` against ``prev``, which may be null or of a
+// different shape, in which case nothing is compared.
+void scanCompare(const DepthMap &cur, const DepthMap *prev, uint16_t blockMm, ScanMetrics &m);
+
+// Copy the latest completed scan.  Returns false before the first one.
+bool scanLatest(DepthMap &map, ScanMetrics &m);
+
+// Only the metrics of the latest scan, without copying the map.  Returns
+// false before the first one.
+bool scanMetrics(ScanMetrics &m);
+
+ScanStatus scanStatus();
+
+#endif // SCAN_H
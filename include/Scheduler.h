@@ -0,0 +1,56 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+#include <Arduino.h>
+
+// Deadline scheduler for periodic jobs on one task.
+//
+// Jobs sit in a binary min-heap keyed by their next deadline, compared
+// with wrap-safe millis() arithmetic.  A periodic job is rescheduled from
+// its previous deadline rather than from the time it actually ran, so the
+// sampling interval does not accumulate jitter.  trigger() pulls a job
+// forward for a one-shot run; its period restarts from that run.
+class Scheduler {
+public:
+    typedef void (*Job)();
+    static const int kMaxJobs = 8;
+
+    // Register ``job`` to run every ``periodMs``, first at ``firstDueMs``.
+    // Returns its id, or -1 when the table is full.
+    int add(Job job, uint32_t periodMs, uint32_t firstDueMs);
+
+    // Change the period.  The next deadline moves so that it is at most
+    // one new period after the last run.
+    void setPeriod(int id, uint32_t periodMs);
+    uint32_t period(int id) const { return jobs[id].period; }
+
+    // Run job ``id`` at ``atMs`` unless it is already due earlier.
+    void trigger(int id, uint32_t atMs);
+
+    // Run every job whose deadline is at or before ``now``.
+    void runDue(uint32_t now);
+
+    // Milliseconds from ``now`` until the next deadline, 0 if one has
+    // already passed.
+    uint32_t msUntilNext(uint32_t now) const;
+
+private:
+    struct Entry {
+        Job job;
+        uint32_t period;
+        uint32_t due;
+        uint32_t lastRun;
+    };
+    static bool before(uint32_t a, uint32_t b) { return (int32_t)(a - b) < 0; }
+    bool less(int i, int j) const { return before(jobs[heap[i]].due, jobs[heap[j]].due); }
+    void swap(int i, int j);
+    void siftUp(int i);
+    void siftDown(int i);
+    void reschedule(int id, uint32_t due);
+
+    Entry jobs[kMaxJobs];
+    uint8_t heap[kMaxJobs];     // job ids, earliest deadline first
+    uint8_t pos[kMaxJobs];      // heap index of each job
+    int count = 0;
+};
+
+#endif // SCHEDULER_H
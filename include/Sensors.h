@@ -0,0 +1,54 @@
+#ifndef SENSORS_H
+#define SENSORS_H
+#include <Arduino.h>
+
+// Per-device sampling layer for the environmental sensors.
+//
+// One cycle does a single bus transaction per device (AHT21: one
+// measurement for temperature and humidity; ENS160: one burst read of
+// status, TVOC and eCO2; SDP810: one 3-byte read) and fills a
+// SensorSample.  Fields that were not measured this cycle keep their
+// previous value and are marked stale; fields whose device failed are
+// marked invalid.  The MQ-2 is oversampled in the background (see
+// AdcSampler.h), so its read only takes the latest smoothed voltage.
+
+enum SampleField : uint8_t {
+    SAMPLE_MQ2      = 1 << 0,
+    SAMPLE_ECO2     = 1 << 1,
+    SAMPLE_TVOC     = 1 << 2,
+    SAMPLE_TEMP     = 1 << 3,
+    SAMPLE_RH       = 1 << 4,
+    SAMPLE_PRESSURE = 1 << 5,
+};
+
+struct SensorSample {
+    uint32_t ms = 0;        // millis() when the cycle started
+    float mq2 = NAN;        // ppm
+    float eco2 = NAN;       // ppm
+    float tvoc = NAN;       // ppb
+    float temp = NAN;       // °C
+    float rh = NAN;         // %
+    float pressure = NAN;   // Pa
+    uint8_t fresh = 0;      // SampleField bits measured in this cycle
+    uint8_t invalid = 0;    // SampleField bits whose device reported an error
+
+    bool isFresh(SampleField f) const { return (fresh & f) && !(invalid & f); }
+};
+
+// Initialise the devices.  Call from the sampling task after Wire.begin().
+// Reuses the MQ-2 R0 stored in NVS; without one, the first reading
+// calibrates it.
+void sensorsBegin();
+
+// Take the next MQ-2 reading as clean air: derive R0 from it and store it
+// in NVS.  Safe from any task; the sampling task does the work.
+void sensorsRecalibrateMq2();
+
+// The MQ-2 R0 in use, kΩ; NAN before the first calibration.
+float sensorsMq2R0();
+
+// Run one sampling cycle into ``s``, which should hold the previous
+// sample so that stale fields carry over.
+void sensorsSample(SensorSample &s);
+
+#endif // SENSORS_H
@@ -0,0 +1,31 @@
+#ifndef TOPICS_H
+#define TOPICS_H
+#include <Arduino.h>
+
+// MQTT topics of this station, ``site/<siteName>/<suffix>``.
+//
+// The strings are built once and rebuilt only when the site name
+// changes, so a publish neither formats nor allocates its topic.  The
+// rebuild writes a second copy and then switches to it, so a task
+// publishing at that moment still reads a complete topic.
+
+enum Topic : uint8_t {
+    TOPIC_HEARTBEAT,
+    TOPIC_DEBUG,
+    TOPIC_SCAN,
+    TOPIC_STATUS,           // Last Will and online marker
+    TOPIC_EVENT,            // prefix: ``site/<siteName>/event/``
+    TOPIC_COUNT
+};
+
+// Rebuild the topics if the site name changed.  Call after loadSettings()
+// and from a listener for SET_SITE.
+void topicsRefresh();
+
+const char *topic(Topic t);
+
+// Write ``site/<siteName>/event/<name>`` into ``buf``.  Returns false when
+// it does not fit.
+bool eventTopic(char *buf, size_t len, const char *name);
+
+#endif // TOPICS_H
@@ -0,0 +1,62 @@
+#ifndef TRACE_H
+#define TRACE_H
+#include <Arduino.h>
+
+// Binary trace log.
+//
+// trace() writes a fixed-size record (event, time, core, two arguments)
+// into a ring owned by the core it runs on.  A writer claims a slot with
+// one atomic add and marks it complete with a sequence number, so tracing
+// never blocks and never formats; when a ring is full the oldest records
+// are overwritten.  Each ring keeps the last kTraceSlots records.
+//
+// The low-priority trace task formats the records later: with
+// ``settings.debugEnable`` it batches them as text lines into messages on
+// ``site/<SiteName>/debug``, at most kTraceBatches messages every
+// kTraceDrainMs.  Records overwritten before they were sent are reported
+// as one "dropped" line.  traceWrite() renders both rings for
+// /api/trace whether or not the MQTT stream is on.
+
+enum TraceEvent : uint8_t {
+    TR_WIFI_AP,             // no SSID configured: access point started
+    TR_WIFI_SETTINGS,       // Wi-Fi settings changed
+    TR_MQTT_SETTINGS,       // broker settings changed
+    TR_WIFI_UP,
+    TR_WIFI_LOST,
+    TR_MQTT_UP,
+    TR_MQTT_FAIL,           // a: failures in a row
+    TR_MQTT_LOST,
+    TR_EVENT,               // tag: event name, value
+    TR_HEARTBEAT,
+    TR_SCAN_START,
+    TR_SCAN_ABORT,
+    TR_SERVO,               // a, b: head angles
+    TR_LIDAR_NODATA,
+    TR_COUNT
+};
+
+static const uint16_t kTraceSlots = 128;        // records per core, a power of two
+static const uint32_t kTraceDrainMs = 1000;
+static const uint8_t kTraceBatches = 2;         // messages per drain
+static const size_t kTraceBatchLen = 240;       // fits a publish queue record
+
+// Record ``e`` with up to two integer arguments.  Safe from any task.
+void trace(TraceEvent e, int32_t a = 0, int32_t b = 0);
+
+// Record ``e`` with a value and a tag, which must be a string literal:
+// only the pointer is kept.
+void traceValue(TraceEvent e, const char *tag, float value);
+
+// One pass of the trace task: send what is pending, within the rate
+// limit.  Only one task may call it.
+void traceDrain();
+
+// RTOS task running traceDrain() every kTraceDrainMs.  Start it at a low
+// priority after pubInit().
+void traceTask(void*);
+
+// Write both rings as text, oldest first, one record per line.  Call
+// from one task at a time (the web server).
+void traceWrite(Print &out);
+
+#endif // TRACE_H
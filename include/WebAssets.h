@@ -0,0 +1,419 @@
+// Generated by tools/embed_web.py from web/ -- do not edit.
+#ifndef WEB_ASSETS_H
+#define WEB_ASSETS_H
+#include <stddef.h>
+#include <stdint.h>
+
+struct WebAsset {
+    const char *path;
+    const char *type;
+    const char *etag;           // quoted, as sent in the header
+    const uint8_t *data;        // gzip
+    size_t len;
+    bool immutable;             // URL carries the version
+};
+
+// style.css: 1756 bytes minified, 675 gzipped
+static const uint8_t kStyleCss[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x85, 0x54, 0x0d, 0x8b, 0xa3, 0x30,
+    0x10, 0xfd, 0x2b, 0x82, 0x1c, 0x6c, 0xa1, 0x11, 0xed, 0xb6, 0x85, 0x4d, 0xe0, 0xe0, 0x7e, 0x4a,
+    0x34, 0xa3, 0xe6, 0x36, 0x26, 0x92, 0xc4, 0x7e, 0x9c, 0xf4, 0xbf, 0x5f, 0x12, 0xb5, 0x6a, 0xdd,
+    0x65, 0x19, 0x5a, 0x93, 0x61, 0x9c, 0x99, 0xf7, 0xe6, 0x8d, 0x58, 0x2b, 0x65, 0x7b, 0x84, 0xf2,
+    0x0a, 0x15, 0x4a, 0x28, 0x8d, 0xe3, 0x32, 0xf5, 0x46, 0x10, 0xb2, 0x70, 0xb3, 0x93, 0xf3, 0xfd,
+    0xfd, 0xdd, 0x79, 0x6a, 0xa0, 0x0c, 0xb4, 0x8b, 0xc5, 0xf1, 0x81, 0x79, 0x9b, 0x7d, 0xd3, 0xcb,
+    0x65, 0xe9, 0x7c, 0x0d, 0xe5, 0x32, 0x44, 0x0d, 0x57, 0x4b, 0x73, 0x01, 0x28, 0x57, 0xda, 0x05,
+    0xe2, 0xb8, 0x28, 0x8a, 0xa7, 0xcf, 0xbf, 0x1c, 0x02, 0x8f, 0xc7, 0xe3, 0xda, 0xb9, 0xc8, 0xf7,
+    0xc8, 0x15, 0xbb, 0xf7, 0x0d, 0xd5, 0x15, 0x97, 0x38, 0x25, 0xa5, 0x92, 0x16, 0x95, 0xb4, 0xe1,
+    0xe2, 0x8e, 0xff, 0x68, 0x4e, 0xc5, 0xde, 0x50, 0x69, 0x90, 0x01, 0xcd, 0x4b, 0x92, 0xd3, 0xe2,
+    0xb3, 0xd2, 0xaa, 0x93, 0x53, 0x86, 0x0b, 0xd5, 0x6f, 0x33, 0xba, 0x1d, 0x59, 0x7a, 0x67, 0x80,
+    0xbb, 0xa1, 0x48, 0xc2, 0xa8, 0xfe, 0x5c, 0x91, 0x91, 0x1d, 0xbc, 0xbd, 0x90, 0x01, 0xa9, 0xb7,
+    0x35, 0x1f, 0x59, 0xe9, 0xed, 0x27, 0x3e, 0x32, 0xf0, 0xb6, 0xa1, 0xe4, 0x74, 0x3a, 0x6d, 0x29,
+    0x19, 0x28, 0xff, 0x86, 0x92, 0xa1, 0x4a, 0xff, 0x0d, 0xdc, 0x67, 0x5f, 0x6b, 0xbc, 0xcb, 0xd6,
+    0x76, 0xa4, 0xa5, 0x8c, 0x71, 0x59, 0xe1, 0x4c, 0x43, 0x43, 0x02, 0x3c, 0x2a, 0x78, 0x25, 0x71,
+    0x01, 0xd2, 0x82, 0x26, 0xad, 0x32, 0xdc, 0x72, 0x25, 0xb1, 0x06, 0x41, 0x2d, 0xbf, 0x00, 0x79,
+    0xc4, 0xb6, 0x86, 0x06, 0x90, 0x55, 0x55, 0x25, 0xa0, 0x7f, 0x06, 0xd0, 0xdc, 0x28, 0xd1, 0x59,
+    0x20, 0x9a, 0x57, 0xb5, 0x1d, 0xf3, 0xa9, 0x76, 0x38, 0xcc, 0x1d, 0x62, 0xa9, 0x24, 0x90, 0x11,
+    0x72, 0x38, 0x87, 0x49, 0x1a, 0xfe, 0x0f, 0x70, 0x96, 0x1c, 0x7c, 0xf0, 0xd0, 0x2c, 0x97, 0xb5,
+    0x9b, 0xa5, 0x25, 0x45, 0xa7, 0x8d, 0xbb, 0xb6, 0x8a, 0x87, 0x86, 0x1e, 0x9e, 0x45, 0x27, 0x83,
+    0x1b, 0xba, 0x72, 0x66, 0x6b, 0xfc, 0x71, 0x4e, 0xdb, 0x1b, 0x19, 0x65, 0x41, 0x3b, 0xab, 0xd6,
+    0x88, 0x16, 0x85, 0x07, 0xf4, 0xe3, 0x10, 0xdc, 0xa8, 0xeb, 0xc3, 0xa8, 0x26, 0x14, 0xda, 0x4c,
+    0x4e, 0x3e, 0xfe, 0x11, 0x0b, 0x07, 0x72, 0xe0, 0xbb, 0x1f, 0x2a, 0x64, 0x69, 0xfa, 0x6b, 0x6c,
+    0xd8, 0x93, 0x26, 0x68, 0x6b, 0x00, 0x4f, 0x07, 0xb2, 0x4c, 0xf1, 0x9a, 0x20, 0xb2, 0xf5, 0x7e,
+    0x75, 0x65, 0xfd, 0x08, 0x3c, 0x6b, 0x6f, 0x91, 0xa3, 0x8b, 0xb3, 0x68, 0xd4, 0xe0, 0x42, 0x08,
+    0xf3, 0x4c, 0xd2, 0x6d, 0x4f, 0x2e, 0xa5, 0x1b, 0x5f, 0xbf, 0x81, 0xb5, 0x52, 0xcd, 0x8b, 0xbe,
+    0x5f, 0xb4, 0xe3, 0xa0, 0x0b, 0x9a, 0x83, 0xe8, 0x19, 0x37, 0xad, 0xa0, 0x77, 0x9c, 0x0b, 0x55,
+    0x7c, 0x4e, 0x14, 0x0e, 0x35, 0xa3, 0xd4, 0xad, 0x42, 0x67, 0xad, 0x92, 0xfd, 0xba, 0x99, 0x28,
+    0x80, 0x5c, 0x80, 0x1e, 0x7b, 0x7c, 0x9d, 0x52, 0xd2, 0x28, 0x46, 0xc5, 0xac, 0x8e, 0x92, 0xdf,
+    0x80, 0x05, 0x3d, 0xa4, 0x44, 0x40, 0x69, 0xdd, 0x63, 0xd0, 0x49, 0xea, 0xa8, 0x75, 0x75, 0x1a,
+    0x7f, 0x98, 0x41, 0xe9, 0x2a, 0xa7, 0x6f, 0xe9, 0x3e, 0x58, 0x72, 0xdc, 0x91, 0xa9, 0xd5, 0x20,
+    0x98, 0x20, 0x50, 0xc4, 0x2d, 0x34, 0x66, 0x92, 0xe9, 0xdf, 0xce, 0x58, 0x5e, 0xde, 0x1d, 0x40,
+    0x77, 0x95, 0x76, 0x72, 0x8f, 0x6d, 0x44, 0xa5, 0xd2, 0x4d, 0xff, 0xbd, 0x14, 0xd6, 0x8a, 0x19,
+    0x26, 0xad, 0x29, 0xe3, 0x9d, 0xc1, 0x47, 0x27, 0xae, 0x31, 0x0b, 0xa2, 0x85, 0x87, 0x62, 0x9e,
+    0xbc, 0x95, 0x02, 0x6e, 0x9b, 0xca, 0xa6, 0xa5, 0x85, 0x9b, 0x24, 0xd8, 0x2b, 0x80, 0xdc, 0xaa,
+    0x63, 0x48, 0x95, 0x98, 0x5a, 0x5d, 0xd7, 0x79, 0x1e, 0xb1, 0xfb, 0x74, 0x5d, 0x54, 0xc8, 0xa3,
+    0x95, 0x78, 0xa9, 0xe2, 0xff, 0x10, 0xe3, 0x1a, 0x42, 0x0b, 0x5e, 0x7d, 0x5d, 0x23, 0xbf, 0x22,
+    0x62, 0x2b, 0xc7, 0x75, 0xda, 0xdf, 0x8c, 0x5f, 0xd6, 0xa9, 0x2b, 0xda, 0xce, 0x42, 0x5b, 0x07,
+    0x47, 0xa3, 0x04, 0x9e, 0xd2, 0x38, 0x4c, 0x7a, 0xa4, 0xc6, 0xa2, 0xae, 0x65, 0xd4, 0x42, 0xbf,
+    0xd5, 0xc2, 0xbc, 0xd0, 0x69, 0xf2, 0x31, 0x2f, 0x74, 0x7c, 0x3e, 0x9f, 0xbf, 0xf8, 0xc2, 0xb8,
+    0xa2, 0x05, 0x95, 0xc8, 0xfd, 0x2e, 0xd4, 0xec, 0xe3, 0x9a, 0x1b, 0xab, 0xf4, 0x7d, 0xbc, 0x6f,
+    0x34, 0x3a, 0xad, 0xfd, 0x62, 0x29, 0x7f, 0x58, 0xa6, 0xc7, 0x7f, 0xc2, 0xcc, 0x58, 0xb8, 0xdc,
+    0x06, 0x00, 0x00,
+};
+
+// script.js: 11584 bytes minified, 3149 gzipped
+static const uint8_t kScriptJs[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xbd, 0x5a, 0xeb, 0x8e, 0xdc, 0xb6,
+    0x15, 0xfe, 0x3f, 0x4f, 0x41, 0x23, 0x76, 0x24, 0x35, 0x1a, 0xed, 0xec, 0xba, 0x69, 0x8c, 0x5d,
+    0xaf, 0x8d, 0xc6, 0x71, 0x10, 0x17, 0x5e, 0xdb, 0xcd, 0xae, 0x91, 0x04, 0x86, 0x81, 0xe1, 0x48,
+    0x9c, 0x19, 0xc5, 0x1a, 0x51, 0x91, 0x38, 0xb7, 0x6e, 0x06, 0xb0, 0x53, 0x14, 0xfd, 0xd1, 0xbf,
+    0x79, 0x81, 0xbe, 0x41, 0x10, 0x74, 0x91, 0xd4, 0x48, 0xd3, 0x57, 0x98, 0x7d, 0x85, 0x3e, 0x49,
+    0xcf, 0x21, 0x45, 0xdd, 0x77, 0xa4, 0x4d, 0x83, 0x02, 0x36, 0x56, 0x43, 0x9e, 0xef, 0x9c, 0x8f,
+    0xe4, 0xe1, 0xe1, 0xa7, 0x8b, 0x39, 0x9e, 0x87, 0xae, 0xf0, 0x79, 0x68, 0x5a, 0xe4, 0xbc, 0xe7,
+    0xf2, 0x30, 0x11, 0x24, 0xf0, 0x17, 0xec, 0x8c, 0x8e, 0x02, 0x46, 0x8e, 0x89, 0xc7, 0xdd, 0xf9,
+    0x8c, 0x85, 0xc2, 0xf9, 0x6a, 0xce, 0xe2, 0xf5, 0x29, 0x0b, 0x98, 0x2b, 0x78, 0x6c, 0x1a, 0xef,
+    0xa0, 0x51, 0x5f, 0x48, 0x2b, 0x31, 0xe2, 0xde, 0xda, 0xb0, 0x8e, 0x34, 0x9c, 0x26, 0xe2, 0x79,
+    0xe4, 0x51, 0x51, 0xc2, 0x4f, 0x98, 0x78, 0x18, 0x30, 0xbc, 0xfc, 0x70, 0xfd, 0xc8, 0x33, 0x0d,
+    0xb4, 0xea, 0xcf, 0xa5, 0x59, 0x0e, 0x15, 0x53, 0xb0, 0x38, 0xe3, 0x93, 0x49, 0xb0, 0x13, 0x2b,
+    0xcd, 0xfa, 0x42, 0xda, 0x21, 0x38, 0x60, 0x29, 0x14, 0x40, 0x01, 0x77, 0x69, 0x70, 0x0a, 0x1c,
+    0xe9, 0x84, 0x21, 0xf0, 0x91, 0x60, 0xb3, 0x14, 0x81, 0xa6, 0xfe, 0xd8, 0xbc, 0x21, 0x7f, 0xe0,
+    0x70, 0x35, 0x66, 0xe9, 0x87, 0x1e, 0x5f, 0x3a, 0x33, 0x2a, 0xdc, 0xe9, 0x09, 0xf3, 0x7c, 0x6a,
+    0x1a, 0x66, 0x14, 0xb3, 0x31, 0x8b, 0x93, 0xbe, 0xcb, 0x03, 0x1e, 0xf7, 0x13, 0x17, 0x4d, 0x0f,
+    0x89, 0x47, 0xe3, 0x57, 0x96, 0x61, 0x29, 0x53, 0x96, 0x90, 0xfb, 0xc4, 0xc0, 0x26, 0x83, 0x1c,
+    0x12, 0x23, 0xf0, 0x27, 0x53, 0x61, 0x1c, 0xf5, 0x36, 0xbd, 0x8c, 0x38, 0x4e, 0x8c, 0xe3, 0xc2,
+    0x50, 0x93, 0xc7, 0x7e, 0x22, 0x1c, 0xc5, 0xd8, 0x54, 0x10, 0x5b, 0x53, 0x3e, 0x3e, 0x4e, 0x9d,
+    0x00, 0xbd, 0xc2, 0x04, 0x38, 0xd4, 0xf3, 0x1e, 0x2e, 0xc0, 0x0b, 0x42, 0x59, 0xc8, 0x60, 0xd2,
+    0xdd, 0xc0, 0x77, 0x11, 0x08, 0x6b, 0x75, 0x7c, 0xaf, 0xc0, 0xbf, 0xea, 0x08, 0x69, 0x29, 0x36,
+    0xc8, 0x4b, 0x36, 0x1d, 0xfd, 0x0f, 0xa4, 0x4a, 0x53, 0x9a, 0x94, 0xa7, 0x34, 0x05, 0x80, 0xd5,
+    0x26, 0x4f, 0x00, 0x48, 0x0d, 0x60, 0x75, 0xbe, 0x39, 0xea, 0xe9, 0xec, 0x22, 0x6a, 0xa5, 0x1f,
+    0x43, 0x8f, 0x09, 0x17, 0x14, 0x67, 0xff, 0xe9, 0xe8, 0x4b, 0x48, 0x26, 0x07, 0x78, 0xf8, 0x93,
+    0xd0, 0x44, 0x90, 0x4d, 0x64, 0x9f, 0xf6, 0x13, 0xf3, 0x65, 0x31, 0x0b, 0xdc, 0x98, 0x81, 0x8b,
+    0x34, 0x11, 0x20, 0x7e, 0x8c, 0xdc, 0xc0, 0xc6, 0xf1, 0x43, 0x98, 0x9d, 0x4f, 0xce, 0x4e, 0x1e,
+    0x83, 0xf5, 0x8b, 0x1e, 0x3a, 0x72, 0x02, 0x1f, 0xc8, 0xdb, 0xea, 0x3a, 0x99, 0xf1, 0x57, 0x2c,
+    0xbd, 0x66, 0x2e, 0x3f, 0x48, 0x2f, 0xc5, 0x82, 0xbb, 0xfa, 0x92, 0xcd, 0xa2, 0xf4, 0x32, 0x9e,
+    0xa6, 0x17, 0xab, 0xf4, 0xef, 0xba, 0xf7, 0x12, 0x56, 0x3b, 0x32, 0x17, 0x38, 0xe5, 0xc3, 0xbb,
+    0xc2, 0xbb, 0x77, 0xf3, 0x7c, 0x41, 0xee, 0xc3, 0x0c, 0xff, 0xe7, 0xf5, 0xb7, 0xc6, 0xe6, 0xee,
+    0x1e, 0xb4, 0x0c, 0x2d, 0xe7, 0x4b, 0xee, 0x87, 0xa6, 0x21, 0x67, 0x4b, 0xef, 0x9e, 0x12, 0x2f,
+    0xc3, 0x28, 0xf6, 0xd0, 0x28, 0x62, 0xa1, 0xf7, 0x60, 0xea, 0x07, 0x9e, 0x09, 0x23, 0x50, 0x79,
+    0x99, 0xef, 0x1b, 0xab, 0xb0, 0x87, 0x80, 0xdc, 0x4a, 0x3c, 0xe0, 0x21, 0xa4, 0x80, 0x00, 0x3f,
+    0x21, 0x5b, 0x92, 0x8f, 0xa0, 0xd9, 0xb4, 0x60, 0xe1, 0x1e, 0xe3, 0xc2, 0xb0, 0x33, 0x7f, 0xc6,
+    0x4e, 0x45, 0xec, 0x87, 0x13, 0x13, 0x97, 0x21, 0x9f, 0xf3, 0x31, 0x83, 0x24, 0x95, 0x53, 0x8e,
+    0xd3, 0x2d, 0x7f, 0x99, 0xc6, 0x1e, 0x8d, 0xfc, 0x3d, 0x64, 0x02, 0x59, 0x0c, 0x4b, 0x17, 0x9a,
+    0x31, 0x0e, 0x2c, 0x76, 0xbe, 0x4c, 0xb0, 0x06, 0xa4, 0x6d, 0xf9, 0x6a, 0x59, 0x8e, 0x8b, 0xa9,
+    0x6e, 0xa6, 0x29, 0xb7, 0x91, 0x11, 0x70, 0xbf, 0x2d, 0x13, 0x64, 0x33, 0x0f, 0x02, 0xb5, 0xfd,
+    0x22, 0x1e, 0x04, 0x48, 0x24, 0xce, 0x5a, 0x33, 0x1a, 0xb0, 0x98, 0x21, 0x2c, 0xf4, 0x67, 0x89,
+    0xa4, 0xa1, 0x70, 0x30, 0x8a, 0xcf, 0xd8, 0xe8, 0x94, 0xbb, 0xaf, 0x98, 0x30, 0x87, 0xcb, 0xe4,
+    0x70, 0x6f, 0xef, 0xe6, 0x39, 0xe6, 0x19, 0x22, 0x9c, 0x29, 0x4f, 0xc4, 0x66, 0x6f, 0x99, 0x0c,
+    0x21, 0xda, 0x32, 0x71, 0x78, 0xc8, 0x61, 0xba, 0x00, 0xa6, 0xf3, 0xde, 0x0d, 0x18, 0x8d, 0x1f,
+    0xc1, 0x94, 0xc4, 0x0b, 0x1a, 0x98, 0x59, 0x68, 0xb0, 0xae, 0xd3, 0xd8, 0xa4, 0x2e, 0x66, 0x2c,
+    0x49, 0x20, 0x7f, 0xa1, 0x9d, 0x2d, 0xd2, 0xdd, 0x13, 0xaf, 0xc9, 0x79, 0x31, 0x31, 0xff, 0x70,
+    0xfa, 0xf4, 0x89, 0x13, 0xd1, 0x38, 0x61, 0x26, 0x5b, 0x38, 0x32, 0x15, 0xad, 0x23, 0xb2, 0x21,
+    0x72, 0x06, 0x88, 0x89, 0x25, 0x63, 0x93, 0xf9, 0x73, 0x03, 0x9e, 0xb0, 0x02, 0x27, 0x7f, 0x4c,
+    0xcc, 0x1b, 0x39, 0x95, 0xd2, 0x84, 0xe0, 0x9e, 0xd1, 0x6c, 0xb3, 0x45, 0xb1, 0xc9, 0xfb, 0x83,
+    0xc1, 0x00, 0x38, 0x43, 0x2f, 0x1a, 0xf2, 0xb9, 0x30, 0xb3, 0xa9, 0xb2, 0xc9, 0x6d, 0xd5, 0xb9,
+    0x91, 0x2b, 0x9a, 0x2f, 0xa4, 0xdc, 0x1b, 0x7a, 0x3a, 0xf5, 0x46, 0x49, 0x5c, 0x1a, 0x3e, 0xa0,
+    0xe1, 0x82, 0x26, 0xbb, 0xaa, 0x26, 0x5a, 0xf5, 0x5d, 0x69, 0x66, 0x94, 0xa0, 0x27, 0x0c, 0xb2,
+    0xc7, 0x6d, 0xc7, 0xce, 0x94, 0x5d, 0x19, 0xfc, 0xe1, 0x5c, 0x08, 0x1e, 0xb6, 0x62, 0x47, 0xd2,
+    0x4c, 0x17, 0x6b, 0x6c, 0xba, 0x22, 0x5b, 0xbc, 0x98, 0x2e, 0x4f, 0xa1, 0x3b, 0x2b, 0x13, 0x2a,
+    0x94, 0x2b, 0x56, 0x38, 0x91, 0xd9, 0x40, 0x31, 0x8a, 0xdc, 0x15, 0x2b, 0x28, 0x05, 0x07, 0x9e,
+    0xe4, 0x24, 0x56, 0x8e, 0xcc, 0x8c, 0x4f, 0x61, 0x7a, 0xcc, 0x81, 0x4d, 0xe0, 0x5f, 0x01, 0xb0,
+    0xf4, 0x3d, 0x31, 0x2d, 0xb5, 0x4c, 0x19, 0xd6, 0x48, 0xb9, 0xf9, 0x60, 0xed, 0x30, 0x9e, 0x33,
+    0x89, 0x7d, 0xcf, 0x22, 0x31, 0x13, 0xf3, 0x38, 0xd4, 0xa3, 0x74, 0x97, 0xe5, 0xc8, 0xd2, 0x11,
+    0xd9, 0x93, 0xb5, 0xca, 0x81, 0xe3, 0x21, 0xc9, 0x0c, 0xa7, 0x65, 0x43, 0xe5, 0x5f, 0x5b, 0xc2,
+    0x3e, 0xcf, 0x2d, 0x59, 0x10, 0xc8, 0xf9, 0xd6, 0x31, 0x9d, 0x71, 0x40, 0x05, 0xec, 0xe9, 0xb1,
+    0x1f, 0x40, 0x9e, 0xa8, 0x62, 0xb3, 0x20, 0xf7, 0xc8, 0x20, 0x2f, 0xaa, 0x1c, 0xec, 0x4f, 0xa8,
+    0x98, 0x3a, 0x33, 0xa8, 0x34, 0x8e, 0xe3, 0x48, 0x1f, 0x96, 0x4d, 0xa6, 0x7e, 0xd6, 0x41, 0x57,
+    0x79, 0x07, 0x14, 0xfc, 0xdc, 0x39, 0x8f, 0x1f, 0x52, 0xdc, 0xc4, 0xc0, 0xc1, 0x26, 0xb1, 0xcc,
+    0x58, 0x2c, 0x9c, 0x59, 0xfb, 0xc2, 0x26, 0xae, 0xde, 0x5b, 0xea, 0x20, 0x06, 0x9f, 0xe0, 0xf8,
+    0x1e, 0x86, 0xbd, 0x4f, 0x80, 0x4f, 0x1f, 0xae, 0x2c, 0x18, 0x8a, 0x09, 0xad, 0xea, 0xfa, 0x90,
+    0xec, 0xab, 0x39, 0x07, 0xce, 0x70, 0x3a, 0xac, 0xe5, 0x91, 0x2d, 0x39, 0x03, 0x62, 0x38, 0x4d,
+    0x02, 0xf3, 0xe6, 0xb9, 0xa4, 0x15, 0xf3, 0x79, 0xe8, 0x99, 0x82, 0xfc, 0x86, 0xec, 0x1f, 0x0c,
+    0xac, 0x8d, 0xfd, 0xc1, 0xe0, 0x96, 0xfd, 0xfe, 0xe0, 0x96, 0x35, 0xc4, 0xc3, 0xe9, 0x9d, 0x3b,
+    0x77, 0xee, 0x18, 0xb9, 0x1f, 0xb9, 0x74, 0x2e, 0x98, 0xba, 0x48, 0x14, 0xff, 0xc2, 0x92, 0xe1,
+    0xb5, 0x3b, 0x95, 0x47, 0x4c, 0x43, 0x81, 0x93, 0xc9, 0x52, 0x2d, 0x70, 0xb8, 0x0a, 0xbb, 0x0a,
+    0x1c, 0xce, 0x4d, 0xbe, 0x6f, 0xd5, 0xfa, 0xcc, 0xc3, 0x10, 0x6a, 0x28, 0x7a, 0x2a, 0x6c, 0x8a,
+    0x4a, 0xf9, 0x1d, 0x6e, 0xff, 0xbe, 0x7d, 0xbb, 0xfd, 0x6e, 0xfb, 0xaf, 0xed, 0x8f, 0x97, 0xaf,
+    0xb7, 0x3f, 0x6f, 0xbf, 0x57, 0xd7, 0xdb, 0x8b, 0x43, 0x72, 0xf3, 0x5c, 0xba, 0xf1, 0x78, 0xc8,
+    0x36, 0x7b, 0xe9, 0x0f, 0xc1, 0x05, 0x0d, 0x36, 0x43, 0x20, 0x4d, 0x58, 0x00, 0xe5, 0x22, 0x0b,
+    0xa6, 0xf2, 0x6c, 0x67, 0x24, 0x58, 0x66, 0xed, 0x13, 0x2e, 0x37, 0x64, 0xfb, 0xd3, 0xf6, 0x27,
+    0x9b, 0x6c, 0xff, 0xbd, 0xbd, 0x80, 0xc8, 0x17, 0xdb, 0xb7, 0x97, 0xaf, 0x2f, 0xff, 0x76, 0xf9,
+    0xcd, 0xf6, 0x67, 0x6d, 0x34, 0x0a, 0xb0, 0x9a, 0x7a, 0x9b, 0x5b, 0x36, 0x19, 0x92, 0xf7, 0x7a,
+    0x43, 0x60, 0xf5, 0x03, 0x60, 0x2e, 0x80, 0xdf, 0x85, 0xe2, 0xa8, 0x2d, 0xdd, 0x29, 0x0d, 0x27,
+    0x68, 0x49, 0x4c, 0x4d, 0x9a, 0x05, 0x82, 0xaa, 0x10, 0x90, 0x51, 0xa5, 0x75, 0x53, 0xfd, 0xf3,
+    0x58, 0x56, 0xe6, 0x93, 0x04, 0x52, 0x60, 0x1f, 0x2b, 0xd3, 0x86, 0x5c, 0xbe, 0x19, 0x4a, 0xad,
+    0x53, 0xda, 0xaf, 0x47, 0xaa, 0x36, 0xeb, 0x7a, 0x96, 0xed, 0x73, 0x2c, 0x73, 0x85, 0x3d, 0x5f,
+    0x28, 0x79, 0xd9, 0x1a, 0xda, 0xa4, 0xb8, 0x0c, 0x90, 0x43, 0x07, 0x10, 0x07, 0x52, 0x04, 0x0b,
+    0xa1, 0xac, 0x84, 0x8d, 0x47, 0x51, 0x5e, 0x82, 0x3a, 0xe8, 0xa5, 0x5a, 0x86, 0xd8, 0x70, 0x00,
+    0x40, 0x55, 0x9b, 0x72, 0x0f, 0x52, 0xf1, 0xd9, 0xd3, 0xd3, 0x33, 0x83, 0x6c, 0xd2, 0x0c, 0x51,
+    0x98, 0x66, 0xa2, 0x50, 0xb8, 0xad, 0x54, 0xf1, 0x14, 0x52, 0x50, 0xef, 0xd4, 0x29, 0xc4, 0xe7,
+    0xf1, 0xba, 0xbd, 0x20, 0xa7, 0x86, 0xb5, 0x9a, 0x9c, 0xb6, 0x9f, 0xb2, 0x30, 0xe1, 0x71, 0x17,
+    0x07, 0x89, 0xb4, 0xac, 0x39, 0xf8, 0x14, 0x97, 0xb9, 0x0b, 0x3e, 0x46, 0x43, 0x84, 0x97, 0xaa,
+    0xf0, 0x27, 0xaa, 0xb7, 0xb1, 0x10, 0x97, 0xc6, 0xd8, 0x54, 0x8b, 0xa5, 0xed, 0xb2, 0x66, 0x99,
+    0x16, 0xe1, 0x69, 0xad, 0x43, 0xd5, 0xca, 0xe6, 0x22, 0x0e, 0xdb, 0x7f, 0x9a, 0xf9, 0x8c, 0x44,
+    0x56, 0x38, 0x23, 0xd0, 0x5c, 0xf0, 0xeb, 0xeb, 0xaf, 0xc9, 0x8b, 0x97, 0xaa, 0x88, 0x43, 0xa7,
+    0x13, 0xb0, 0x70, 0x02, 0xf5, 0xf9, 0x2e, 0x39, 0xa8, 0x16, 0x72, 0x31, 0x00, 0x24, 0x98, 0xbc,
+    0x18, 0xbc, 0x84, 0x7f, 0xa0, 0x5c, 0xf7, 0xd3, 0xdf, 0x05, 0x58, 0x9f, 0xec, 0x63, 0xe7, 0x95,
+    0x55, 0x17, 0x4d, 0x51, 0x0e, 0x46, 0x98, 0x1d, 0xd1, 0x8b, 0xfd, 0x97, 0x56, 0x53, 0x09, 0xae,
+    0x58, 0x1d, 0xbc, 0xb4, 0x32, 0xfe, 0x38, 0x7b, 0x02, 0x9b, 0xa1, 0x22, 0xf6, 0x81, 0x92, 0x2c,
+    0xaa, 0xc0, 0x04, 0xaf, 0x71, 0x28, 0xfb, 0x16, 0x54, 0xbd, 0xa5, 0xb6, 0x5e, 0xcb, 0x9a, 0x0a,
+    0xd6, 0xc8, 0xec, 0xb7, 0xf0, 0xbf, 0xa1, 0x14, 0x67, 0x28, 0x13, 0x8d, 0xee, 0x58, 0xf5, 0xaa,
+    0x6c, 0xc4, 0x93, 0x11, 0x35, 0x3f, 0x18, 0xd8, 0xfb, 0xb7, 0xe1, 0xff, 0x9d, 0x81, 0x3d, 0x70,
+    0x6e, 0x5b, 0x69, 0xd5, 0x1d, 0xb1, 0x89, 0x1f, 0x3e, 0x03, 0xee, 0x98, 0xc0, 0xc8, 0x3b, 0x3b,
+    0x14, 0x22, 0x9b, 0xf8, 0x72, 0x13, 0xf8, 0xb0, 0x19, 0xd1, 0x34, 0xf0, 0x43, 0xb8, 0x37, 0x31,
+    0x57, 0x66, 0x04, 0x33, 0x04, 0xc3, 0x5e, 0x9b, 0x6a, 0x68, 0xb0, 0x49, 0xb1, 0x7b, 0xc6, 0x17,
+    0x8d, 0xdd, 0xa9, 0xdf, 0x04, 0x36, 0x23, 0xca, 0xd6, 0x98, 0x2d, 0x18, 0x4a, 0x2c, 0x2b, 0x8b,
+    0x24, 0x67, 0xe9, 0xaa, 0x00, 0xfb, 0xca, 0x83, 0x1e, 0x92, 0x99, 0x5e, 0x27, 0x22, 0x06, 0x55,
+    0x9f, 0x0d, 0x10, 0x76, 0x3c, 0x0b, 0x46, 0xc1, 0x9c, 0xfd, 0x3a, 0xa3, 0xba, 0xbd, 0x7b, 0x54,
+    0xb7, 0x73, 0x4e, 0x8a, 0x87, 0xd9, 0x30, 0xe9, 0x72, 0x53, 0xcc, 0xa2, 0xb9, 0x60, 0x9e, 0x6c,
+    0x32, 0x4b, 0x37, 0x60, 0x96, 0x23, 0x6f, 0x2c, 0x73, 0xd8, 0x19, 0xee, 0x9e, 0xa9, 0x6f, 0x93,
+    0x03, 0x1b, 0x2a, 0xac, 0x55, 0xe9, 0x08, 0xb8, 0xec, 0xc0, 0x05, 0x3e, 0x68, 0x38, 0x03, 0xf5,
+    0x56, 0xcd, 0xb7, 0xa9, 0xc8, 0x12, 0x77, 0x1c, 0x70, 0xb8, 0x61, 0xc7, 0x7b, 0x06, 0x27, 0xe4,
+    0x4b, 0xd3, 0xd2, 0x15, 0x5c, 0xa7, 0xd8, 0x38, 0xe6, 0x33, 0xcc, 0x49, 0x0e, 0xbe, 0x9f, 0xcc,
+    0x67, 0x23, 0x28, 0x9c, 0xc5, 0xfa, 0xe1, 0x80, 0x68, 0x9d, 0x33, 0x5d, 0xe9, 0xcc, 0xa1, 0x2c,
+    0x9e, 0xa9, 0xc1, 0x7d, 0x55, 0x78, 0x8e, 0x6f, 0x9e, 0x97, 0x4a, 0x96, 0x82, 0x6c, 0xde, 0x45,
+    0xcf, 0xd0, 0x87, 0x7f, 0x36, 0xef, 0x0a, 0x0e, 0x97, 0x82, 0x6f, 0x86, 0x56, 0x6f, 0xc7, 0xb1,
+    0x9c, 0x97, 0x9d, 0xc6, 0x6a, 0x5f, 0x0e, 0xd3, 0x50, 0xf0, 0xe5, 0xc9, 0x06, 0x65, 0xbd, 0x38,
+    0x2b, 0x80, 0x2c, 0x0d, 0xa8, 0x3b, 0xac, 0xa6, 0xdb, 0xd3, 0x2e, 0x9b, 0xfc, 0x2e, 0x3d, 0x94,
+    0xca, 0xb3, 0x5f, 0x28, 0xa0, 0x01, 0xa7, 0xde, 0x29, 0x13, 0x02, 0x8e, 0xb2, 0xa4, 0xae, 0x4e,
+    0xd2, 0x0e, 0xa3, 0x79, 0x2e, 0x7a, 0x55, 0x8d, 0x72, 0xb5, 0xb4, 0xf6, 0x05, 0xeb, 0x87, 0x14,
+    0x1f, 0x6d, 0xa8, 0x49, 0xd7, 0xa5, 0x11, 0x3b, 0x9e, 0x40, 0x3b, 0xd6, 0x06, 0xbc, 0xf5, 0x4c,
+    0xeb, 0xb1, 0x3f, 0xf6, 0xb5, 0x85, 0xbc, 0x86, 0x5e, 0xbc, 0x4b, 0xbf, 0xd2, 0x3f, 0x1a, 0xf5,
+    0xe1, 0xfe, 0xdc, 0x2b, 0xf8, 0xc7, 0x36, 0x07, 0xdb, 0xb4, 0xef, 0xdd, 0xe8, 0x08, 0xee, 0xef,
+    0xab, 0x68, 0x6c, 0x5b, 0xf2, 0xd8, 0x2b, 0xb3, 0x9b, 0x7d, 0x25, 0x84, 0x66, 0x27, 0xaf, 0xdb,
+    0xd8, 0xa1, 0x51, 0x1f, 0xef, 0x15, 0x0b, 0xfe, 0xb1, 0x4d, 0xde, 0x3f, 0xb6, 0xb2, 0x93, 0xe8,
+    0x88, 0xc7, 0x35, 0x34, 0xb6, 0x75, 0x43, 0xcf, 0x13, 0x16, 0x57, 0xd1, 0xd8, 0xd6, 0x31, 0x76,
+    0x79, 0x66, 0x54, 0x6c, 0x68, 0xeb, 0x86, 0xfe, 0x8a, 0xd7, 0xc0, 0xd0, 0x84, 0xd8, 0x41, 0x1b,
+    0x34, 0x89, 0xa0, 0xac, 0x54, 0xc1, 0xb2, 0xf1, 0x94, 0xb9, 0x9d, 0x3c, 0x40, 0x35, 0x9d, 0xd1,
+    0xda, 0xc4, 0xa9, 0x56, 0x49, 0x1f, 0x33, 0xd9, 0xc8, 0x9f, 0xea, 0xc5, 0x7a, 0x5d, 0xe1, 0x92,
+    0x25, 0x53, 0x1e, 0x78, 0x89, 0x5e, 0x5d, 0x3c, 0xb6, 0xa1, 0x55, 0x3d, 0xb1, 0xb1, 0x76, 0x25,
+    0xbb, 0xb4, 0xe8, 0xc3, 0x39, 0x5c, 0x88, 0x9b, 0x21, 0xf1, 0x7c, 0x3e, 0x6a, 0xc5, 0xd2, 0x55,
+    0x33, 0x96, 0xae, 0xb0, 0xba, 0x68, 0x2a, 0xf2, 0x81, 0xd1, 0x4e, 0x2a, 0xd2, 0xa2, 0x81, 0x8a,
+    0x6c, 0x6f, 0xa1, 0x92, 0x62, 0x6b, 0x54, 0x52, 0x6c, 0x99, 0x0a, 0x3e, 0xaf, 0xda, 0xc9, 0x04,
+    0x0d, 0x1a, 0x88, 0x60, 0x73, 0x0b, 0x0f, 0x85, 0xac, 0xd1, 0x50, 0xc8, 0x32, 0x0b, 0x7c, 0x54,
+    0xb6, 0x93, 0x05, 0x1a, 0x34, 0xb0, 0xc0, 0xe6, 0x16, 0x16, 0x0a, 0x59, 0x63, 0xa1, 0x90, 0x65,
+    0x16, 0x11, 0xa4, 0x4e, 0x32, 0x8f, 0x77, 0xaf, 0x8c, 0x36, 0x6a, 0x60, 0xa3, 0xbb, 0x5a, 0x18,
+    0xe5, 0x1e, 0x6a, 0xac, 0x72, 0x0f, 0x8a, 0x59, 0xaa, 0x88, 0x03, 0x3e, 0xd1, 0xf9, 0x2d, 0xaf,
+    0xdb, 0xea, 0x16, 0x1a, 0x55, 0xf8, 0x61, 0x93, 0x04, 0x9f, 0xc0, 0x5d, 0x5f, 0xdb, 0xfe, 0x97,
+    0x78, 0xdc, 0x44, 0x4d, 0x0e, 0x3e, 0x81, 0xf6, 0x6e, 0x1e, 0xbc, 0xd8, 0x1f, 0x8b, 0xfe, 0x6c,
+    0x56, 0xf5, 0x22, 0xdb, 0x4f, 0x66, 0xf2, 0x19, 0x67, 0xab, 0x13, 0x1a, 0xd0, 0x78, 0xd6, 0xe0,
+    0x44, 0xb6, 0x77, 0x75, 0xa2, 0x98, 0x44, 0xb4, 0x91, 0xc9, 0x33, 0x7a, 0x1d, 0x26, 0x75, 0x27,
+    0xb2, 0xbd, 0xab, 0x93, 0x29, 0x8f, 0xfd, 0x3f, 0xf1, 0xda, 0xca, 0xa4, 0xcd, 0xb8, 0x38, 0xa9,
+    0x9b, 0xf4, 0x66, 0x84, 0xc5, 0x3e, 0xf7, 0xf2, 0x1b, 0x92, 0xf4, 0x67, 0x5b, 0x02, 0x28, 0xbb,
+    0x3e, 0x0b, 0x17, 0x85, 0x40, 0x29, 0xd8, 0x81, 0xd6, 0xd6, 0xf5, 0x4b, 0x1d, 0xc8, 0xea, 0xd5,
+    0xe0, 0x42, 0xb6, 0x5f, 0xcb, 0x49, 0x7f, 0x4c, 0x4b, 0xc7, 0x68, 0xc9, 0xd3, 0xc7, 0x34, 0x3f,
+    0x4e, 0xf3, 0x07, 0x7f, 0x99, 0xd4, 0xc0, 0xeb, 0xb6, 0x11, 0xcb, 0x67, 0x80, 0xab, 0x72, 0xce,
+    0x63, 0x9b, 0xb3, 0x2a, 0xcc, 0x69, 0x1b, 0xba, 0xb4, 0x1f, 0x53, 0x34, 0x5d, 0x75, 0x43, 0xaf,
+    0x1b, 0x62, 0xaf, 0x3b, 0xc7, 0x5e, 0x37, 0xc4, 0x5e, 0x77, 0x8e, 0x8d, 0xcf, 0x08, 0xab, 0x68,
+    0x6c, 0xeb, 0x86, 0xc6, 0xe7, 0x86, 0x55, 0x34, 0xb6, 0x75, 0x43, 0xab, 0x85, 0xac, 0xe2, 0x55,
+    0x6b, 0x97, 0xe1, 0x7b, 0x6c, 0x34, 0x9f, 0x40, 0xa6, 0xe2, 0x6b, 0x0b, 0xf0, 0xe2, 0x4e, 0x19,
+    0x3e, 0x64, 0x02, 0x3f, 0x37, 0x6e, 0xa4, 0x4f, 0x8e, 0xa0, 0xff, 0xa1, 0xec, 0xde, 0xe1, 0x65,
+    0xee, 0x57, 0xb5, 0x92, 0x04, 0xcf, 0xfd, 0xe7, 0x05, 0xb5, 0xb4, 0x01, 0xe1, 0xdb, 0xa0, 0xf9,
+    0x4b, 0xef, 0x2d, 0x38, 0xdc, 0xd6, 0x5d, 0xf1, 0xd4, 0x66, 0xec, 0x87, 0x34, 0x08, 0xd6, 0x66,
+    0x51, 0x79, 0xe7, 0x4f, 0xaa, 0xd3, 0x86, 0x8f, 0x41, 0xa2, 0xec, 0x7c, 0x56, 0x9d, 0xda, 0x49,
+    0x85, 0x63, 0xa8, 0x5b, 0x80, 0x0c, 0xd8, 0x70, 0xe7, 0x90, 0xcc, 0x47, 0x33, 0x5f, 0x00, 0x23,
+    0xfd, 0x52, 0x81, 0x2d, 0xf0, 0x94, 0x40, 0xa3, 0x8f, 0xd8, 0x98, 0xce, 0x03, 0x91, 0x3f, 0x17,
+    0x52, 0x7a, 0x1e, 0x1f, 0xfa, 0xa5, 0xe2, 0xfc, 0x90, 0x74, 0x17, 0xf6, 0x76, 0x0f, 0x95, 0xf3,
+    0x21, 0xa2, 0x41, 0x7a, 0xef, 0x40, 0xd6, 0x24, 0xbb, 0xdd, 0xd3, 0x72, 0xbb, 0x0d, 0x55, 0x14,
+    0xa4, 0xbd, 0x8d, 0xdd, 0x43, 0x51, 0x87, 0x11, 0x51, 0x4e, 0xef, 0xc0, 0xd6, 0x64, 0x38, 0x44,
+    0x04, 0x09, 0x7d, 0xa8, 0xef, 0x26, 0xbb, 0x2b, 0x70, 0xcb, 0xee, 0x61, 0x9a, 0xb4, 0xc5, 0x2a,
+    0xa6, 0x92, 0x1a, 0x5d, 0x1b, 0xa2, 0x38, 0x32, 0xbb, 0x07, 0x3a, 0xb9, 0x23, 0xb9, 0x82, 0xc8,
+    0x06, 0x6e, 0x5a, 0x22, 0x77, 0x04, 0x97, 0x64, 0x36, 0xc0, 0x95, 0x3c, 0x6e, 0xa3, 0x5a, 0x96,
+    0xd6, 0xb8, 0x0c, 0xb9, 0x66, 0xc6, 0xc5, 0x90, 0x15, 0x19, 0x2f, 0xa0, 0xa0, 0xb5, 0x13, 0xa9,
+    0x69, 0x66, 0xe0, 0x01, 0xb5, 0xac, 0x33, 0x30, 0x2f, 0x7b, 0x16, 0x52, 0x91, 0x1a, 0xb5, 0x73,
+    0xf0, 0x9a, 0x4a, 0xee, 0x1a, 0xbc, 0x26, 0x91, 0x65, 0x70, 0x54, 0xa6, 0x9d, 0x63, 0x57, 0x75,
+    0x71, 0xd7, 0xd0, 0x55, 0x55, 0x2c, 0x23, 0xa3, 0x1a, 0xed, 0x1c, 0xb9, 0xaa, 0x85, 0xbb, 0x46,
+    0xae, 0x2a, 0x61, 0x19, 0x59, 0x2b, 0xce, 0xce, 0xd1, 0x9b, 0xf4, 0x6f, 0x57, 0x06, 0x4d, 0xca,
+    0x17, 0x58, 0x20, 0x0f, 0x54, 0x41, 0x87, 0xf2, 0xcd, 0xab, 0x94, 0xa8, 0xed, 0xbe, 0xaa, 0x1a,
+    0xd7, 0x52, 0x3e, 0x50, 0x9d, 0x76, 0x04, 0x17, 0x05, 0x2e, 0xa0, 0x53, 0x55, 0xda, 0x11, 0x5c,
+    0xd5, 0xb6, 0xe0, 0x20, 0x55, 0xa4, 0x1d, 0x1d, 0x54, 0x75, 0xad, 0x66, 0xf0, 0x8c, 0x5e, 0x8b,
+    0x41, 0x2e, 0x47, 0x35, 0x83, 0xce, 0x0e, 0xaa, 0x7a, 0x16, 0x1c, 0xe4, 0x32, 0xb4, 0xf3, 0x1c,
+    0x96, 0xe4, 0xac, 0x4a, 0x29, 0x25, 0xed, 0x70, 0x35, 0x41, 0x6a, 0x76, 0xc8, 0x8a, 0x9a, 0x58,
+    0xb5, 0x6c, 0x5d, 0x85, 0x3a, 0x62, 0x4b, 0x3a, 0x55, 0xa3, 0x51, 0x55, 0x5e, 0xcf, 0x43, 0x49,
+    0xa4, 0xaa, 0x7a, 0x04, 0x62, 0x06, 0x07, 0xb2, 0xea, 0x34, 0x25, 0x35, 0x11, 0x0a, 0x54, 0x50,
+    0x41, 0x76, 0x46, 0x16, 0xb6, 0x85, 0xdd, 0x5b, 0x77, 0x8f, 0xb9, 0x2e, 0xc7, 0x5c, 0x77, 0x8f,
+    0xb9, 0x2e, 0xc7, 0x44, 0xd5, 0xd8, 0x11, 0x59, 0x14, 0x9d, 0x80, 0x44, 0xc5, 0xd8, 0x11, 0x59,
+    0x14, 0x9c, 0x96, 0xce, 0x97, 0xee, 0x83, 0x2d, 0x2b, 0x4e, 0xb9, 0x4c, 0x05, 0x91, 0xb8, 0xe3,
+    0xf8, 0x6b, 0x96, 0x9a, 0x20, 0x09, 0xa4, 0x4a, 0xdc, 0x01, 0xac, 0xa8, 0x4b, 0xfc, 0x66, 0xa2,
+    0xf1, 0x69, 0xab, 0x8d, 0x45, 0xb4, 0xa4, 0x1b, 0x61, 0x4b, 0x31, 0xea, 0xb1, 0x18, 0x77, 0x03,
+    0x31, 0xd2, 0x97, 0xaf, 0xfd, 0xb3, 0x75, 0xc4, 0x0c, 0x30, 0xa1, 0x51, 0x14, 0xf8, 0xea, 0x93,
+    0x94, 0x3d, 0xf9, 0x40, 0x8b, 0xc0, 0x58, 0xf0, 0xe1, 0xfd, 0x21, 0x91, 0x9f, 0x8a, 0x24, 0xf2,
+    0xa3, 0x1b, 0x7f, 0x9c, 0xbe, 0x22, 0x93, 0xef, 0x03, 0xf1, 0xff, 0x8e, 0x03, 0xfe, 0xa0, 0xef,
+    0xd2, 0xc0, 0x1f, 0xc5, 0xf2, 0xab, 0xb7, 0x0e, 0x6f, 0x2c, 0xf1, 0xd9, 0x07, 0xa8, 0xc7, 0xb1,
+    0x1f, 0xcf, 0x4c, 0x63, 0xfb, 0xed, 0xf6, 0xbb, 0xcb, 0x6f, 0x2e, 0xff, 0xba, 0xfd, 0x71, 0xfb,
+    0x96, 0x9c, 0xfc, 0xb1, 0x7f, 0x40, 0x2e, 0xdf, 0x6c, 0x2f, 0xb6, 0xff, 0x84, 0x96, 0xef, 0x2e,
+    0xdf, 0x90, 0xed, 0xf7, 0x04, 0xfb, 0x2e, 0xdf, 0xe0, 0x5b, 0xe1, 0xed, 0x4f, 0xf0, 0x1b, 0xfe,
+    0xfc, 0xb0, 0xfd, 0xc7, 0xe5, 0x9f, 0x2f, 0xff, 0xb2, 0xbd, 0xb8, 0x6f, 0x58, 0xd5, 0xc7, 0xd0,
+    0x39, 0x95, 0x46, 0x45, 0x8d, 0xe2, 0x3b, 0xff, 0xa8, 0x2b, 0x5a, 0xb6, 0x69, 0x67, 0x2d, 0x33,
+    0x33, 0xed, 0xac, 0x20, 0xbf, 0x92, 0x6a, 0x26, 0x1d, 0x54, 0x6c, 0xc8, 0x96, 0x7d, 0x6d, 0x96,
+    0xdd, 0x6b, 0x54, 0xb2, 0x21, 0xeb, 0xff, 0x7f, 0x65, 0x83, 0x1a, 0x06, 0x17, 0xf4, 0x84, 0x7b,
+    0x34, 0xd8, 0x35, 0x81, 0x60, 0xd3, 0x9f, 0xa1, 0x91, 0x51, 0x84, 0xb5, 0x7f, 0x60, 0x83, 0xb8,
+    0xfc, 0xfb, 0x9a, 0x0c, 0xf8, 0x80, 0x86, 0x2e, 0x6b, 0x0d, 0xe8, 0x4a, 0x2b, 0x04, 0x66, 0xb1,
+    0x5a, 0xf3, 0x52, 0x0f, 0xa6, 0xf0, 0x15, 0x21, 0x40, 0x60, 0x5d, 0xa7, 0x7c, 0x69, 0x58, 0xca,
+    0x95, 0x8a, 0xfe, 0x4b, 0x5c, 0xc5, 0x0c, 0xdf, 0xb9, 0x15, 0xbc, 0x65, 0x2f, 0x55, 0x12, 0xfc,
+    0x68, 0x6e, 0xe6, 0x99, 0xee, 0x4c, 0x7e, 0x3c, 0x81, 0x9b, 0x63, 0x99, 0x80, 0x3d, 0xf5, 0xd6,
+    0xa7, 0x42, 0x7e, 0x6f, 0x7a, 0x7c, 0x9c, 0x7f, 0x57, 0xe6, 0x3c, 0x7d, 0xf6, 0xf0, 0x89, 0xfa,
+    0xe4, 0xcc, 0x41, 0xa4, 0x84, 0xc9, 0xa4, 0xbe, 0x7a, 0x87, 0x8e, 0x04, 0xd4, 0xf9, 0x7e, 0x14,
+    0xcc, 0x93, 0x0e, 0xdb, 0x53, 0xd3, 0x31, 0x3e, 0x7f, 0x4f, 0xf2, 0x6c, 0xf1, 0x0a, 0x87, 0xc0,
+    0x35, 0xdd, 0xf6, 0xdb, 0xdd, 0xae, 0xaf, 0x4d, 0xf6, 0x8b, 0xf7, 0xba, 0x78, 0xbd, 0x36, 0xd9,
+    0x2f, 0x2a, 0x64, 0xeb, 0xc0, 0x57, 0x6c, 0xed, 0xf1, 0x65, 0x58, 0xd8, 0xf6, 0xb8, 0x80, 0xb0,
+    0xf5, 0xa1, 0x43, 0x7d, 0x70, 0xfa, 0xfb, 0x18, 0xce, 0x9e, 0xe7, 0x91, 0x61, 0x95, 0xd9, 0x1e,
+    0xf5, 0xb2, 0x8f, 0x67, 0x6a, 0xd6, 0x1f, 0xa1, 0x47, 0xab, 0x4c, 0x63, 0x97, 0xfd, 0x63, 0x36,
+    0x16, 0x45, 0xfb, 0xcf, 0x5b, 0xec, 0x3f, 0x95, 0x9f, 0xd1, 0x5a, 0xe5, 0xb5, 0x3e, 0x4a, 0x37,
+    0x37, 0x54, 0xa9, 0xff, 0x02, 0x90, 0x9c, 0xe2, 0x7d, 0x40, 0x2d, 0x00, 0x00,
+};
+
+// index.html: 7372 bytes minified, 2314 gzipped
+static const uint8_t kIndexHtml[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x9d, 0x59, 0x5b, 0x6f, 0x1b, 0xc7,
+    0x15, 0x7e, 0xcf, 0xaf, 0x98, 0x6e, 0x81, 0x40, 0x41, 0xbd, 0xe2, 0x45, 0x8a, 0x2c, 0x37, 0x22,
+    0x0b, 0x43, 0x8e, 0xe1, 0x14, 0x55, 0x44, 0x9b, 0x52, 0x2b, 0x3d, 0x2e, 0x77, 0x87, 0xe4, 0xc4,
+    0x7b, 0xf3, 0xee, 0x90, 0x12, 0xfb, 0x24, 0x4b, 0x4d, 0xdc, 0xc2, 0x46, 0x8c, 0xa0, 0x01, 0x1a,
+    0x14, 0x48, 0x8a, 0xb4, 0x7d, 0xe8, 0x23, 0xad, 0xd8, 0xb0, 0x6c, 0x5d, 0x0c, 0xe4, 0x17, 0xec,
+    0xfe, 0x85, 0xfc, 0x92, 0x9e, 0x33, 0x33, 0xdc, 0x0b, 0x97, 0x37, 0x19, 0x7c, 0xe0, 0x9e, 0xd9,
+    0x99, 0x73, 0xce, 0x77, 0xe6, 0xdc, 0x66, 0x76, 0xe3, 0x57, 0x77, 0xb6, 0x37, 0x77, 0xf6, 0x1b,
+    0x9f, 0x92, 0x2e, 0x77, 0xec, 0xfa, 0x07, 0x1b, 0xf8, 0x47, 0x6c, 0xc3, 0xed, 0xd4, 0xb4, 0xa0,
+    0xa7, 0xe1, 0x00, 0x35, 0x2c, 0xf8, 0x73, 0x28, 0x37, 0x88, 0xd9, 0x35, 0x82, 0x90, 0xf2, 0x9a,
+    0xb6, 0xbb, 0x73, 0x57, 0x5f, 0xd7, 0x46, 0xc3, 0xae, 0xe1, 0xd0, 0x9a, 0xd6, 0x67, 0xf4, 0xc0,
+    0xf7, 0x02, 0xae, 0x11, 0xd3, 0x73, 0x39, 0x75, 0x61, 0xda, 0x01, 0xb3, 0x78, 0xb7, 0x66, 0xd1,
+    0x3e, 0x33, 0xa9, 0x2e, 0x88, 0x1b, 0x84, 0xb9, 0x8c, 0x33, 0xc3, 0xd6, 0x43, 0xd3, 0xb0, 0x69,
+    0xad, 0xb2, 0x5c, 0x46, 0x36, 0x9c, 0x71, 0x9b, 0xd6, 0x37, 0xbb, 0x8d, 0x90, 0xba, 0xa1, 0x17,
+    0x90, 0x26, 0x0d, 0x70, 0x0d, 0xd9, 0xfd, 0x6c, 0xa3, 0x24, 0xdf, 0x7d, 0xb0, 0x61, 0x33, 0xf7,
+    0x21, 0x09, 0xa8, 0x5d, 0xd3, 0x42, 0x3e, 0xb0, 0x69, 0xd8, 0xa5, 0x14, 0x64, 0x75, 0x03, 0xda,
+    0x56, 0x23, 0xcb, 0x66, 0x18, 0xfe, 0xae, 0x5f, 0xab, 0xac, 0xaf, 0x96, 0xd7, 0xcc, 0xb5, 0xf6,
+    0x4a, 0xd5, 0xaa, 0xac, 0x9a, 0x15, 0xa1, 0x66, 0x68, 0x06, 0xcc, 0xe7, 0x24, 0x0c, 0x4c, 0x98,
+    0x2b, 0x9e, 0x97, 0xbf, 0xc0, 0xb9, 0x65, 0xcb, 0x30, 0x68, 0xbb, 0xd2, 0x5a, 0xa9, 0xdc, 0xbc,
+    0x55, 0x5d, 0x37, 0xd7, 0x35, 0x62, 0xd1, 0x36, 0x0d, 0xea, 0x1b, 0x25, 0x39, 0x0b, 0x96, 0x96,
+    0x94, 0x01, 0x5a, 0x9e, 0x35, 0x50, 0xe6, 0x80, 0x09, 0xf0, 0x50, 0x99, 0xa2, 0x2f, 0xbc, 0x80,
+    0xd9, 0x3d, 0xce, 0x3d, 0x97, 0x30, 0xab, 0xa6, 0xf1, 0x2e, 0x75, 0xa8, 0xce, 0xbd, 0x4e, 0xc7,
+    0xa6, 0x1a, 0x11, 0x68, 0x6a, 0x5a, 0xf4, 0xaf, 0xe8, 0x55, 0x7c, 0x14, 0xbd, 0x8a, 0xde, 0x46,
+    0xe7, 0xf1, 0xd7, 0xf1, 0x93, 0xe8, 0x2c, 0x3e, 0x8e, 0x9f, 0x91, 0xf8, 0x18, 0x86, 0x2e, 0xe2,
+    0x13, 0xad, 0xfe, 0xe1, 0xaf, 0x2b, 0xd5, 0x9b, 0x37, 0xd7, 0x6e, 0x7d, 0xb2, 0x51, 0x92, 0xbc,
+    0x46, 0xaa, 0x08, 0xe1, 0x8e, 0xc1, 0x70, 0x20, 0xa4, 0x26, 0x67, 0x4a, 0x8c, 0xcd, 0xfa, 0x54,
+    0xf7, 0x0d, 0x97, 0xda, 0x62, 0xd7, 0xaa, 0xf5, 0x3f, 0xe0, 0x40, 0xf4, 0x2e, 0x1a, 0x46, 0x97,
+    0xc0, 0xf4, 0x3c, 0x7e, 0x06, 0xeb, 0xab, 0x68, 0x6b, 0xa3, 0x65, 0xd3, 0x74, 0x89, 0x20, 0xc5,
+    0x1e, 0x28, 0xa0, 0x3c, 0x10, 0x04, 0xac, 0xb7, 0x8c, 0x00, 0xcc, 0xdf, 0x95, 0x64, 0xd3, 0xf1,
+    0x1e, 0xd2, 0x94, 0xa4, 0x9b, 0xdb, 0xbf, 0x1c, 0x1f, 0xa7, 0xf4, 0xce, 0x1f, 0xb7, 0x37, 0x53,
+    0x8a, 0xff, 0x3c, 0x4c, 0x89, 0x07, 0xf7, 0xd2, 0xe7, 0xbd, 0xec, 0x8b, 0xfd, 0x84, 0x28, 0x09,
+    0xa1, 0xa5, 0x44, 0x05, 0x65, 0x6c, 0xa9, 0x8a, 0x05, 0x0e, 0x65, 0x87, 0x00, 0xad, 0xa6, 0xc1,
+    0x06, 0x89, 0xad, 0x06, 0xab, 0xd2, 0x43, 0xae, 0x1b, 0x36, 0xeb, 0xb8, 0xbf, 0x35, 0xc1, 0xd7,
+    0x68, 0xf0, 0x89, 0x56, 0xff, 0xe5, 0xe8, 0x5b, 0xe0, 0x61, 0x65, 0xf8, 0x29, 0x3e, 0x25, 0x01,
+    0x12, 0x1e, 0x2c, 0xd6, 0x17, 0xc8, 0x43, 0xd8, 0x2f, 0x4f, 0x47, 0x3f, 0x0d, 0x80, 0xb5, 0x96,
+    0xdf, 0xb0, 0x16, 0x77, 0xf5, 0x81, 0xee, 0xdb, 0x3d, 0x78, 0xb1, 0xff, 0x9b, 0x8c, 0xfd, 0x61,
+    0x75, 0x71, 0xe6, 0xa1, 0xee, 0x30, 0x17, 0xa7, 0xee, 0xe9, 0x99, 0xa9, 0x85, 0x49, 0x92, 0xdd,
+    0x5e, 0x96, 0x5d, 0x69, 0x22, 0xbf, 0xc1, 0x88, 0xdf, 0xbe, 0x5e, 0x9c, 0xeb, 0xcb, 0x7d, 0x33,
+    0x42, 0xae, 0xf7, 0x7c, 0xcb, 0xe0, 0xb0, 0x71, 0x1f, 0x3a, 0x96, 0x11, 0x76, 0xc1, 0x4d, 0x7c,
+    0x9c, 0xa6, 0x3c, 0x62, 0xcc, 0x37, 0x20, 0xd6, 0xdc, 0x9c, 0x6f, 0x44, 0xff, 0x8c, 0x86, 0xf1,
+    0x11, 0x78, 0xdb, 0x90, 0x44, 0xaf, 0xc1, 0x43, 0xde, 0x45, 0x57, 0xd1, 0xb9, 0xf0, 0x93, 0x4b,
+    0xf0, 0xc4, 0xe7, 0xca, 0x53, 0x60, 0x55, 0xdf, 0x08, 0x53, 0x0e, 0x92, 0xd6, 0x88, 0x0c, 0x6b,
+    0x6d, 0xa5, 0x5c, 0x86, 0xf8, 0xa3, 0xac, 0xd3, 0xe5, 0x92, 0x80, 0xb0, 0x91, 0x53, 0x12, 0x4d,
+    0xc5, 0x32, 0xc8, 0x11, 0x01, 0x33, 0xc3, 0x31, 0x55, 0x33, 0xb0, 0xc5, 0x2c, 0x49, 0x6b, 0xf5,
+    0xe8, 0x47, 0x88, 0x89, 0xa1, 0xd0, 0xe3, 0x08, 0xb4, 0x3a, 0x05, 0x45, 0x8f, 0xd1, 0x77, 0x53,
+    0x53, 0x4c, 0xc6, 0xd8, 0x65, 0x21, 0xf7, 0x82, 0x41, 0x1e, 0xe6, 0x77, 0xf1, 0x63, 0x00, 0x79,
+    0x05, 0x9c, 0x52, 0x54, 0xb6, 0xd1, 0xa2, 0x76, 0x3d, 0xfa, 0x56, 0x30, 0x86, 0xc0, 0x8b, 0xde,
+    0x12, 0x60, 0x64, 0x03, 0xab, 0x1c, 0x1f, 0x19, 0xd9, 0xc8, 0xc8, 0xf3, 0x85, 0x90, 0xbe, 0x61,
+    0xf7, 0x28, 0x06, 0x0d, 0x84, 0x85, 0x36, 0x8a, 0x0e, 0xf9, 0xae, 0x3e, 0x36, 0x27, 0xc4, 0x58,
+    0xd1, 0x46, 0x21, 0xa3, 0xe6, 0x8c, 0x33, 0xa2, 0xa6, 0x57, 0xd5, 0x92, 0x38, 0x9a, 0xcc, 0x88,
+    0xf7, 0x3d, 0x53, 0x53, 0xb1, 0x35, 0x85, 0x0d, 0xa7, 0x8e, 0xaf, 0xc9, 0x80, 0x9b, 0xcc, 0x23,
+    0xe8, 0x6a, 0x22, 0x04, 0xa7, 0xac, 0xf7, 0x03, 0x1a, 0x86, 0xbd, 0x00, 0xd4, 0x6d, 0xa8, 0xa7,
+    0xcc, 0xd4, 0x92, 0x34, 0x0c, 0x6c, 0xac, 0xb4, 0x5a, 0x62, 0x3d, 0x99, 0xbe, 0xce, 0x60, 0x83,
+    0x5e, 0x4e, 0xb4, 0x5e, 0x00, 0x15, 0x84, 0x16, 0x8d, 0x57, 0xad, 0xac, 0xa1, 0x9f, 0xac, 0x91,
+    0xf8, 0xc9, 0x34, 0x75, 0xd7, 0xd7, 0x56, 0xd1, 0xaf, 0x24, 0x4f, 0x6a, 0xd5, 0xab, 0xab, 0xd9,
+    0xc9, 0xe3, 0x0c, 0xd7, 0xca, 0xab, 0xeb, 0xc8, 0xf1, 0x26, 0x89, 0x5e, 0x0a, 0xff, 0x7d, 0x33,
+    0x8d, 0x6f, 0xf5, 0xe3, 0x5b, 0xd5, 0x32, 0x4e, 0x5d, 0x29, 0x17, 0xe7, 0x4e, 0x42, 0x9a, 0xf1,
+    0xfe, 0x11, 0xaa, 0xb1, 0x00, 0x58, 0xcb, 0x06, 0x40, 0x75, 0x2c, 0x00, 0xa6, 0x85, 0x22, 0xe5,
+    0x9c, 0xb9, 0x9d, 0x70, 0xe4, 0xa1, 0xdf, 0x83, 0x1b, 0x82, 0x8f, 0x0a, 0x5f, 0x7f, 0x03, 0x9e,
+    0x7f, 0xa6, 0xbc, 0xb4, 0xed, 0x05, 0x4e, 0x6e, 0x81, 0x8e, 0x23, 0x5a, 0xb2, 0x03, 0x4d, 0xc6,
+    0xe9, 0xe7, 0x50, 0x77, 0xc9, 0x06, 0x73, 0xfd, 0x1e, 0x27, 0x7c, 0xe0, 0xab, 0xac, 0xa8, 0xc9,
+    0x65, 0xf0, 0x5e, 0xc7, 0xc2, 0xac, 0xa9, 0xf2, 0x1c, 0xaa, 0x05, 0x1a, 0x71, 0x8c, 0x43, 0x9b,
+    0xba, 0x1d, 0x44, 0x50, 0x5d, 0xd5, 0x32, 0x88, 0x2d, 0x28, 0xe6, 0xcc, 0x0e, 0x89, 0xe7, 0x53,
+    0xa1, 0x76, 0xcf, 0x71, 0x8c, 0x60, 0x50, 0xff, 0x13, 0xd3, 0xef, 0x32, 0xc0, 0xa3, 0xc8, 0x44,
+    0x83, 0xe6, 0x67, 0x77, 0xa6, 0x49, 0x3f, 0x60, 0x6d, 0xa6, 0x87, 0x21, 0xb3, 0x46, 0xd2, 0x71,
+    0xa0, 0x29, 0xe8, 0x8c, 0xf4, 0x95, 0xaa, 0x36, 0xc9, 0xb3, 0x86, 0xc2, 0x18, 0x50, 0xb0, 0xf2,
+    0xdc, 0x7d, 0x23, 0x0c, 0x0f, 0xbc, 0xc0, 0xca, 0x48, 0xc0, 0xa1, 0xac, 0x84, 0x06, 0xd2, 0x19,
+    0x96, 0x25, 0x85, 0x28, 0xc5, 0x96, 0x81, 0xb5, 0x75, 0x7f, 0x67, 0xa7, 0x88, 0xea, 0x9e, 0x17,
+    0xf2, 0x69, 0xa8, 0x9c, 0x47, 0x9c, 0xeb, 0x5d, 0x98, 0x30, 0x92, 0x89, 0x03, 0xb8, 0xa0, 0x08,
+    0xa3, 0x01, 0x8d, 0x50, 0x9e, 0x8d, 0xdb, 0x73, 0x5a, 0x34, 0xc8, 0x30, 0x92, 0xbd, 0x52, 0xca,
+    0xa8, 0x21, 0x68, 0xe5, 0xad, 0x95, 0xf5, 0xf5, 0x95, 0x22, 0xd7, 0x5d, 0xa8, 0x5b, 0x33, 0x95,
+    0xeb, 0x85, 0x28, 0x22, 0xe5, 0xb9, 0x2b, 0xe8, 0x39, 0x26, 0x47, 0xab, 0xcd, 0x32, 0xb5, 0xd4,
+    0x36, 0x63, 0x6a, 0xa1, 0xed, 0x98, 0xa9, 0xe5, 0xff, 0x7d, 0xaf, 0x99, 0x4b, 0x07, 0x62, 0xe9,
+    0x23, 0x2f, 0xb7, 0xf2, 0xbe, 0x87, 0x0b, 0xf3, 0xc1, 0x09, 0xa1, 0x53, 0x9e, 0x16, 0xb8, 0x15,
+    0xad, 0x5e, 0x99, 0x1a, 0xd4, 0x5a, 0xbd, 0x9a, 0xbe, 0x9b, 0x9a, 0xad, 0xbe, 0x89, 0x4f, 0xe2,
+    0xbf, 0x60, 0xc6, 0x22, 0xd1, 0x29, 0x79, 0x70, 0x7b, 0x8b, 0x2c, 0xc5, 0x8f, 0x3f, 0x9a, 0xb3,
+    0x3d, 0xa1, 0xcf, 0x6c, 0x7b, 0xa4, 0x77, 0xab, 0xd7, 0x6e, 0x22, 0xdd, 0xa4, 0x26, 0x98, 0x93,
+    0xb9, 0x42, 0xe3, 0x82, 0x98, 0xff, 0x8a, 0x4a, 0x73, 0x81, 0x85, 0xa5, 0x68, 0x05, 0x0c, 0x5f,
+    0x23, 0xb7, 0xe1, 0x77, 0xe5, 0xc8, 0x38, 0xa6, 0x2f, 0x42, 0x2c, 0x83, 0xbf, 0x6f, 0x6e, 0x7f,
+    0x3e, 0x0d, 0xb5, 0x13, 0x76, 0x7c, 0xc3, 0x7c, 0xa8, 0xd5, 0xb7, 0x20, 0x61, 0x1b, 0x1d, 0xda,
+    0x00, 0x62, 0x96, 0x15, 0x66, 0x86, 0x01, 0x04, 0xdc, 0x95, 0x08, 0xb8, 0x9f, 0x30, 0xf7, 0xa4,
+    0xe1, 0x80, 0xad, 0x92, 0x09, 0x9d, 0x46, 0x88, 0x1d, 0x2c, 0x54, 0x86, 0xae, 0x67, 0x5b, 0x7a,
+    0x27, 0xf0, 0x7a, 0xbe, 0x48, 0x5d, 0xab, 0xb2, 0x02, 0x92, 0x25, 0xc0, 0x7b, 0xf1, 0x11, 0x24,
+    0xad, 0xd5, 0xc4, 0x0e, 0x60, 0x9f, 0xe9, 0xb6, 0x15, 0xe5, 0x13, 0x5b, 0x9c, 0x91, 0x25, 0xc4,
+    0xc0, 0x16, 0xd0, 0x05, 0x7b, 0x82, 0xdb, 0xce, 0xe5, 0x63, 0x1c, 0xe6, 0xf9, 0x00, 0x9d, 0x03,
+    0x2e, 0xba, 0xa6, 0xb9, 0x50, 0x44, 0xa1, 0x26, 0x4b, 0xbe, 0xef, 0x5c, 0x03, 0x89, 0x28, 0xf2,
+    0x59, 0x24, 0x62, 0xe0, 0xfa, 0x48, 0x14, 0x9f, 0x14, 0x89, 0xe4, 0x93, 0x47, 0xa2, 0xba, 0x25,
+    0xb9, 0x5a, 0xb5, 0x4a, 0xca, 0xb7, 0xaa, 0x50, 0x96, 0x6c, 0xd6, 0x0a, 0xb0, 0x1b, 0x4c, 0x8e,
+    0x17, 0xff, 0x96, 0x19, 0x14, 0x0a, 0xca, 0x15, 0xfa, 0xbc, 0x38, 0x60, 0x88, 0x56, 0x28, 0xba,
+    0x00, 0x1a, 0xfe, 0x5e, 0x47, 0x2f, 0x21, 0x28, 0xbe, 0x8c, 0x5e, 0x69, 0xa2, 0x19, 0x84, 0xee,
+    0xef, 0x2c, 0x7a, 0x91, 0xed, 0xb8, 0xc8, 0xd6, 0x7d, 0xbd, 0x5a, 0xec, 0x40, 0xe7, 0xda, 0x52,
+    0x36, 0x34, 0xd7, 0x35, 0x26, 0x36, 0x43, 0x59, 0x5b, 0x22, 0x7d, 0x7d, 0x53, 0x4a, 0x2e, 0xa9,
+    0x25, 0x05, 0x97, 0xf7, 0x73, 0x09, 0xec, 0xb9, 0x10, 0x44, 0xeb, 0x1a, 0x20, 0xb0, 0x5b, 0xcb,
+    0x82, 0x40, 0xfa, 0xfa, 0x20, 0x24, 0x97, 0x14, 0x84, 0xe0, 0xf2, 0x7e, 0x20, 0x46, 0x1d, 0x1d,
+    0x59, 0x6a, 0x18, 0xd7, 0xc0, 0x31, 0x6a, 0x09, 0xb3, 0x58, 0x46, 0x63, 0xd7, 0xc7, 0x93, 0x72,
+    0x4b, 0x31, 0x25, 0xdc, 0x26, 0xe2, 0x9a, 0x99, 0xaf, 0x36, 0x6d, 0xaf, 0x53, 0x2c, 0xdb, 0x38,
+    0x0a, 0xaa, 0xa9, 0x74, 0x34, 0x5d, 0x19, 0x13, 0xe6, 0x65, 0x61, 0x99, 0x72, 0x5d, 0x11, 0x12,
+    0x32, 0xbc, 0x07, 0xf6, 0x84, 0x52, 0xf1, 0x15, 0x9e, 0x11, 0x20, 0x9a, 0x9e, 0xce, 0xe3, 0x8b,
+    0xf6, 0xcf, 0x32, 0xc6, 0xf5, 0x13, 0xca, 0xc4, 0xff, 0xe2, 0x13, 0x8c, 0xc2, 0x97, 0x18, 0x75,
+    0x10, 0xa2, 0x97, 0x90, 0x7f, 0x31, 0x34, 0xcf, 0x16, 0x53, 0xde, 0x0a, 0x58, 0x9b, 0xeb, 0x8e,
+    0x93, 0x15, 0x74, 0x07, 0xc7, 0xb6, 0x9c, 0x19, 0xa5, 0x29, 0x49, 0xf2, 0x13, 0xcf, 0x7b, 0x8b,
+    0x49, 0x36, 0x6c, 0x23, 0x70, 0xc6, 0x24, 0xdf, 0xc6, 0xb1, 0x99, 0x92, 0x33, 0x68, 0x4f, 0x41,
+    0x66, 0x22, 0x11, 0x3c, 0x72, 0x21, 0xa4, 0xbe, 0x51, 0x40, 0xda, 0x30, 0x12, 0x79, 0x24, 0xe4,
+    0xd4, 0x87, 0x87, 0xe5, 0xca, 0x6c, 0xd0, 0xef, 0x21, 0x5e, 0xc2, 0xcd, 0x8b, 0x17, 0x70, 0x17,
+    0x15, 0xff, 0x77, 0x79, 0xf0, 0x04, 0x83, 0x5f, 0x45, 0x97, 0xd0, 0x12, 0x44, 0xef, 0x54, 0x9d,
+    0xbd, 0x14, 0xf9, 0x77, 0x28, 0xac, 0x7e, 0x16, 0x5d, 0xce, 0x77, 0xab, 0x80, 0xfd, 0xd9, 0x73,
+    0xf3, 0x9e, 0xa5, 0x86, 0x8a, 0x66, 0x9f, 0x57, 0xec, 0x93, 0x73, 0x5b, 0xfc, 0x94, 0xc0, 0x9f,
+    0xd0, 0x29, 0x7e, 0x1c, 0x0d, 0x8b, 0x31, 0x05, 0x00, 0x86, 0xd1, 0xeb, 0x12, 0xfa, 0x3e, 0xac,
+    0x10, 0x6d, 0x4d, 0x29, 0x6f, 0xc8, 0xe8, 0xd5, 0x9c, 0x4e, 0xca, 0xa7, 0x01, 0xf3, 0x2c, 0x9d,
+    0xba, 0xfd, 0x24, 0x25, 0xbb, 0xfd, 0x86, 0x18, 0x54, 0xba, 0x4f, 0x30, 0x9c, 0x68, 0x2c, 0x6e,
+    0xa0, 0xb9, 0x4e, 0x54, 0xcd, 0x7a, 0x43, 0xc4, 0x03, 0xd6, 0xad, 0xf3, 0xc5, 0x24, 0xca, 0x53,
+    0x7a, 0xb6, 0x35, 0x58, 0x50, 0x6a, 0x7c, 0x42, 0x30, 0x3a, 0xd4, 0x4e, 0x0d, 0x49, 0x92, 0x58,
+    0x16, 0x96, 0xaa, 0xb7, 0x8d, 0xf4, 0x84, 0x20, 0x46, 0xee, 0x8a, 0x81, 0xa2, 0xe0, 0xd9, 0x5b,
+    0xa5, 0xee, 0x41, 0x8a, 0xfb, 0xb2, 0x87, 0xac, 0xc8, 0xd2, 0xcf, 0xc3, 0x19, 0x0a, 0x89, 0x2b,
+    0x95, 0xc3, 0x6c, 0x73, 0x02, 0x03, 0x7b, 0x98, 0xe9, 0x12, 0xd7, 0x85, 0x74, 0x8c, 0xe7, 0x8c,
+    0x09, 0x31, 0xbb, 0x87, 0xef, 0x16, 0x13, 0x90, 0xe9, 0x5a, 0x84, 0x00, 0xa4, 0xe7, 0x0b, 0xd8,
+    0x5f, 0x14, 0xc1, 0x60, 0x0c, 0xc1, 0xfe, 0x82, 0x08, 0xf6, 0x17, 0x45, 0x30, 0x18, 0x43, 0xb0,
+    0xbf, 0x20, 0x82, 0xe8, 0x47, 0xe1, 0x98, 0xe7, 0xd0, 0x33, 0x7d, 0x05, 0x81, 0x34, 0x5b, 0x08,
+    0x5e, 0x5f, 0x66, 0x85, 0x6c, 0x0a, 0x5a, 0x08, 0xa9, 0x8e, 0x84, 0x7c, 0x3c, 0x59, 0x86, 0xf0,
+    0xc3, 0xb7, 0x50, 0x1b, 0x66, 0x4b, 0x08, 0xbc, 0x83, 0x9c, 0x84, 0x07, 0x82, 0x9e, 0x2f, 0x21,
+    0x7b, 0x8d, 0xa3, 0xb2, 0xd1, 0x0d, 0x52, 0x26, 0x35, 0xe8, 0x11, 0xe3, 0x23, 0x08, 0xbf, 0x27,
+    0x90, 0xb8, 0x4e, 0xe2, 0xaf, 0xe7, 0x59, 0xd1, 0x57, 0xb1, 0x95, 0x2a, 0x90, 0x8b, 0xb6, 0xc5,
+    0xf3, 0xd3, 0x1d, 0xda, 0xea, 0x4d, 0xa8, 0xee, 0x39, 0xe9, 0x66, 0x97, 0x9a, 0x0f, 0x5b, 0xde,
+    0xa1, 0x94, 0x6f, 0xe1, 0x0a, 0x48, 0x30, 0xe2, 0x16, 0x5b, 0x29, 0x20, 0xc6, 0x3e, 0x95, 0x43,
+    0x75, 0x12, 0xfd, 0x00, 0x5b, 0x85, 0x69, 0x4e, 0x24, 0xae, 0xf8, 0xb9, 0x68, 0x6e, 0xe5, 0x32,
+    0xc8, 0x7b, 0x57, 0xf0, 0x7b, 0x11, 0xff, 0x2d, 0xbd, 0xf9, 0x5c, 0x2c, 0x38, 0xff, 0x13, 0x3f,
+    0x89, 0xbf, 0x01, 0xbe, 0x97, 0x90, 0x15, 0x9f, 0x8f, 0x6a, 0x2a, 0xb6, 0xd8, 0xcf, 0xc4, 0x37,
+    0x80, 0x71, 0x00, 0xb3, 0x0e, 0xee, 0x3d, 0x96, 0x3b, 0xb6, 0xf7, 0xd8, 0x9c, 0x43, 0x7b, 0x46,
+    0xb1, 0xdc, 0xa9, 0x20, 0xec, 0xb5, 0x1c, 0xc6, 0xc5, 0x05, 0xea, 0x55, 0xfc, 0xa5, 0xc0, 0x7b,
+    0x29, 0x3f, 0x2b, 0x64, 0xbb, 0x78, 0x3c, 0x86, 0x66, 0xaf, 0x97, 0x46, 0x47, 0xfd, 0xe4, 0x7a,
+    0xa9, 0xbb, 0x82, 0x1c, 0x2e, 0x94, 0x41, 0xd0, 0x56, 0xf8, 0x0d, 0x21, 0xb9, 0x92, 0x11, 0x5f,
+    0x38, 0x56, 0x52, 0x0f, 0xfa, 0x1e, 0x4f, 0x0c, 0xf1, 0x53, 0x48, 0xd1, 0xb9, 0x69, 0x33, 0xae,
+    0x13, 0x5c, 0x7a, 0xa0, 0xa7, 0x23, 0x01, 0x7d, 0xd4, 0x63, 0x01, 0xb5, 0xa6, 0x9d, 0x75, 0x12,
+    0x54, 0xdf, 0x81, 0x91, 0xa7, 0x69, 0x35, 0x01, 0xe0, 0x94, 0xeb, 0x37, 0x8f, 0x1b, 0xea, 0xe6,
+    0x6d, 0x7b, 0xe7, 0xb6, 0xba, 0x6a, 0xcb, 0xdc, 0x44, 0xc3, 0xeb, 0xf4, 0x22, 0xfa, 0x87, 0xe8,
+    0x85, 0x28, 0xd5, 0xa7, 0x89, 0x44, 0x51, 0x2b, 0xff, 0x0a, 0x51, 0x72, 0x1a, 0xbd, 0x8d, 0x4f,
+    0xf2, 0x5f, 0x06, 0x92, 0xf5, 0x8e, 0x67, 0x19, 0xb6, 0x36, 0x6a, 0xcc, 0x25, 0x95, 0xb5, 0x38,
+    0xce, 0x11, 0xc6, 0x26, 0xd4, 0x35, 0x25, 0x48, 0xa7, 0x67, 0x73, 0xe6, 0x1b, 0x01, 0x17, 0xda,
+    0xeb, 0x96, 0x01, 0x5a, 0x12, 0x43, 0x68, 0x5d, 0xd3, 0x4a, 0xea, 0xa6, 0x9f, 0x38, 0x94, 0x77,
+    0x3d, 0x60, 0xd0, 0xd8, 0x6e, 0xee, 0xa8, 0x9d, 0x02, 0x10, 0x64, 0x57, 0xbc, 0x56, 0xbb, 0x92,
+    0x35, 0x7b, 0x9b, 0xa5, 0x21, 0xd1, 0x66, 0x81, 0x73, 0x60, 0x04, 0x14, 0xd9, 0x9a, 0xd4, 0xe7,
+    0x35, 0x6d, 0x19, 0x4d, 0x91, 0x9a, 0x3f, 0x77, 0x9a, 0x10, 0x4a, 0xeb, 0x52, 0x81, 0xec, 0xd7,
+    0x91, 0xb1, 0x2d, 0xf9, 0x07, 0xb8, 0xd8, 0x4f, 0x98, 0x27, 0x60, 0x6b, 0xc6, 0x1d, 0x6d, 0xea,
+    0x81, 0x15, 0xe1, 0x43, 0x82, 0x30, 0xf1, 0x92, 0x5e, 0x84, 0xa6, 0xdc, 0xd4, 0x61, 0xf1, 0xa8,
+    0x99, 0x6c, 0xa5, 0x22, 0xd3, 0x1d, 0x2d, 0xa9, 0xef, 0x5f, 0xa5, 0xd1, 0xf7, 0x1d, 0xf1, 0xf1,
+    0xf2, 0xff, 0x3a, 0x7f, 0xed, 0xa2, 0xcc, 0x1c, 0x00, 0x00,
+};
+
+static const WebAsset kWebAssets[] = {
+    {"/style.css", "text/css", "\"18406c6f32d14c18\"", kStyleCss, sizeof(kStyleCss), true},
+    {"/script.js", "application/javascript; charset=utf-8", "\"0daaef1b317928c8\"", kScriptJs, sizeof(kScriptJs), true},
+    {"/index.html", "text/html; charset=utf-8", "\"74819125eb54d320\"", kIndexHtml, sizeof(kIndexHtml), false},
+};
+
+#endif // WEB_ASSETS_H
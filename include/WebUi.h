@@ -0,0 +1,17 @@
+#ifndef WEB_UI_H
+#define WEB_UI_H
+#include <ESPAsyncWebServer.h>
+
+// The web UI, compiled into flash from web/ by tools/embed_web.py.
+//
+// Every asset is sent gzipped straight from its array, with a strong ETag
+// taken from the compressed bytes; a request that already holds the
+// current version gets 304 without a body.  index.html is revalidated on
+// every load, so a firmware update shows its own UI at once, while the
+// stylesheet and the script carry their ETag in the URL and are cached
+// for a year.
+
+// Register ``/`` and one route per asset.
+void webUiBegin(AsyncWebServer &server);
+
+#endif // WEB_UI_H
@@ -0,0 +1,25 @@
+#ifndef NATIVE_ADAFRUIT_AHTX0_H
+#define NATIVE_ADAFRUIT_AHTX0_H
+#include "Adafruit_Sensor.h"
+#include "Wire.h"
+
+// AHT21 stand-in.  Every getEvent() is one measurement on the bus, which the
+// host can observe through hostMeasurements().
+class Adafruit_AHTX0 {
+public:
+    bool begin(TwoWire *wire = &Wire, int32_t sensorId = 0, uint8_t address = 0x38) {
+        (void)wire; (void)sensorId; (void)address;
+        return true;
+    }
+    bool getEvent(sensors_event_t *humidity, sensors_event_t *temp);
+
+    void hostSet(float t, float rh) { temperature = t; humidity = rh; }
+    uint32_t hostMeasurements() const { return measurements; }
+
+private:
+    float temperature = 21.5f;
+    float humidity = 45.0f;
+    uint32_t measurements = 0;
+};
+
+#endif // NATIVE_ADAFRUIT_AHTX0_H
@@ -0,0 +1,18 @@
+#ifndef NATIVE_ADAFRUIT_SENSOR_H
+#define NATIVE_ADAFRUIT_SENSOR_H
+#include <stdint.h>
+
+typedef struct {
+    int32_t version;
+    int32_t sensor_id;
+    int32_t type;
+    int32_t reserved0;
+    int32_t timestamp;
+    union {
+        float data[4];
+        float temperature;
+        float relative_humidity;
+    };
+} sensors_event_t;
+
+#endif // NATIVE_ADAFRUIT_SENSOR_H
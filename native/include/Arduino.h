@@ -0,0 +1,68 @@
+#ifndef NATIVE_ARDUINO_H
+#define NATIVE_ARDUINO_H
+
+// Host stand-in for the subset of the Arduino-ESP32 core used by the
+// firmware.  Only compiled by the ``native`` PlatformIO environment.
+#include <math.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <algorithm>
+#include "WString.h"
+#include "Print.h"
+#include "Stream.h"
+#include "HardwareSerial.h"
+#include "Esp.h"
+#include "esp_system.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define HIGH 0x1
+#define LOW 0x0
+#define INPUT 0x01
+#define OUTPUT 0x03
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+// newlib provides these; glibc only gained them in 2.38.
+#if defined(__GLIBC__) && (__GLIBC__ < 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ < 38))
+size_t strlcpy(char *dst, const char *src, size_t size);
+size_t strlcat(char *dst, const char *src, size_t size);
+#endif
+
+using std::min;
+using std::max;
+
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+uint16_t analogRead(uint8_t pin);
+// ESP32-S3 mapping: GPIO1..10 are ADC1 channels 0..9, GPIO11..20 are ADC2
+// channels 0..9 (returned as 10..19), anything else -1.
+int8_t digitalPinToAnalogChannel(uint8_t pin);
+
+// esp32-hal-time: start SNTP with the given offsets.
+void configTime(long gmtOffset_sec, int daylightOffset_sec, const char *server1,
+                const char *server2 = nullptr, const char *server3 = nullptr);
+
+// Host-only hooks.  ``nativeAdvanceMillis`` shifts the clock returned by
+// millis()/micros() so that code with minute-long periods can be driven
+// without sleeping.
+void nativeAdvanceMillis(uint32_t ms);
+void nativeSetAnalog(uint8_t pin, uint16_t value);
+
+#endif // NATIVE_ARDUINO_H
@@ -0,0 +1,20 @@
+#ifndef NATIVE_ESP32SERVO_H
+#define NATIVE_ESP32SERVO_H
+#include <stdint.h>
+
+// Servo stand-in: remembers the last commanded angle and counts writes.
+class Servo {
+public:
+    int attach(int pin) { attachedPin = pin; return 1; }
+    void detach() { attachedPin = -1; }
+    void write(int value) { angle = value; writes++; }
+    int read() const { return angle; }
+    bool attached() const { return attachedPin >= 0; }
+    uint32_t hostWrites() const { return writes; }
+private:
+    int attachedPin = -1;
+    int angle = 90;
+    uint32_t writes = 0;
+};
+
+#endif // NATIVE_ESP32SERVO_H
@@ -0,0 +1,279 @@
+#ifndef NATIVE_ESPASYNCWEBSERVER_H
+#define NATIVE_ESPASYNCWEBSERVER_H
+#include <functional>
+#include <string>
+#include <vector>
+#include "Arduino.h"
+#include "FS.h"
+
+// Host stand-in for ESPAsyncWebServer.  Routes are kept in a table and can
+// be driven from the host with AsyncWebServer::hostDispatch(); responses
+// are captured in memory instead of being written to a socket.
+
+typedef enum {
+    HTTP_GET = 0b00000001,
+    HTTP_POST = 0b00000010,
+    HTTP_DELETE = 0b00000100,
+    HTTP_PUT = 0b00001000,
+    HTTP_PATCH = 0b00010000,
+    HTTP_HEAD = 0b00100000,
+    HTTP_OPTIONS = 0b01000000,
+    HTTP_ANY = 0b01111111,
+} WebRequestMethod;
+typedef uint8_t WebRequestMethodComposite;
+
+class AsyncWebServerRequest;
+class AsyncWebServerResponse;
+class AsyncWebSocket;
+class AsyncWebSocketClient;
+
+typedef std::function<void(AsyncWebServerRequest*)> ArRequestHandlerFunction;
+typedef std::function<void(AsyncWebServerRequest*, const String &filename, size_t index,
+                           uint8_t *data, size_t len, bool final)> ArUploadHandlerFunction;
+typedef std::function<void(AsyncWebServerRequest*, uint8_t *data, size_t len,
+                           size_t index, size_t total)> ArBodyHandlerFunction;
+typedef std::function<size_t(uint8_t *buffer, size_t maxLen, size_t index)> AwsResponseFiller;
+typedef std::function<String(const String&)> AwsTemplateProcessor;
+
+class AsyncWebParameter {
+public:
+    AsyncWebParameter(const String &n, const String &v) : _name(n), _value(v) {}
+    const String &name() const { return _name; }
+    const String &value() const { return _value; }
+private:
+    String _name;
+    String _value;
+};
+
+class AsyncWebHeader {
+public:
+    AsyncWebHeader(const String &n, const String &v) : _name(n), _value(v) {}
+    const String &name() const { return _name; }
+    const String &value() const { return _value; }
+private:
+    String _name;
+    String _value;
+};
+
+class AsyncWebServerResponse {
+public:
+    AsyncWebServerResponse(int code, const String &contentType)
+        : _code(code), _contentType(contentType) {}
+    virtual ~AsyncWebServerResponse() {}
+    void setCode(int code) { _code = code; }
+    void setContentLength(size_t len) { (void)len; }
+    void setContentType(const String &type) { _contentType = type; }
+    void addHeader(const String &name, const String &value) {
+        _headers.push_back(AsyncWebHeader(name, value));
+    }
+    // Called by AsyncWebServerRequest::send() to materialise the body.
+    virtual void hostRender() {}
+
+    int hostCode() const { return _code; }
+    const String &hostContentType() const { return _contentType; }
+    const std::string &hostBody() const { return _body; }
+    const String *hostHeader(const char *name) const;
+
+protected:
+    int _code;
+    String _contentType;
+    std::vector<AsyncWebHeader> _headers;
+    std::string _body;
+};
+
+class AsyncResponseStream : public AsyncWebServerResponse, public Print {
+public:
+    explicit AsyncResponseStream(const String &contentType)
+        : AsyncWebServerResponse(200, contentType) {}
+    size_t write(uint8_t c) override { _body.push_back((char)c); return 1; }
+    size_t write(const uint8_t *data, size_t len) override {
+        _body.append((const char*)data, len);
+        return len;
+    }
+    using Print::write;
+};
+
+class AsyncChunkedResponse : public AsyncWebServerResponse {
+public:
+    AsyncChunkedResponse(const String &contentType, AwsResponseFiller filler)
+        : AsyncWebServerResponse(200, contentType), _filler(filler) {}
+    void hostRender() override;
+private:
+    AwsResponseFiller _filler;
+};
+
+class AsyncWebServerRequest {
+public:
+    AsyncWebServerRequest(WebRequestMethodComposite method, const String &url)
+        : _method(method), _url(url) {}
+    ~AsyncWebServerRequest();
+
+    WebRequestMethodComposite method() const { return _method; }
+    const String &url() const { return _url; }
+    size_t contentLength() const { return _contentLength; }
+
+    bool hasHeader(const String &name) const;
+    const String &header(const char *name) const;
+    AsyncWebHeader *getHeader(const String &name);
+    bool hasParam(const String &name, bool post = false, bool file = false) const;
+    AsyncWebParameter *getParam(const String &name, bool post = false, bool file = false);
+    const String &arg(const String &name) const;
+    bool hasArg(const char *name) const;
+
+    void requestAuthentication(const char *realm = nullptr, bool isDigest = false);
+    void send(AsyncWebServerResponse *response);
+    void send(int code, const String &contentType = String(), const String &content = String());
+    AsyncWebServerResponse *beginResponse(int code, const String &contentType = String(),
+                                          const String &content = String());
+    AsyncWebServerResponse *beginResponse_P(int code, const String &contentType,
+                                            const uint8_t *content, size_t len,
+                                            AwsTemplateProcessor callback = nullptr);
+    AsyncResponseStream *beginResponseStream(const String &contentType, size_t bufferSize = 1460);
+    AsyncWebServerResponse *beginChunkedResponse(const String &contentType,
+                                                 AwsResponseFiller callback,
+                                                 AwsTemplateProcessor templateCallback = nullptr);
+    void onDisconnect(std::function<void()> fn) { _onDisconnect = fn; }
+
+    void hostSetHeader(const char *name, const char *value);
+    void hostSetParam(const char *name, const char *value);
+    void hostSetContentLength(size_t len) { _contentLength = len; }
+    AsyncWebServerResponse *hostResponse() const { return _response; }
+
+private:
+    WebRequestMethodComposite _method;
+    String _url;
+    size_t _contentLength = 0;
+    std::vector<AsyncWebHeader> _headers;
+    std::vector<AsyncWebParameter> _params;
+    AsyncWebServerResponse *_response = nullptr;
+    std::function<void()> _onDisconnect;
+};
+
+class AsyncWebHandler {
+public:
+    virtual ~AsyncWebHandler() {}
+};
+
+class AsyncCallbackWebHandler : public AsyncWebHandler {
+public:
+    String uri;
+    WebRequestMethodComposite method;
+    ArRequestHandlerFunction onRequest;
+    ArUploadHandlerFunction onUpload;
+    ArBodyHandlerFunction onBody;
+};
+
+typedef enum {
+    WS_EVT_CONNECT,
+    WS_EVT_DISCONNECT,
+    WS_EVT_PONG,
+    WS_EVT_ERROR,
+    WS_EVT_DATA
+} AwsEventType;
+
+typedef enum { WS_DISCONNECTED, WS_CONNECTED, WS_DISCONNECTING } AwsClientStatus;
+
+typedef enum { WS_CONTINUATION, WS_TEXT, WS_BINARY, WS_DISCONNECT = 0x08, WS_PING, WS_PONG } AwsFrameType;
+
+typedef struct {
+    uint8_t message_opcode;
+    uint32_t num;
+    uint8_t final;
+    uint8_t masked;
+    uint8_t opcode;
+    uint64_t len;
+    uint8_t mask[4];
+    uint64_t index;
+} AwsFrameInfo;
+
+typedef std::function<void(AsyncWebSocket *server, AsyncWebSocketClient *client,
+                           AwsEventType type, void *arg, uint8_t *data, size_t len)> AwsEventHandler;
+
+// A connected client.  The host can mark it as slow by shrinking its queue.
+class AsyncWebSocketClient {
+public:
+    AsyncWebSocketClient(AsyncWebSocket *server, uint32_t id) : _server(server), _id(id) {}
+    uint32_t id() const { return _id; }
+    AwsClientStatus status() const { return _status; }
+    AsyncWebSocket *server() { return _server; }
+    bool queueIsFull() const { return _queued >= _queueLimit; }
+    bool canSend() const { return !queueIsFull(); }
+    void text(const char *message, size_t len);
+    void text(const char *message) { text(message, strlen(message)); }
+    void text(const String &message) { text(message.c_str(), message.length()); }
+    void binary(const uint8_t *message, size_t len);
+    void close() { _status = WS_DISCONNECTED; }
+
+    void hostSetQueueLimit(size_t n) { _queueLimit = n; }
+    void hostDrain() { _queued = 0; }
+    const std::vector<std::string> &hostMessages() const { return _messages; }
+    void hostClearMessages() { _messages.clear(); }
+
+private:
+    AsyncWebSocket *_server;
+    uint32_t _id;
+    AwsClientStatus _status = WS_CONNECTED;
+    size_t _queued = 0;
+    size_t _queueLimit = 8;
+    std::vector<std::string> _messages;
+};
+
+class AsyncWebSocket : public AsyncWebHandler {
+public:
+    explicit AsyncWebSocket(const String &url) : _url(url) {}
+    ~AsyncWebSocket();
+    void onEvent(AwsEventHandler handler) { _handler = handler; }
+    size_t count() const;
+    AsyncWebSocketClient *client(uint32_t id);
+    bool availableForWriteAll();
+    void textAll(const char *message, size_t len);
+    void textAll(const char *message) { textAll(message, strlen(message)); }
+    void textAll(const String &message) { textAll(message.c_str(), message.length()); }
+    void binaryAll(const uint8_t *message, size_t len);
+    void cleanupClients(uint16_t maxClients = 8);
+    std::vector<AsyncWebSocketClient*> &getClients() { return _clients; }
+
+    AsyncWebSocketClient *hostConnect();
+    void hostDisconnect(AsyncWebSocketClient *c);
+    void hostReceive(AsyncWebSocketClient *c, const char *text);
+
+private:
+    String _url;
+    AwsEventHandler _handler;
+    std::vector<AsyncWebSocketClient*> _clients;
+    uint32_t _nextId = 1;
+};
+
+class AsyncWebServer {
+public:
+    explicit AsyncWebServer(uint16_t port) : _port(port) {}
+    ~AsyncWebServer();
+    void begin() {}
+    void end() {}
+    AsyncCallbackWebHandler &on(const char *uri, WebRequestMethodComposite method,
+                                ArRequestHandlerFunction onRequest);
+    AsyncCallbackWebHandler &on(const char *uri, WebRequestMethodComposite method,
+                                ArRequestHandlerFunction onRequest,
+                                ArUploadHandlerFunction onUpload,
+                                ArBodyHandlerFunction onBody = nullptr);
+    AsyncWebHandler &addHandler(AsyncWebHandler *handler) { return *handler; }
+    void onNotFound(ArRequestHandlerFunction fn) { _notFound = fn; }
+
+    // Run the handler registered for ``req``.  ``body`` is delivered to the
+    // body handler in one chunk before the request handler runs, like the
+    // library does for small POSTs.  Returns false when no route matches.
+    bool hostDispatch(AsyncWebServerRequest *req, const uint8_t *body = nullptr,
+                      size_t bodyLen = 0);
+    // Deliver ``data`` to the upload handler of ``uri`` in ``chunk``-sized
+    // pieces and then run the request handler.
+    bool hostUpload(AsyncWebServerRequest *req, const uint8_t *data, size_t len,
+                    size_t chunk = 1436);
+
+private:
+    AsyncCallbackWebHandler *find(AsyncWebServerRequest *req);
+    uint16_t _port;
+    std::vector<AsyncCallbackWebHandler*> _handlers;
+    ArRequestHandlerFunction _notFound;
+};
+
+#endif // NATIVE_ESPASYNCWEBSERVER_H
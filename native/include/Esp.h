@@ -0,0 +1,17 @@
+#ifndef NATIVE_ESP_H
+#define NATIVE_ESP_H
+#include <stdint.h>
+
+class EspClass {
+public:
+    uint32_t getFreeHeap() { return 256 * 1024; }
+    uint32_t getMinFreeHeap() { return 200 * 1024; }
+    uint32_t getMaxAllocHeap() { return 128 * 1024; }
+    uint32_t getHeapSize() { return 320 * 1024; }
+    uint64_t getEfuseMac() { return 0x0000A1B2C3D4E5F6ULL; }
+    [[noreturn]] void restart();
+};
+
+extern EspClass ESP;
+
+#endif // NATIVE_ESP_H
@@ -0,0 +1,57 @@
+#ifndef NATIVE_HARDWARESERIAL_H
+#define NATIVE_HARDWARESERIAL_H
+#include <deque>
+#include <functional>
+#include <mutex>
+#include "Stream.h"
+
+#define SERIAL_8N1 0x800001c
+
+// UART stand-in.  ``Serial`` writes to stdout; the receive side of every
+// port is a FIFO the host fills with ``hostFeed`` to replay recorded traffic.
+// A callback registered with onReceive() runs synchronously inside
+// hostFeed, standing in for the UART driver's event task.
+class HardwareSerial : public Stream {
+public:
+    typedef std::function<void(void)> OnReceiveCb;
+
+    explicit HardwareSerial(int uart) : uartNum(uart) {}
+
+    void begin(unsigned long baud, uint32_t config = SERIAL_8N1,
+               int8_t rxPin = -1, int8_t txPin = -1) {
+        (void)baud; (void)config; (void)rxPin; (void)txPin;
+    }
+    void end() {}
+    size_t setRxBufferSize(size_t size) { return size; }
+    bool setRxTimeout(uint8_t symbols) { (void)symbols; return true; }
+    void onReceive(OnReceiveCb cb, bool onlyOnTimeout = false) {
+        (void)onlyOnTimeout;
+        rxCb = cb;
+    }
+
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *buffer, size_t size) override;
+    using Print::write;
+
+    void hostFeed(const uint8_t *data, size_t len);
+    void hostFeed(const char *text);
+    void hostClear();
+    // Bytes written by the firmware to the TX side since the last clear.
+    size_t hostTxCount() const { return txCount; }
+
+private:
+    int uartNum;
+    std::deque<uint8_t> rx;
+    std::mutex m;
+    size_t txCount = 0;
+    OnReceiveCb rxCb;
+};
+
+extern HardwareSerial Serial;
+extern HardwareSerial Serial1;
+extern HardwareSerial Serial2;
+
+#endif // NATIVE_HARDWARESERIAL_H
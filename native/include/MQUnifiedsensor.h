@@ -0,0 +1,51 @@
+#ifndef NATIVE_MQUNIFIEDSENSOR_H
+#define NATIVE_MQUNIFIEDSENSOR_H
+#include <math.h>
+#include "Arduino.h"
+
+// MQUnifiedsensor stand-in implementing the same exponential regression
+// (ppm = a * ratio^b) on a voltage taken from analogRead() or supplied
+// through externalADCUpdate().
+class MQUnifiedsensor {
+public:
+    MQUnifiedsensor(const char *board, float voltRes, int adcBits, int pin, const char *type)
+        : voltResolution(voltRes), adcBitResolution(adcBits), pin(pin) {
+        (void)board; (void)type;
+    }
+    void init() {}
+    void setRegressionMethod(int method) { regression = method; }
+    void setA(float v) { a = v; }
+    void setB(float v) { b = v; }
+    void setRL(float v) { rl = v; }
+    void setR0(float v) { r0 = v; }
+    float getR0() const { return r0; }
+    void update() { sensorVolt = analogRead(pin) * voltResolution / ((1 << adcBitResolution) - 1); updates++; }
+    void externalADCUpdate(float volt) { sensorVolt = volt; }
+    float readSensor() const {
+        if(sensorVolt <= 0 || r0 <= 0) return 0;
+        float rs = ((voltResolution * rl) / sensorVolt) - rl;
+        if(rs < 0) rs = 0;
+        float ratio = rs / r0;
+        return regression == 1 ? a * powf(ratio, b) : powf(10, (log10f(ratio) - b) / a);
+    }
+    float calibrate(float ratioInCleanAir) {
+        if(sensorVolt <= 0) return r0;
+        float rs = ((voltResolution * rl) / sensorVolt) - rl;
+        return rs / ratioInCleanAir;
+    }
+    float getVoltage(bool read = true) { if(read) update(); return sensorVolt; }
+    void serialDebug(bool = false) {}
+
+    uint32_t hostUpdates() const { return updates; }
+
+private:
+    float voltResolution;
+    int adcBitResolution;
+    int pin;
+    int regression = 1;
+    float a = 1, b = 1, rl = 10, r0 = 10;
+    float sensorVolt = 0.5f;
+    uint32_t updates = 0;
+};
+
+#endif // NATIVE_MQUNIFIEDSENSOR_H
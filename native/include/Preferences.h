@@ -0,0 +1,53 @@
+#ifndef NATIVE_PREFERENCES_H
+#define NATIVE_PREFERENCES_H
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "WString.h"
+
+// NVS stand-in.  Namespaces live in process memory, so values survive
+// end()/begin() cycles within one run like they survive reboots on the
+// device.  ``hostWrites`` counts put*() calls that changed stored bytes.
+class Preferences {
+public:
+    bool begin(const char *name, bool readOnly = false, const char *partition = nullptr);
+    void end();
+    bool clear();
+    bool remove(const char *key);
+    bool isKey(const char *key);
+
+    size_t putBool(const char *key, bool value);
+    size_t putUChar(const char *key, uint8_t value);
+    size_t putUShort(const char *key, uint16_t value);
+    size_t putInt(const char *key, int32_t value);
+    size_t putUInt(const char *key, uint32_t value);
+    size_t putULong(const char *key, uint32_t value);
+    size_t putFloat(const char *key, float value);
+    size_t putString(const char *key, const char *value);
+    size_t putString(const char *key, const String &value) { return putString(key, value.c_str()); }
+    size_t putBytes(const char *key, const void *value, size_t len);
+
+    bool getBool(const char *key, bool defaultValue = false);
+    uint8_t getUChar(const char *key, uint8_t defaultValue = 0);
+    uint16_t getUShort(const char *key, uint16_t defaultValue = 0);
+    int32_t getInt(const char *key, int32_t defaultValue = 0);
+    uint32_t getUInt(const char *key, uint32_t defaultValue = 0);
+    uint32_t getULong(const char *key, uint32_t defaultValue = 0);
+    float getFloat(const char *key, float defaultValue = NAN);
+    size_t getString(const char *key, char *value, size_t maxLen);
+    String getString(const char *key, const String &defaultValue = String());
+    size_t getBytesLength(const char *key);
+    size_t getBytes(const char *key, void *buf, size_t maxLen);
+
+    static uint32_t hostWrites();
+    static void hostReset();
+
+private:
+    size_t put(const char *key, const void *value, size_t len);
+    bool get(const char *key, void *value, size_t len);
+    char ns[16] = "";
+    bool opened = false;
+    bool readOnly = false;
+};
+
+#endif // NATIVE_PREFERENCES_H
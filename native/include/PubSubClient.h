@@ -0,0 +1,69 @@
+#ifndef NATIVE_PUBSUBCLIENT_H
+#define NATIVE_PUBSUBCLIENT_H
+#include <functional>
+#include "Arduino.h"
+#include "WiFi.h"
+
+#define MQTT_CONNECTED 0
+#define MQTT_DISCONNECTED -1
+#define MQTT_CONNECT_FAILED -2
+
+// Mirrors the public API of knolleary/PubSubClient 2.8.  Nothing goes on
+// the wire: publishes are counted and optionally handed to a host hook that
+// can fail them or add latency to model a slow broker.
+class PubSubClient {
+public:
+    typedef std::function<void(char*, uint8_t*, unsigned int)> Callback;
+    typedef std::function<bool(const char *topic, const uint8_t *payload, unsigned int len)> PublishHook;
+
+    PubSubClient() {}
+    explicit PubSubClient(Client &c) { (void)c; }
+
+    PubSubClient &setServer(const char *domain, uint16_t port);
+    PubSubClient &setCallback(Callback cb) { callback = cb; return *this; }
+    PubSubClient &setClient(Client &c) { (void)c; return *this; }
+    bool setBufferSize(uint16_t size) { bufferSize = size; return true; }
+    uint16_t getBufferSize() const { return bufferSize; }
+    PubSubClient &setKeepAlive(uint16_t s) { keepAlive = s; return *this; }
+    PubSubClient &setSocketTimeout(uint16_t s) { socketTimeout = s; return *this; }
+
+    bool connect(const char *id);
+    bool connect(const char *id, const char *user, const char *pass);
+    bool connect(const char *id, const char *willTopic, uint8_t willQos, bool willRetain,
+                 const char *willMessage);
+    bool connect(const char *id, const char *user, const char *pass, const char *willTopic,
+                 uint8_t willQos, bool willRetain, const char *willMessage,
+                 bool cleanSession = true);
+    void disconnect();
+
+    bool publish(const char *topic, const char *payload);
+    bool publish(const char *topic, const char *payload, bool retained);
+    bool publish(const char *topic, const uint8_t *payload, unsigned int plength);
+    bool publish(const char *topic, const uint8_t *payload, unsigned int plength, bool retained);
+    bool subscribe(const char *topic, uint8_t qos = 0) { (void)topic; (void)qos; return isConnected; }
+    bool loop() { return isConnected; }
+    bool connected() { return isConnected; }
+    int state() { return isConnected ? MQTT_CONNECTED : MQTT_DISCONNECTED; }
+
+    void hostSetConnected(bool c) { isConnected = c; }
+    void hostSetConnectResult(bool ok) { connectResult = ok; }
+    void hostSetPublishHook(PublishHook h) { hook = h; }
+    uint32_t hostPublished() const { return published; }
+    uint64_t hostPublishedBytes() const { return publishedBytes; }
+    uint32_t hostConnects() const { return connects; }
+    void hostResetCounters() { published = 0; publishedBytes = 0; connects = 0; }
+
+private:
+    Callback callback;
+    PublishHook hook;
+    bool isConnected = false;
+    bool connectResult = true;
+    uint16_t bufferSize = 256;
+    uint16_t keepAlive = 15;
+    uint16_t socketTimeout = 15;
+    uint32_t published = 0;
+    uint64_t publishedBytes = 0;
+    uint32_t connects = 0;
+};
+
+#endif // NATIVE_PUBSUBCLIENT_H
@@ -0,0 +1,35 @@
+#ifndef NATIVE_SPARKFUN_ENS160_H
+#define NATIVE_SPARKFUN_ENS160_H
+#include "Wire.h"
+
+#define SFE_ENS160_STANDARD 0x02
+
+// ENS160 stand-in.  New data becomes available once per hostSet() call;
+// checkDataStatus() consumes the flag like the real DATA_STATUS register.
+class SparkFun_ENS160 {
+public:
+    bool begin(TwoWire &wire = Wire, uint8_t address = 0x53) {
+        (void)wire; (void)address;
+        return true;
+    }
+    bool setOperatingMode(uint8_t mode) { (void)mode; return true; }
+    bool checkDataStatus() {
+        reads++;
+        bool ready = dataReady;
+        dataReady = false;
+        return ready;
+    }
+    uint16_t getECO2() { reads++; return eco2; }
+    uint16_t getTVOC() { reads++; return tvoc; }
+
+    void hostSet(uint16_t e, uint16_t t) { eco2 = e; tvoc = t; dataReady = true; }
+    uint32_t hostReads() const { return reads; }
+
+private:
+    uint16_t eco2 = 450;
+    uint16_t tvoc = 20;
+    bool dataReady = false;
+    uint32_t reads = 0;
+};
+
+#endif // NATIVE_SPARKFUN_ENS160_H
@@ -0,0 +1,28 @@
+#ifndef NATIVE_STREAM_H
+#define NATIVE_STREAM_H
+#include "Print.h"
+
+// Arduino ``Stream``.  The host never waits for data: when nothing is
+// available the timed readers return immediately, which keeps benchmarks
+// free of artificial timeouts.
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+
+    void setTimeout(unsigned long timeout) { _timeout = timeout; }
+    unsigned long getTimeout() const { return _timeout; }
+    size_t readBytes(char *buffer, size_t length);
+    size_t readBytes(uint8_t *buffer, size_t length) {
+        return readBytes((char*)buffer, length);
+    }
+    size_t readBytesUntil(char terminator, char *buffer, size_t length);
+    String readString();
+    String readStringUntil(char terminator);
+
+protected:
+    unsigned long _timeout = 1000;
+};
+
+#endif // NATIVE_STREAM_H
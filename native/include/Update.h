@@ -0,0 +1,36 @@
+#ifndef NATIVE_UPDATE_H
+#define NATIVE_UPDATE_H
+#include <vector>
+#include "Arduino.h"
+
+#define UPDATE_SIZE_UNKNOWN 0xFFFFFFFF
+#define U_FLASH 0
+
+// OTA stand-in: the image is collected in memory so the host can check
+// exactly which bytes would have been flashed.
+class UpdateClass {
+public:
+    bool begin(size_t size = UPDATE_SIZE_UNKNOWN, int command = U_FLASH);
+    size_t write(uint8_t *data, size_t len);
+    bool end(bool evenIfRemaining = false);
+    void abort();
+    bool hasError() const { return error != 0; }
+    bool isRunning() const { return running; }
+    uint8_t getError() const { return error; }
+    void printError(Print &out);
+    size_t progress() const { return image.size(); }
+
+    const std::vector<uint8_t> &hostImage() const { return image; }
+    bool hostFinished() const { return finished; }
+
+private:
+    std::vector<uint8_t> image;
+    size_t expected = UPDATE_SIZE_UNKNOWN;
+    uint8_t error = 0;
+    bool running = false;
+    bool finished = false;
+};
+
+extern UpdateClass Update;
+
+#endif // NATIVE_UPDATE_H
@@ -0,0 +1,105 @@
+#ifndef NATIVE_WSTRING_H
+#define NATIVE_WSTRING_H
+#include <stddef.h>
+#include <stdint.h>
+
+// Host stand-in for the Arduino ``String`` class.  Storage is obtained with
+// ``new[]`` so that the benchmark allocation counter sees every heap
+// allocation the firmware would make on the device.
+class String {
+public:
+    String(const char *cstr = "");
+    String(const String &str);
+    String(String &&rval) noexcept;
+    explicit String(char c);
+    explicit String(unsigned char value, unsigned char base = 10);
+    explicit String(int value, unsigned char base = 10);
+    explicit String(unsigned int value, unsigned char base = 10);
+    explicit String(long value, unsigned char base = 10);
+    explicit String(unsigned long value, unsigned char base = 10);
+    explicit String(long long value, unsigned char base = 10);
+    explicit String(unsigned long long value, unsigned char base = 10);
+    explicit String(float value, unsigned int decimalPlaces = 2);
+    explicit String(double value, unsigned int decimalPlaces = 2);
+    ~String();
+
+    String &operator=(const String &rhs);
+    String &operator=(String &&rval) noexcept;
+    String &operator=(const char *cstr);
+
+    bool reserve(unsigned int size);
+    unsigned int length() const { return len; }
+    bool isEmpty() const { return len == 0; }
+    const char *c_str() const { return buffer ? buffer : ""; }
+
+    bool concat(const String &str);
+    bool concat(const char *cstr);
+    bool concat(const char *cstr, unsigned int length);
+    bool concat(char c);
+    bool concat(int num);
+    bool concat(unsigned int num);
+    bool concat(long num);
+    bool concat(unsigned long num);
+    bool concat(float num);
+    bool concat(double num);
+
+    template<typename T>
+    String &operator+=(const T &rhs) { concat(rhs); return *this; }
+
+    int compareTo(const String &s) const;
+    bool equals(const String &s) const;
+    bool equals(const char *cstr) const;
+    bool operator==(const String &rhs) const { return equals(rhs); }
+    bool operator==(const char *cstr) const { return equals(cstr); }
+    bool operator!=(const String &rhs) const { return !equals(rhs); }
+    bool operator!=(const char *cstr) const { return !equals(cstr); }
+    bool operator<(const String &rhs) const { return compareTo(rhs) < 0; }
+    bool startsWith(const String &prefix) const;
+    bool startsWith(const String &prefix, unsigned int offset) const;
+    bool endsWith(const String &suffix) const;
+
+    char charAt(unsigned int index) const;
+    char operator[](unsigned int index) const { return charAt(index); }
+    char &operator[](unsigned int index);
+
+    int indexOf(char ch, unsigned int fromIndex = 0) const;
+    int indexOf(const String &str, unsigned int fromIndex = 0) const;
+    int lastIndexOf(char ch) const;
+    String substring(unsigned int beginIndex) const { return substring(beginIndex, len); }
+    String substring(unsigned int beginIndex, unsigned int endIndex) const;
+
+    void trim();
+    void toLowerCase();
+    void toUpperCase();
+    long toInt() const;
+    float toFloat() const;
+    double toDouble() const;
+
+private:
+    void init();
+    void invalidate();
+    bool changeBuffer(unsigned int maxStrLen);
+    String &copy(const char *cstr, unsigned int length);
+    void move(String &rhs);
+
+    char *buffer = nullptr;
+    unsigned int capacity = 0;
+    unsigned int len = 0;
+};
+
+// Arduino returns ``StringSumHelper`` from ``operator+`` so that chained
+// additions reuse one buffer.  ArduinoJson also refers to this type by name.
+class StringSumHelper : public String {
+public:
+    StringSumHelper(const String &s) : String(s) {}
+    StringSumHelper(const char *p) : String(p) {}
+};
+
+StringSumHelper &operator+(const StringSumHelper &lhs, const String &rhs);
+StringSumHelper &operator+(const StringSumHelper &lhs, const char *cstr);
+StringSumHelper &operator+(const StringSumHelper &lhs, char c);
+StringSumHelper operator+(const String &lhs, const String &rhs);
+StringSumHelper operator+(const String &lhs, const char *cstr);
+StringSumHelper operator+(const char *cstr, const String &rhs);
+
+#endif // NATIVE_WSTRING_H
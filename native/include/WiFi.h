@@ -0,0 +1,81 @@
+#ifndef NATIVE_WIFI_H
+#define NATIVE_WIFI_H
+#include <functional>
+#include "Arduino.h"
+
+typedef enum {
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL = 1,
+    WL_CONNECTED = 3,
+    WL_CONNECT_FAILED = 4,
+    WL_CONNECTION_LOST = 5,
+    WL_DISCONNECTED = 6
+} wl_status_t;
+
+// Subset of the arduino_event_id_t values delivered to WiFi.onEvent().
+typedef enum {
+    ARDUINO_EVENT_WIFI_STA_START = 2,
+    ARDUINO_EVENT_WIFI_STA_CONNECTED = 4,
+    ARDUINO_EVENT_WIFI_STA_DISCONNECTED = 5,
+    ARDUINO_EVENT_WIFI_STA_GOT_IP = 7,
+    ARDUINO_EVENT_WIFI_STA_LOST_IP = 8,
+    ARDUINO_EVENT_MAX = 40
+} arduino_event_id_t;
+
+typedef void (*WiFiEventCb)(arduino_event_id_t event);
+typedef int wifi_event_id_t;
+
+typedef enum { WIFI_OFF = 0, WIFI_STA = 1, WIFI_AP = 2, WIFI_AP_STA = 3 } wifi_mode_t;
+
+class Client : public Stream {
+public:
+    virtual int connect(const char *host, uint16_t port) = 0;
+    virtual void stop() = 0;
+    virtual uint8_t connected() = 0;
+};
+
+class WiFiClient : public Client {
+public:
+    int connect(const char*, uint16_t) override { return 1; }
+    void stop() override {}
+    uint8_t connected() override { return 1; }
+    size_t write(uint8_t) override { return 1; }
+    using Print::write;
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+};
+
+// Station/AP stand-in.  The host decides the link state with hostSetStatus().
+class WiFiClass {
+public:
+    bool mode(wifi_mode_t m) { currentMode = m; return true; }
+    wifi_mode_t getMode() const { return currentMode; }
+    wl_status_t begin(const char *ssid, const char *pass = nullptr);
+    bool softAP(const char *ssid, const char *pass = nullptr);
+    bool disconnect(bool wifiOff = false, bool eraseAp = false);
+    bool reconnect();
+    wl_status_t status() const { return linkStatus; }
+    bool isConnected() const { return linkStatus == WL_CONNECTED; }
+    bool setAutoReconnect(bool) { return true; }
+    int8_t RSSI() const { return -60; }
+    wifi_event_id_t onEvent(WiFiEventCb cb, arduino_event_id_t event = ARDUINO_EVENT_MAX);
+
+    // Change the link state and deliver the matching events, as the Wi-Fi
+    // driver task would.
+    void hostSetStatus(wl_status_t s);
+    uint32_t hostReconnects() const { return reconnects; }
+
+private:
+    struct Handler { WiFiEventCb cb; arduino_event_id_t event; };
+    void fire(arduino_event_id_t event);
+    Handler handlers[8];
+    int handlerCount = 0;
+    uint32_t reconnects = 0;
+    wifi_mode_t currentMode = WIFI_OFF;
+    wl_status_t linkStatus = WL_DISCONNECTED;
+};
+
+extern WiFiClass WiFi;
+
+#endif // NATIVE_WIFI_H
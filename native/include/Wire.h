@@ -0,0 +1,54 @@
+#ifndef NATIVE_WIRE_H
+#define NATIVE_WIRE_H
+#include <functional>
+#include "Stream.h"
+
+// I²C master stand-in.  Each device address can be given a responder that
+// fills the bytes returned by requestFrom(); writes are recorded per
+// transaction so a device model can react to commands.
+class TwoWire : public Stream {
+public:
+    typedef std::function<size_t(uint8_t addr, uint8_t *buf, size_t len)> Responder;
+    typedef std::function<void(uint8_t addr, const uint8_t *buf, size_t len)> Receiver;
+
+    explicit TwoWire(uint8_t bus) : busNum(bus) {}
+
+    bool begin(int sda = -1, int scl = -1, uint32_t frequency = 0) {
+        (void)sda; (void)scl; (void)frequency;
+        return true;
+    }
+    void beginTransmission(uint16_t address);
+    uint8_t endTransmission(bool sendStop = true);
+    uint8_t requestFrom(int address, int quantity, int sendStop = 1);
+
+    size_t write(uint8_t c) override;
+    using Print::write;
+    int available() override { return (int)(rxLen - rxPos); }
+    int read() override { return rxPos < rxLen ? rxBuf[rxPos++] : -1; }
+    int peek() override { return rxPos < rxLen ? rxBuf[rxPos] : -1; }
+
+    void hostSetResponder(uint8_t address, Responder r);
+    void hostSetReceiver(uint8_t address, Receiver r);
+    // Number of requestFrom()/endTransmission() calls and bytes moved.
+    uint32_t hostTransactions() const { return transactions; }
+    uint32_t hostBytes() const { return bytes; }
+    void hostResetCounters() { transactions = 0; bytes = 0; }
+
+private:
+    uint8_t busNum;
+    uint16_t txAddr = 0;
+    uint8_t txBuf[128];
+    size_t txLen = 0;
+    uint8_t rxBuf[128];
+    size_t rxLen = 0;
+    size_t rxPos = 0;
+    uint32_t transactions = 0;
+    uint32_t bytes = 0;
+    Responder responders[128];
+    Receiver receivers[128];
+};
+
+extern TwoWire Wire;
+extern TwoWire Wire1;
+
+#endif // NATIVE_WIRE_H
@@ -0,0 +1,10 @@
+#ifndef NATIVE_ESP_SYSTEM_H
+#define NATIVE_ESP_SYSTEM_H
+#include <stddef.h>
+#include <stdint.h>
+
+// Hardware RNG stand-in backed by a seeded PRNG so host runs are repeatable.
+uint32_t esp_random();
+void esp_fill_random(void *buf, size_t len);
+
+#endif // NATIVE_ESP_SYSTEM_H
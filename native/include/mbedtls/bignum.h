@@ -0,0 +1,20 @@
+#ifndef NATIVE_MBEDTLS_BIGNUM_H
+#define NATIVE_MBEDTLS_BIGNUM_H
+#include <stddef.h>
+#include <stdint.h>
+
+// Fixed 256-bit stand-in for mbedtls_mpi: enough for P-256 keys and
+// signatures, nothing else.
+#define MBEDTLS_ERR_MPI_BAD_INPUT_DATA -0x0004
+#define MBEDTLS_ERR_MPI_BUFFER_TOO_SMALL -0x0008
+
+typedef struct {
+    uint64_t p[4];      // little-endian limbs
+} mbedtls_mpi;
+
+void mbedtls_mpi_init(mbedtls_mpi *X);
+void mbedtls_mpi_free(mbedtls_mpi *X);
+int mbedtls_mpi_read_binary(mbedtls_mpi *X, const unsigned char *buf, size_t buflen);
+int mbedtls_mpi_write_binary(const mbedtls_mpi *X, unsigned char *buf, size_t buflen);
+
+#endif // NATIVE_MBEDTLS_BIGNUM_H
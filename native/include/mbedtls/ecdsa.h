@@ -0,0 +1,12 @@
+#ifndef NATIVE_MBEDTLS_ECDSA_H
+#define NATIVE_MBEDTLS_ECDSA_H
+#include "mbedtls/ecp.h"
+
+// ECDSA over the P-256 stand-in in ecp.h.
+int mbedtls_ecdsa_sign(mbedtls_ecp_group *grp, mbedtls_mpi *r, mbedtls_mpi *s,
+                       const mbedtls_mpi *d, const unsigned char *buf, size_t blen,
+                       int (*f_rng)(void *, unsigned char *, size_t), void *p_rng);
+int mbedtls_ecdsa_verify(mbedtls_ecp_group *grp, const unsigned char *buf, size_t blen,
+                         const mbedtls_ecp_point *Q, const mbedtls_mpi *r, const mbedtls_mpi *s);
+
+#endif // NATIVE_MBEDTLS_ECDSA_H
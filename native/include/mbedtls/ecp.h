@@ -0,0 +1,46 @@
+#ifndef NATIVE_MBEDTLS_ECP_H
+#define NATIVE_MBEDTLS_ECP_H
+#include "mbedtls/bignum.h"
+
+// P-256 only, with the mbedTLS 2.x entry points used on the ESP32.  Not
+// constant-time: for the host build, not for keeping secrets.
+#define MBEDTLS_ERR_ECP_BAD_INPUT_DATA -0x4F80
+#define MBEDTLS_ERR_ECP_BUFFER_TOO_SMALL -0x4F00
+#define MBEDTLS_ERR_ECP_FEATURE_UNAVAILABLE -0x4E80
+#define MBEDTLS_ERR_ECP_VERIFY_FAILED -0x4E00
+#define MBEDTLS_ERR_ECP_RANDOM_FAILED -0x4D00
+#define MBEDTLS_ERR_ECP_INVALID_KEY -0x4C80
+
+#define MBEDTLS_ECP_PF_UNCOMPRESSED 0
+
+typedef enum {
+    MBEDTLS_ECP_DP_NONE = 0,
+    MBEDTLS_ECP_DP_SECP256R1 = 3,
+} mbedtls_ecp_group_id;
+
+// Affine; Z is 1, or 0 for the point at infinity.
+typedef struct {
+    mbedtls_mpi X, Y, Z;
+} mbedtls_ecp_point;
+
+typedef struct {
+    mbedtls_ecp_group_id id;
+    mbedtls_mpi P, B, N;
+    mbedtls_ecp_point G;
+} mbedtls_ecp_group;
+
+void mbedtls_ecp_group_init(mbedtls_ecp_group *grp);
+void mbedtls_ecp_group_free(mbedtls_ecp_group *grp);
+int mbedtls_ecp_group_load(mbedtls_ecp_group *grp, mbedtls_ecp_group_id id);
+void mbedtls_ecp_point_init(mbedtls_ecp_point *pt);
+void mbedtls_ecp_point_free(mbedtls_ecp_point *pt);
+int mbedtls_ecp_point_read_binary(const mbedtls_ecp_group *grp, mbedtls_ecp_point *P,
+                                  const unsigned char *buf, size_t ilen);
+int mbedtls_ecp_point_write_binary(const mbedtls_ecp_group *grp, const mbedtls_ecp_point *P,
+                                   int format, size_t *olen, unsigned char *buf, size_t buflen);
+int mbedtls_ecp_check_pubkey(const mbedtls_ecp_group *grp, const mbedtls_ecp_point *pt);
+int mbedtls_ecp_mul(mbedtls_ecp_group *grp, mbedtls_ecp_point *R, const mbedtls_mpi *m,
+                    const mbedtls_ecp_point *P,
+                    int (*f_rng)(void *, unsigned char *, size_t), void *p_rng);
+
+#endif // NATIVE_MBEDTLS_ECP_H
@@ -0,0 +1,184 @@
+#include "Arduino.h"
+#include "driver/adc.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+static const auto bootTime = std::chrono::steady_clock::now();
+static std::atomic<uint64_t> offsetUs{0};
+static uint16_t analogValues[64];
+
+HardwareSerial Serial(0);
+HardwareSerial Serial1(1);
+HardwareSerial Serial2(2);
+EspClass ESP;
+
+static uint64_t nowUs() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - bootTime).count() + offsetUs.load();
+}
+
+unsigned long millis() { return (unsigned long)(uint32_t)(nowUs() / 1000); }
+unsigned long micros() { return (unsigned long)(uint32_t)nowUs(); }
+void delay(uint32_t ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+void delayMicroseconds(uint32_t us) { std::this_thread::sleep_for(std::chrono::microseconds(us)); }
+void yield() { std::this_thread::yield(); }
+
+void nativeAdvanceMillis(uint32_t ms) { offsetUs += (uint64_t)ms * 1000; }
+
+void pinMode(uint8_t, uint8_t) {}
+void digitalWrite(uint8_t, uint8_t) {}
+int digitalRead(uint8_t) { return LOW; }
+uint16_t analogRead(uint8_t pin) { return pin < 64 ? analogValues[pin] : 0; }
+void nativeSetAnalog(uint8_t pin, uint16_t value) { if(pin < 64) analogValues[pin] = value; }
+
+int8_t digitalPinToAnalogChannel(uint8_t pin) {
+    return pin >= 1 && pin <= 20 ? pin - 1 : -1;
+}
+
+static struct {
+    bool initialised;
+    bool running;
+    uint8_t channel;
+    uint32_t hz;
+} adcDigi;
+
+esp_err_t adc_digi_initialize(const adc_digi_init_config_t *cfg) {
+    if(!cfg || !cfg->adc1_chan_mask || cfg->adc2_chan_mask) return ESP_ERR_INVALID_ARG;
+    adcDigi.initialised = true;
+    return ESP_OK;
+}
+
+esp_err_t adc_digi_controller_configure(const adc_digi_configuration_t *cfg) {
+    if(!adcDigi.initialised) return ESP_ERR_INVALID_STATE;
+    if(!cfg || cfg->pattern_num != 1 || cfg->adc_pattern[0].unit != 0 ||
+       cfg->sample_freq_hz < SOC_ADC_SAMPLE_FREQ_THRES_LOW ||
+       cfg->sample_freq_hz > SOC_ADC_SAMPLE_FREQ_THRES_HIGH)
+        return ESP_ERR_INVALID_ARG;
+    adcDigi.channel = cfg->adc_pattern[0].channel;
+    adcDigi.hz = cfg->sample_freq_hz;
+    return ESP_OK;
+}
+
+esp_err_t adc_digi_start() {
+    if(!adcDigi.hz) return ESP_ERR_INVALID_STATE;
+    adcDigi.running = true;
+    return ESP_OK;
+}
+
+esp_err_t adc_digi_stop() {
+    adcDigi.running = false;
+    return ESP_OK;
+}
+
+esp_err_t adc_digi_deinitialize() {
+    adcDigi = {};
+    return ESP_OK;
+}
+
+// Delivers ``length_max`` bytes of conversions after the time they take.
+esp_err_t adc_digi_read_bytes(uint8_t *buf, uint32_t length_max, uint32_t *out_length, uint32_t) {
+    *out_length = 0;
+    if(!adcDigi.running) return ESP_ERR_INVALID_STATE;
+    uint32_t n = length_max / 4;
+    delayMicroseconds((uint64_t)n * 1000000 / adcDigi.hz);
+    uint32_t word = (analogRead(adcDigi.channel + 1) & 0xFFF) | (uint32_t)adcDigi.channel << 13;
+    for(uint32_t i = 0; i < n; i++)
+        for(int b = 0; b < 4; b++) buf[4 * i + b] = word >> (8 * b);
+    *out_length = n * 4;
+    return ESP_OK;
+}
+
+void configTime(long, int, const char*, const char*, const char*) {}
+
+void EspClass::restart() {
+    fflush(stdout);
+    exit(0);
+}
+
+#if defined(__GLIBC__) && (__GLIBC__ < 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ < 38))
+size_t strlcpy(char *dst, const char *src, size_t size) {
+    size_t len = strlen(src);
+    if(size) {
+        size_t n = len < size - 1 ? len : size - 1;
+        memcpy(dst, src, n);
+        dst[n] = 0;
+    }
+    return len;
+}
+
+size_t strlcat(char *dst, const char *src, size_t size) {
+    size_t used = strnlen(dst, size);
+    if(used == size) return size + strlen(src);
+    return used + strlcpy(dst + used, src, size - used);
+}
+#endif
+
+static uint32_t rngState = 0x9E3779B9u;
+
+uint32_t esp_random() {
+    // xorshift32; good enough for jitter and token keys on the host.
+    uint32_t x = rngState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    rngState = x;
+    return x;
+}
+
+void esp_fill_random(void *buf, size_t len) {
+    uint8_t *p = (uint8_t*)buf;
+    while(len) {
+        uint32_t r = esp_random();
+        size_t n = len < 4 ? len : 4;
+        memcpy(p, &r, n);
+        p += n;
+        len -= n;
+    }
+}
+
+int HardwareSerial::available() {
+    std::lock_guard<std::mutex> lk(m);
+    return (int)rx.size();
+}
+
+int HardwareSerial::read() {
+    std::lock_guard<std::mutex> lk(m);
+    if(rx.empty()) return -1;
+    uint8_t c = rx.front();
+    rx.pop_front();
+    return c;
+}
+
+int HardwareSerial::peek() {
+    std::lock_guard<std::mutex> lk(m);
+    return rx.empty() ? -1 : rx.front();
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size) {
+    txCount += size;
+    if(uartNum == 0) fwrite(buffer, 1, size, stdout);
+    return size;
+}
+
+void HardwareSerial::hostFeed(const uint8_t *data, size_t len) {
+    {
+        std::lock_guard<std::mutex> lk(m);
+        rx.insert(rx.end(), data, data + len);
+    }
+    if(rxCb) rxCb();
+}
+
+void HardwareSerial::hostFeed(const char *text) {
+    hostFeed((const uint8_t*)text, strlen(text));
+}
+
+void HardwareSerial::hostClear() {
+    std::lock_guard<std::mutex> lk(m);
+    rx.clear();
+    txCount = 0;
+}
@@ -0,0 +1,253 @@
+#include "ESPAsyncWebServer.h"
+#include <strings.h>
+
+const String *AsyncWebServerResponse::hostHeader(const char *name) const {
+    for(auto &h : _headers)
+        if(strcasecmp(h.name().c_str(), name) == 0) return &h.value();
+    return nullptr;
+}
+
+void AsyncChunkedResponse::hostRender() {
+    uint8_t buf[1460];
+    size_t index = 0;
+    for(;;) {
+        size_t n = _filler(buf, sizeof(buf), index);
+        if(n == 0 || n == (size_t)-1) break;
+        _body.append((const char*)buf, n);
+        index += n;
+    }
+}
+
+AsyncWebServerRequest::~AsyncWebServerRequest() {
+    if(_onDisconnect) _onDisconnect();
+    delete _response;
+}
+
+bool AsyncWebServerRequest::hasHeader(const String &name) const {
+    for(auto &h : _headers)
+        if(strcasecmp(h.name().c_str(), name.c_str()) == 0) return true;
+    return false;
+}
+
+const String &AsyncWebServerRequest::header(const char *name) const {
+    static const String empty;
+    for(auto &h : _headers)
+        if(strcasecmp(h.name().c_str(), name) == 0) return h.value();
+    return empty;
+}
+
+AsyncWebHeader *AsyncWebServerRequest::getHeader(const String &name) {
+    for(auto &h : _headers)
+        if(strcasecmp(h.name().c_str(), name.c_str()) == 0) return &h;
+    return nullptr;
+}
+
+bool AsyncWebServerRequest::hasParam(const String &name, bool, bool) const {
+    for(auto &p : _params)
+        if(p.name() == name) return true;
+    return false;
+}
+
+AsyncWebParameter *AsyncWebServerRequest::getParam(const String &name, bool, bool) {
+    for(auto &p : _params)
+        if(p.name() == name) return &p;
+    return nullptr;
+}
+
+const String &AsyncWebServerRequest::arg(const String &name) const {
+    static const String empty;
+    for(auto &p : _params)
+        if(p.name() == name) return p.value();
+    return empty;
+}
+
+bool AsyncWebServerRequest::hasArg(const char *name) const {
+    return hasParam(name);
+}
+
+void AsyncWebServerRequest::requestAuthentication(const char*, bool) {
+    AsyncWebServerResponse *r = beginResponse(401);
+    r->addHeader("WWW-Authenticate", "Basic realm=\"Login Required\"");
+    send(r);
+}
+
+void AsyncWebServerRequest::send(AsyncWebServerResponse *response) {
+    if(_response && _response != response) delete _response;
+    _response = response;
+    if(_response) _response->hostRender();
+}
+
+void AsyncWebServerRequest::send(int code, const String &contentType, const String &content) {
+    send(beginResponse(code, contentType, content));
+}
+
+namespace {
+class BasicResponse : public AsyncWebServerResponse {
+public:
+    BasicResponse(int code, const String &type, const uint8_t *data, size_t len)
+        : AsyncWebServerResponse(code, type) {
+        if(data) _body.assign((const char*)data, len);
+    }
+};
+}
+
+AsyncWebServerResponse *AsyncWebServerRequest::beginResponse(int code, const String &contentType,
+                                                             const String &content) {
+    return new BasicResponse(code, contentType, (const uint8_t*)content.c_str(), content.length());
+}
+
+AsyncWebServerResponse *AsyncWebServerRequest::beginResponse_P(int code, const String &contentType,
+                                                               const uint8_t *content, size_t len,
+                                                               AwsTemplateProcessor) {
+    return new BasicResponse(code, contentType, content, len);
+}
+
+AsyncResponseStream *AsyncWebServerRequest::beginResponseStream(const String &contentType, size_t) {
+    return new AsyncResponseStream(contentType);
+}
+
+AsyncWebServerResponse *AsyncWebServerRequest::beginChunkedResponse(const String &contentType,
+                                                                    AwsResponseFiller callback,
+                                                                    AwsTemplateProcessor) {
+    return new AsyncChunkedResponse(contentType, callback);
+}
+
+void AsyncWebServerRequest::hostSetHeader(const char *name, const char *value) {
+    for(auto &h : _headers) {
+        if(strcasecmp(h.name().c_str(), name) == 0) { h = AsyncWebHeader(name, value); return; }
+    }
+    _headers.push_back(AsyncWebHeader(name, value));
+}
+
+void AsyncWebServerRequest::hostSetParam(const char *name, const char *value) {
+    _params.push_back(AsyncWebParameter(name, value));
+}
+
+void AsyncWebSocketClient::text(const char *message, size_t len) {
+    if(_status != WS_CONNECTED) return;
+    _messages.push_back(std::string(message, len));
+    _queued++;
+}
+
+void AsyncWebSocketClient::binary(const uint8_t *message, size_t len) {
+    text((const char*)message, len);
+}
+
+AsyncWebSocket::~AsyncWebSocket() {
+    for(auto c : _clients) delete c;
+}
+
+size_t AsyncWebSocket::count() const {
+    size_t n = 0;
+    for(auto c : _clients)
+        if(c->status() == WS_CONNECTED) n++;
+    return n;
+}
+
+AsyncWebSocketClient *AsyncWebSocket::client(uint32_t id) {
+    for(auto c : _clients)
+        if(c->id() == id && c->status() == WS_CONNECTED) return c;
+    return nullptr;
+}
+
+bool AsyncWebSocket::availableForWriteAll() {
+    for(auto c : _clients)
+        if(c->status() == WS_CONNECTED && c->queueIsFull()) return false;
+    return true;
+}
+
+void AsyncWebSocket::textAll(const char *message, size_t len) {
+    for(auto c : _clients)
+        if(c->status() == WS_CONNECTED && !c->queueIsFull()) c->text(message, len);
+}
+
+void AsyncWebSocket::binaryAll(const uint8_t *message, size_t len) {
+    textAll((const char*)message, len);
+}
+
+void AsyncWebSocket::cleanupClients(uint16_t maxClients) {
+    for(size_t i = 0; i < _clients.size();) {
+        if(_clients[i]->status() == WS_DISCONNECTED) {
+            delete _clients[i];
+            _clients.erase(_clients.begin() + i);
+        } else {
+            i++;
+        }
+    }
+    while(count() > maxClients) _clients.front()->close();
+}
+
+AsyncWebSocketClient *AsyncWebSocket::hostConnect() {
+    AsyncWebSocketClient *c = new AsyncWebSocketClient(this, _nextId++);
+    _clients.push_back(c);
+    if(_handler) _handler(this, c, WS_EVT_CONNECT, nullptr, nullptr, 0);
+    return c;
+}
+
+void AsyncWebSocket::hostDisconnect(AsyncWebSocketClient *c) {
+    c->close();
+    if(_handler) _handler(this, c, WS_EVT_DISCONNECT, nullptr, nullptr, 0);
+}
+
+void AsyncWebSocket::hostReceive(AsyncWebSocketClient *c, const char *text) {
+    AwsFrameInfo info = {WS_TEXT, 0, 1, 0, WS_TEXT, strlen(text), {0, 0, 0, 0}, 0};
+    if(_handler) _handler(this, c, WS_EVT_DATA, &info, (uint8_t*)text, strlen(text));
+}
+
+AsyncWebServer::~AsyncWebServer() {
+    for(auto h : _handlers) delete h;
+}
+
+AsyncCallbackWebHandler &AsyncWebServer::on(const char *uri, WebRequestMethodComposite method,
+                                            ArRequestHandlerFunction onRequest) {
+    return on(uri, method, onRequest, nullptr, nullptr);
+}
+
+AsyncCallbackWebHandler &AsyncWebServer::on(const char *uri, WebRequestMethodComposite method,
+                                            ArRequestHandlerFunction onRequest,
+                                            ArUploadHandlerFunction onUpload,
+                                            ArBodyHandlerFunction onBody) {
+    AsyncCallbackWebHandler *h = new AsyncCallbackWebHandler;
+    h->uri = uri;
+    h->method = method;
+    h->onRequest = onRequest;
+    h->onUpload = onUpload;
+    h->onBody = onBody;
+    _handlers.push_back(h);
+    return *h;
+}
+
+AsyncCallbackWebHandler *AsyncWebServer::find(AsyncWebServerRequest *req) {
+    for(auto h : _handlers)
+        if((h->method & req->method()) && h->uri == req->url()) return h;
+    return nullptr;
+}
+
+bool AsyncWebServer::hostDispatch(AsyncWebServerRequest *req, const uint8_t *body, size_t bodyLen) {
+    AsyncCallbackWebHandler *h = find(req);
+    if(!h) {
+        if(_notFound) _notFound(req);
+        return false;
+    }
+    if(body && h->onBody) {
+        req->hostSetContentLength(bodyLen);
+        h->onBody(req, (uint8_t*)body, bodyLen, 0, bodyLen);
+    }
+    if(h->onRequest && !req->hostResponse()) h->onRequest(req);
+    return true;
+}
+
+bool AsyncWebServer::hostUpload(AsyncWebServerRequest *req, const uint8_t *data, size_t len,
+                                size_t chunk) {
+    AsyncCallbackWebHandler *h = find(req);
+    if(!h || !h->onUpload) return false;
+    String filename("firmware.bin");
+    size_t index = 0;
+    do {
+        size_t n = len - index < chunk ? len - index : chunk;
+        h->onUpload(req, filename, index, (uint8_t*)data + index, n, index + n == len);
+        index += n;
+    } while(index < len);
+    if(h->onRequest) h->onRequest(req);
+    return true;
+}
@@ -0,0 +1,294 @@
+#include "FS.h"
+#include "LittleFS.h"
+#include <map>
+#include <string>
+#include <vector>
+
+namespace fs {
+
+struct Node {
+    bool dir = false;
+    std::vector<uint8_t> data;
+};
+
+struct FSImpl {
+    std::map<std::string, std::shared_ptr<Node>> nodes;
+    uint64_t bytesWritten = 0;
+    uint64_t bytesRead = 0;
+    uint32_t opens = 0;
+};
+
+struct FileImpl {
+    std::shared_ptr<FSImpl> fs;
+    std::string path;
+    std::shared_ptr<Node> node;
+    size_t pos = 0;
+    bool canRead = false;
+    bool canWrite = false;
+    bool append = false;
+    bool open = false;
+    size_t dirIndex = 0;
+};
+
+static std::string normalize(const char *path) {
+    std::string p = path ? path : "/";
+    if(p.empty() || p[0] != '/') p = "/" + p;
+    while(p.size() > 1 && p.back() == '/') p.pop_back();
+    return p;
+}
+
+static std::string parentOf(const std::string &p) {
+    size_t s = p.rfind('/');
+    return s == 0 ? "/" : p.substr(0, s);
+}
+
+static void makeRoot(FSImpl &fs) {
+    auto root = std::make_shared<Node>();
+    root->dir = true;
+    fs.nodes["/"] = root;
+}
+
+FS::FS() : impl(std::make_shared<FSImpl>()) {
+    makeRoot(*impl);
+}
+
+static bool mkdirs(FSImpl &fs, const std::string &p) {
+    auto it = fs.nodes.find(p);
+    if(it != fs.nodes.end()) return it->second->dir;
+    if(!mkdirs(fs, parentOf(p))) return false;
+    auto n = std::make_shared<Node>();
+    n->dir = true;
+    fs.nodes[p] = n;
+    return true;
+}
+
+File FS::open(const char *path, const char *mode, bool create) {
+    std::string p = normalize(path);
+    std::string m = mode ? mode : "r";
+    auto f = std::make_shared<FileImpl>();
+    f->fs = impl;
+    f->path = p;
+    auto it = impl->nodes.find(p);
+    bool plus = m.find('+') != std::string::npos;
+    if(m[0] == 'r') {
+        if(it == impl->nodes.end()) return File();
+        f->node = it->second;
+        f->canRead = true;
+        f->canWrite = plus;
+    } else if(m[0] == 'w' || m[0] == 'a') {
+        if(it != impl->nodes.end() && it->second->dir) return File();
+        std::string parent = parentOf(p);
+        auto pit = impl->nodes.find(parent);
+        if(pit == impl->nodes.end()) {
+            if(!create || !mkdirs(*impl, parent)) return File();
+        } else if(!pit->second->dir) {
+            return File();
+        }
+        if(it == impl->nodes.end()) {
+            f->node = std::make_shared<Node>();
+            impl->nodes[p] = f->node;
+        } else {
+            f->node = it->second;
+        }
+        f->canWrite = true;
+        f->canRead = plus;
+        if(m[0] == 'w') f->node->data.clear();
+        else { f->append = true; f->pos = f->node->data.size(); }
+    } else {
+        return File();
+    }
+    f->open = true;
+    impl->opens++;
+    return File(f);
+}
+
+bool FS::exists(const char *path) {
+    return impl->nodes.count(normalize(path)) != 0;
+}
+
+bool FS::remove(const char *path) {
+    auto it = impl->nodes.find(normalize(path));
+    if(it == impl->nodes.end() || it->second->dir) return false;
+    impl->nodes.erase(it);
+    return true;
+}
+
+bool FS::rename(const char *from, const char *to) {
+    std::string a = normalize(from), b = normalize(to);
+    auto it = impl->nodes.find(a);
+    if(it == impl->nodes.end() || it->second->dir) return false;
+    if(!impl->nodes.count(parentOf(b))) return false;
+    auto node = it->second;
+    impl->nodes.erase(it);
+    impl->nodes[b] = node;
+    return true;
+}
+
+bool FS::mkdir(const char *path) {
+    std::string p = normalize(path);
+    if(impl->nodes.count(p)) return impl->nodes[p]->dir;
+    if(!impl->nodes.count(parentOf(p))) return false;
+    return mkdirs(*impl, p);
+}
+
+bool FS::rmdir(const char *path) {
+    std::string p = normalize(path);
+    auto it = impl->nodes.find(p);
+    if(p == "/" || it == impl->nodes.end() || !it->second->dir) return false;
+    std::string prefix = p + "/";
+    auto next = impl->nodes.lower_bound(prefix);
+    if(next != impl->nodes.end() && next->first.compare(0, prefix.size(), prefix) == 0)
+        return false;
+    impl->nodes.erase(it);
+    return true;
+}
+
+void FS::hostFormat() {
+    impl->nodes.clear();
+    makeRoot(*impl);
+}
+
+bool FS::hostTruncate(const char *path, size_t size) {
+    auto it = impl->nodes.find(normalize(path));
+    if(it == impl->nodes.end() || it->second->dir) return false;
+    if(size < it->second->data.size()) it->second->data.resize(size);
+    return true;
+}
+
+uint64_t FS::hostBytesWritten() const { return impl->bytesWritten; }
+uint64_t FS::hostBytesRead() const { return impl->bytesRead; }
+uint32_t FS::hostFileOpens() const { return impl->opens; }
+
+void FS::hostResetCounters() {
+    impl->bytesWritten = 0;
+    impl->bytesRead = 0;
+    impl->opens = 0;
+}
+
+size_t File::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+size_t File::write(const uint8_t *buf, size_t size) {
+    if(!impl || !impl->open || !impl->canWrite || impl->node->dir) return 0;
+    auto &d = impl->node->data;
+    if(impl->append) impl->pos = d.size();
+    if(impl->pos + size > d.size()) d.resize(impl->pos + size);
+    std::copy(buf, buf + size, d.begin() + impl->pos);
+    impl->pos += size;
+    impl->fs->bytesWritten += size;
+    return size;
+}
+
+int File::available() {
+    if(!impl || !impl->open || !impl->canRead || impl->node->dir) return 0;
+    return (int)(impl->node->data.size() - std::min(impl->pos, impl->node->data.size()));
+}
+
+int File::read() {
+    uint8_t c;
+    return read(&c, 1) == 1 ? c : -1;
+}
+
+int File::peek() {
+    if(available() <= 0) return -1;
+    return impl->node->data[impl->pos];
+}
+
+size_t File::read(uint8_t *buf, size_t size) {
+    size_t avail = (size_t)available();
+    if(size > avail) size = avail;
+    if(!size) return 0;
+    std::copy(impl->node->data.begin() + impl->pos,
+              impl->node->data.begin() + impl->pos + size, buf);
+    impl->pos += size;
+    impl->fs->bytesRead += size;
+    return size;
+}
+
+bool File::seek(uint32_t pos, SeekMode mode) {
+    if(!impl || !impl->open || impl->node->dir) return false;
+    size_t base = mode == SeekSet ? 0 : mode == SeekCur ? impl->pos : impl->node->data.size();
+    size_t target = base + pos;
+    if(target > impl->node->data.size()) return false;
+    impl->pos = target;
+    return true;
+}
+
+size_t File::position() const {
+    return impl && impl->open ? impl->pos : 0;
+}
+
+size_t File::size() const {
+    return impl && impl->open && !impl->node->dir ? impl->node->data.size() : 0;
+}
+
+void File::close() {
+    if(impl) impl->open = false;
+}
+
+File::operator bool() const {
+    return impl && impl->open;
+}
+
+const char *File::name() const {
+    if(!impl) return "";
+    size_t s = impl->path.rfind('/');
+    return impl->path.c_str() + s + 1;
+}
+
+const char *File::path() const {
+    return impl ? impl->path.c_str() : "";
+}
+
+bool File::isDirectory() const {
+    return impl && impl->open && impl->node->dir;
+}
+
+File File::openNextFile(const char*) {
+    if(!isDirectory()) return File();
+    std::string prefix = impl->path == "/" ? "/" : impl->path + "/";
+    size_t idx = 0;
+    for(auto &kv : impl->fs->nodes) {
+        const std::string &p = kv.first;
+        if(p == "/" || p.compare(0, prefix.size(), prefix) != 0) continue;
+        if(p.find('/', prefix.size()) != std::string::npos) continue;
+        if(idx++ < impl->dirIndex) continue;
+        impl->dirIndex++;
+        auto f = std::make_shared<FileImpl>();
+        f->fs = impl->fs;
+        f->path = p;
+        f->node = kv.second;
+        f->canRead = true;
+        f->open = true;
+        return File(f);
+    }
+    return File();
+}
+
+void File::rewindDirectory() {
+    if(impl) impl->dirIndex = 0;
+}
+
+bool LittleFSFS::begin(bool, const char*, uint8_t, const char*) {
+    return true;
+}
+
+bool LittleFSFS::format() {
+    hostFormat();
+    return true;
+}
+
+size_t LittleFSFS::totalBytes() {
+    return 1536 * 1024;
+}
+
+size_t LittleFSFS::usedBytes() {
+    size_t used = 0;
+    for(auto &kv : impl->nodes) used += (kv.second->data.size() + 4095) / 4096 * 4096;
+    return used;
+}
+
+} // namespace fs
+
+fs::LittleFSFS LittleFS;
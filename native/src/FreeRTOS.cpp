@@ -0,0 +1,252 @@
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+struct NativeTask {
+    TaskFunction_t fn;
+    void *arg;
+    BaseType_t core;
+    uint32_t stackDepth;
+    std::mutex notifyMutex;
+    std::condition_variable notifyCv;
+    uint32_t notifyValue = 0;
+    bool notifyPending = false;
+};
+
+struct NativeQueue {
+    std::mutex m;
+    std::condition_variable notEmpty;
+    std::condition_variable notFull;
+    std::vector<uint8_t> storage;
+    UBaseType_t length;
+    UBaseType_t itemSize;
+    UBaseType_t head = 0;
+    UBaseType_t count = 0;
+};
+
+template<typename Pred>
+static bool waitFor(std::condition_variable &cv, std::unique_lock<std::mutex> &lk,
+                    TickType_t wait, Pred pred) {
+    if(wait == portMAX_DELAY) { cv.wait(lk, pred); return true; }
+    if(wait == 0) return pred();    // a zero timeout still costs a timed sleep
+    return cv.wait_for(lk, std::chrono::milliseconds(wait), pred);
+}
+
+static std::recursive_mutex criticalMutex;
+static thread_local NativeTask *currentTask = nullptr;
+static const auto bootTime = std::chrono::steady_clock::now();
+
+void vPortEnterCritical(portMUX_TYPE*) { criticalMutex.lock(); }
+void vPortExitCritical(portMUX_TYPE*) { criticalMutex.unlock(); }
+
+BaseType_t xPortGetCoreID() {
+    return currentTask && currentTask->core != tskNO_AFFINITY ? currentTask->core : 0;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char*, uint32_t stackDepth,
+                                   void *arg, UBaseType_t, TaskHandle_t *handle,
+                                   BaseType_t core) {
+    NativeTask *t = new NativeTask;
+    t->fn = fn;
+    t->arg = arg;
+    t->core = core;
+    t->stackDepth = stackDepth;
+    if(handle) *handle = t;
+    std::thread([t]{
+        currentTask = t;
+        t->fn(t->arg);
+    }).detach();
+    return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stackDepth,
+                       void *arg, UBaseType_t priority, TaskHandle_t *handle) {
+    return xTaskCreatePinnedToCore(fn, name, stackDepth, arg, priority, handle, tskNO_AFFINITY);
+}
+
+void vTaskDelete(TaskHandle_t) {
+    // Threads cannot be killed from outside; a task deleting itself just
+    // parks forever, which matches "never scheduled again".
+    for(;;) std::this_thread::sleep_for(std::chrono::hours(1));
+}
+
+void vTaskDelay(TickType_t ticks) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ticks));
+}
+
+TickType_t xTaskGetTickCount() {
+    return (TickType_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - bootTime).count();
+}
+
+// Threads not started through xTaskCreate (the host main thread) still
+// get a task control block so they can wait for notifications.
+static NativeTask *selfTask() {
+    if(!currentTask) {
+        currentTask = new NativeTask;
+        currentTask->fn = nullptr;
+        currentTask->arg = nullptr;
+        currentTask->core = tskNO_AFFINITY;
+        currentTask->stackDepth = 0;
+    }
+    return currentTask;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+    return selfTask();
+}
+
+BaseType_t xTaskNotify(TaskHandle_t task, uint32_t value, eNotifyAction action) {
+    if(!task) return pdFAIL;
+    std::lock_guard<std::mutex> lk(task->notifyMutex);
+    switch(action) {
+        case eNoAction: break;
+        case eSetBits: task->notifyValue |= value; break;
+        case eIncrement: task->notifyValue++; break;
+        case eSetValueWithOverwrite: task->notifyValue = value; break;
+        case eSetValueWithoutOverwrite:
+            if(task->notifyPending) return pdFAIL;
+            task->notifyValue = value;
+            break;
+    }
+    task->notifyPending = true;
+    task->notifyCv.notify_all();
+    return pdPASS;
+}
+
+BaseType_t xTaskNotifyWait(uint32_t clearOnEntry, uint32_t clearOnExit, uint32_t *value,
+                           TickType_t wait) {
+    NativeTask *t = selfTask();
+    std::unique_lock<std::mutex> lk(t->notifyMutex);
+    if(!t->notifyPending) t->notifyValue &= ~clearOnEntry;
+    if(!waitFor(t->notifyCv, lk, wait, [t]{ return t->notifyPending; })) {
+        if(value) *value = t->notifyValue;
+        return pdFALSE;
+    }
+    if(value) *value = t->notifyValue;
+    t->notifyValue &= ~clearOnExit;
+    t->notifyPending = false;
+    return pdTRUE;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t wait) {
+    NativeTask *t = selfTask();
+    std::unique_lock<std::mutex> lk(t->notifyMutex);
+    waitFor(t->notifyCv, lk, wait, [t]{ return t->notifyValue != 0; });
+    uint32_t v = t->notifyValue;
+    if(v) t->notifyValue = clearOnExit ? 0 : v - 1;
+    t->notifyPending = false;
+    return v;
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task) {
+    return task ? task->stackDepth : 0;
+}
+
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize) {
+    NativeQueue *q = new NativeQueue;
+    q->length = length;
+    q->itemSize = itemSize;
+    q->storage.resize((size_t)length * itemSize);
+    return q;
+}
+
+void vQueueDelete(QueueHandle_t q) {
+    delete q;
+}
+
+static BaseType_t queueSend(QueueHandle_t q, const void *item, TickType_t wait, bool front) {
+    if(!q) return errQUEUE_FULL;
+    std::unique_lock<std::mutex> lk(q->m);
+    if(!waitFor(q->notFull, lk, wait, [q]{ return q->count < q->length; }))
+        return errQUEUE_FULL;
+    UBaseType_t slot;
+    if(front) {
+        q->head = (q->head + q->length - 1) % q->length;
+        slot = q->head;
+    } else {
+        slot = (q->head + q->count) % q->length;
+    }
+    if(q->itemSize) memcpy(&q->storage[(size_t)slot * q->itemSize], item, q->itemSize);
+    q->count++;
+    q->notEmpty.notify_one();
+    return pdPASS;
+}
+
+BaseType_t xQueueSend(QueueHandle_t q, const void *item, TickType_t wait) {
+    return queueSend(q, item, wait, false);
+}
+
+BaseType_t xQueueSendToFront(QueueHandle_t q, const void *item, TickType_t wait) {
+    return queueSend(q, item, wait, true);
+}
+
+static BaseType_t queueReceive(QueueHandle_t q, void *item, TickType_t wait, bool remove) {
+    if(!q) return pdFALSE;
+    std::unique_lock<std::mutex> lk(q->m);
+    if(!waitFor(q->notEmpty, lk, wait, [q]{ return q->count > 0; }))
+        return pdFALSE;
+    if(q->itemSize && item)
+        memcpy(item, &q->storage[(size_t)q->head * q->itemSize], q->itemSize);
+    if(remove) {
+        q->head = (q->head + 1) % q->length;
+        q->count--;
+        q->notFull.notify_one();
+    }
+    return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t q, void *item, TickType_t wait) {
+    return queueReceive(q, item, wait, true);
+}
+
+BaseType_t xQueuePeek(QueueHandle_t q, void *item, TickType_t wait) {
+    return queueReceive(q, item, wait, false);
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q) {
+    if(!q) return 0;
+    std::lock_guard<std::mutex> lk(q->m);
+    return q->count;
+}
+
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t q) {
+    if(!q) return 0;
+    std::lock_guard<std::mutex> lk(q->m);
+    return q->length - q->count;
+}
+
+BaseType_t xQueueReset(QueueHandle_t q) {
+    if(!q) return pdFAIL;
+    std::lock_guard<std::mutex> lk(q->m);
+    q->head = 0;
+    q->count = 0;
+    q->notFull.notify_all();
+    return pdPASS;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex() {
+    SemaphoreHandle_t s = xQueueCreate(1, 0);
+    xQueueSend(s, nullptr, 0);
+    return s;
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary() {
+    return xQueueCreate(1, 0);
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t s, TickType_t wait) {
+    return xQueueReceive(s, nullptr, wait);
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t s) {
+    return xQueueSend(s, nullptr, 0);
+}
@@ -0,0 +1,96 @@
+#include "PubSubClient.h"
+#include "WiFi.h"
+
+WiFiClass WiFi;
+
+wl_status_t WiFiClass::begin(const char*, const char*) {
+    return linkStatus;
+}
+
+bool WiFiClass::softAP(const char*, const char*) {
+    currentMode = WIFI_AP;
+    return true;
+}
+
+bool WiFiClass::disconnect(bool, bool) {
+    linkStatus = WL_DISCONNECTED;
+    return true;
+}
+
+bool WiFiClass::reconnect() {
+    reconnects++;
+    return true;
+}
+
+wifi_event_id_t WiFiClass::onEvent(WiFiEventCb cb, arduino_event_id_t event) {
+    if(handlerCount == (int)(sizeof(handlers) / sizeof(handlers[0]))) return 0;
+    handlers[handlerCount] = {cb, event};
+    return ++handlerCount;
+}
+
+void WiFiClass::fire(arduino_event_id_t event) {
+    for(int i = 0; i < handlerCount; i++)
+        if(handlers[i].event == ARDUINO_EVENT_MAX || handlers[i].event == event)
+            handlers[i].cb(event);
+}
+
+void WiFiClass::hostSetStatus(wl_status_t s) {
+    bool was = linkStatus == WL_CONNECTED;
+    linkStatus = s;
+    if(!was && s == WL_CONNECTED) {
+        fire(ARDUINO_EVENT_WIFI_STA_CONNECTED);
+        fire(ARDUINO_EVENT_WIFI_STA_GOT_IP);
+    } else if(was && s != WL_CONNECTED) {
+        fire(ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+    }
+}
+
+PubSubClient &PubSubClient::setServer(const char*, uint16_t) {
+    return *this;
+}
+
+bool PubSubClient::connect(const char *id) {
+    return connect(id, nullptr, nullptr, nullptr, 0, false, nullptr);
+}
+
+bool PubSubClient::connect(const char *id, const char *user, const char *pass) {
+    return connect(id, user, pass, nullptr, 0, false, nullptr);
+}
+
+bool PubSubClient::connect(const char *id, const char *willTopic, uint8_t willQos,
+                           bool willRetain, const char *willMessage) {
+    return connect(id, nullptr, nullptr, willTopic, willQos, willRetain, willMessage);
+}
+
+bool PubSubClient::connect(const char*, const char*, const char*, const char*,
+                           uint8_t, bool, const char*, bool) {
+    connects++;
+    isConnected = connectResult;
+    return isConnected;
+}
+
+void PubSubClient::disconnect() {
+    isConnected = false;
+}
+
+bool PubSubClient::publish(const char *topic, const char *payload) {
+    return publish(topic, (const uint8_t*)payload, payload ? strlen(payload) : 0, false);
+}
+
+bool PubSubClient::publish(const char *topic, const char *payload, bool retained) {
+    return publish(topic, (const uint8_t*)payload, payload ? strlen(payload) : 0, retained);
+}
+
+bool PubSubClient::publish(const char *topic, const uint8_t *payload, unsigned int plength) {
+    return publish(topic, payload, plength, false);
+}
+
+bool PubSubClient::publish(const char *topic, const uint8_t *payload, unsigned int plength, bool) {
+    if(!isConnected) return false;
+    // The real client rejects packets that do not fit its buffer.
+    if(strlen(topic) + plength + 7 > bufferSize) return false;
+    if(hook && !hook(topic, payload, plength)) return false;
+    published++;
+    publishedBytes += strlen(topic) + plength;
+    return true;
+}
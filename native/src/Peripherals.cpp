@@ -0,0 +1,50 @@
+#include "Adafruit_AHTX0.h"
+#include "Update.h"
+
+UpdateClass Update;
+
+bool Adafruit_AHTX0::getEvent(sensors_event_t *h, sensors_event_t *t) {
+    measurements++;
+    if(h) { memset(h, 0, sizeof(*h)); h->relative_humidity = humidity; }
+    if(t) { memset(t, 0, sizeof(*t)); t->temperature = temperature; }
+    return true;
+}
+
+bool UpdateClass::begin(size_t size, int) {
+    image.clear();
+    expected = size;
+    error = 0;
+    running = true;
+    finished = false;
+    return true;
+}
+
+size_t UpdateClass::write(uint8_t *data, size_t len) {
+    if(!running || error) return 0;
+    if(expected != UPDATE_SIZE_UNKNOWN && image.size() + len > expected) {
+        error = 1;
+        return 0;
+    }
+    image.insert(image.end(), data, data + len);
+    return len;
+}
+
+bool UpdateClass::end(bool evenIfRemaining) {
+    if(!running || error) return false;
+    if(!evenIfRemaining && expected != UPDATE_SIZE_UNKNOWN && image.size() != expected) {
+        error = 2;
+        return false;
+    }
+    running = false;
+    finished = true;
+    return true;
+}
+
+void UpdateClass::abort() {
+    running = false;
+    error = 3;
+}
+
+void UpdateClass::printError(Print &out) {
+    out.printf("Update error %u\n", error);
+}
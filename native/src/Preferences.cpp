@@ -0,0 +1,153 @@
+#include "Preferences.h"
+#include <map>
+#include <string>
+#include <string.h>
+#include <vector>
+
+typedef std::map<std::string, std::vector<uint8_t>> Namespace;
+
+static std::map<std::string, Namespace> &store() {
+    static std::map<std::string, Namespace> s;
+    return s;
+}
+
+static uint32_t writes = 0;
+
+bool Preferences::begin(const char *name, bool ro, const char*) {
+    if(!name || strlen(name) >= sizeof(ns)) return false;
+    strcpy(ns, name);
+    readOnly = ro;
+    opened = true;
+    return true;
+}
+
+void Preferences::end() {
+    opened = false;
+}
+
+bool Preferences::clear() {
+    if(!opened || readOnly) return false;
+    store()[ns].clear();
+    return true;
+}
+
+bool Preferences::remove(const char *key) {
+    if(!opened || readOnly) return false;
+    return store()[ns].erase(key) != 0;
+}
+
+bool Preferences::isKey(const char *key) {
+    return opened && store()[ns].count(key) != 0;
+}
+
+size_t Preferences::put(const char *key, const void *value, size_t len) {
+    if(!opened || readOnly || !key || strlen(key) > 15) return 0;
+    const uint8_t *p = (const uint8_t*)value;
+    std::vector<uint8_t> v(p, p + len);
+    auto &slot = store()[ns][key];
+    if(slot != v) {
+        slot = v;
+        writes++;
+    }
+    return len;
+}
+
+bool Preferences::get(const char *key, void *value, size_t len) {
+    if(!opened) return false;
+    auto &n = store()[ns];
+    auto it = n.find(key);
+    if(it == n.end() || it->second.size() != len) return false;
+    memcpy(value, it->second.data(), len);
+    return true;
+}
+
+size_t Preferences::putBool(const char *key, bool value) { uint8_t v = value; return put(key, &v, 1); }
+size_t Preferences::putUChar(const char *key, uint8_t value) { return put(key, &value, sizeof(value)); }
+size_t Preferences::putUShort(const char *key, uint16_t value) { return put(key, &value, sizeof(value)); }
+size_t Preferences::putInt(const char *key, int32_t value) { return put(key, &value, sizeof(value)); }
+size_t Preferences::putUInt(const char *key, uint32_t value) { return put(key, &value, sizeof(value)); }
+size_t Preferences::putULong(const char *key, uint32_t value) { return put(key, &value, sizeof(value)); }
+size_t Preferences::putFloat(const char *key, float value) { return put(key, &value, sizeof(value)); }
+size_t Preferences::putBytes(const char *key, const void *value, size_t len) { return put(key, value, len); }
+
+size_t Preferences::putString(const char *key, const char *value) {
+    if(!value) return 0;
+    size_t len = strlen(value);
+    return put(key, value, len + 1) ? len : 0;
+}
+
+bool Preferences::getBool(const char *key, bool defaultValue) {
+    uint8_t v;
+    return get(key, &v, 1) ? v != 0 : defaultValue;
+}
+
+uint8_t Preferences::getUChar(const char *key, uint8_t defaultValue) {
+    uint8_t v;
+    return get(key, &v, sizeof(v)) ? v : defaultValue;
+}
+
+uint16_t Preferences::getUShort(const char *key, uint16_t defaultValue) {
+    uint16_t v;
+    return get(key, &v, sizeof(v)) ? v : defaultValue;
+}
+
+int32_t Preferences::getInt(const char *key, int32_t defaultValue) {
+    int32_t v;
+    return get(key, &v, sizeof(v)) ? v : defaultValue;
+}
+
+uint32_t Preferences::getUInt(const char *key, uint32_t defaultValue) {
+    uint32_t v;
+    return get(key, &v, sizeof(v)) ? v : defaultValue;
+}
+
+uint32_t Preferences::getULong(const char *key, uint32_t defaultValue) {
+    return getUInt(key, defaultValue);
+}
+
+float Preferences::getFloat(const char *key, float defaultValue) {
+    float v;
+    return get(key, &v, sizeof(v)) ? v : defaultValue;
+}
+
+size_t Preferences::getString(const char *key, char *value, size_t maxLen) {
+    if(!opened) return 0;
+    auto &n = store()[ns];
+    auto it = n.find(key);
+    if(it == n.end() || it->second.size() > maxLen) return 0;
+    memcpy(value, it->second.data(), it->second.size());
+    return it->second.size();
+}
+
+String Preferences::getString(const char *key, const String &defaultValue) {
+    if(!opened) return defaultValue;
+    auto &n = store()[ns];
+    auto it = n.find(key);
+    if(it == n.end()) return defaultValue;
+    return String((const char*)it->second.data());
+}
+
+size_t Preferences::getBytesLength(const char *key) {
+    if(!opened) return 0;
+    auto &n = store()[ns];
+    auto it = n.find(key);
+    return it == n.end() ? 0 : it->second.size();
+}
+
+size_t Preferences::getBytes(const char *key, void *buf, size_t maxLen) {
+    if(!opened) return 0;
+    auto &n = store()[ns];
+    auto it = n.find(key);
+    if(it == n.end() || it->second.size() > maxLen) return 0;
+    memcpy(buf, it->second.data(), it->second.size());
+    return it->second.size();
+}
+
+uint32_t Preferences::hostWrites() {
+    return writes;
+}
+
+void Preferences::hostReset() {
+    store().clear();
+    writes = 0;
+}
@@ -0,0 +1,78 @@
+#include "Print.h"
+#include "Stream.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+size_t Print::write(const uint8_t *buffer, size_t size) {
+    size_t n = 0;
+    while(size--) {
+        if(!write(*buffer++)) break;
+        n++;
+    }
+    return n;
+}
+
+size_t Print::write(const char *str) {
+    if(!str) return 0;
+    return write((const uint8_t*)str, strlen(str));
+}
+
+size_t Print::printf(const char *format, ...) {
+    char buf[256];
+    va_list args;
+    va_start(args, format);
+    int len = vsnprintf(buf, sizeof(buf), format, args);
+    va_end(args);
+    if(len < 0) return 0;
+    if((size_t)len < sizeof(buf)) return write((const uint8_t*)buf, len);
+    char *big = new char[len + 1];
+    va_start(args, format);
+    vsnprintf(big, len + 1, format, args);
+    va_end(args);
+    size_t n = write((const uint8_t*)big, len);
+    delete[] big;
+    return n;
+}
+
+size_t Print::print(int n, int base) { return print(String(n, (unsigned char)base)); }
+size_t Print::print(unsigned int n, int base) { return print(String(n, (unsigned char)base)); }
+size_t Print::print(long n, int base) { return print(String(n, (unsigned char)base)); }
+size_t Print::print(unsigned long n, int base) { return print(String(n, (unsigned char)base)); }
+size_t Print::print(double n, int digits) { return print(String(n, (unsigned int)digits)); }
+
+size_t Stream::readBytes(char *buffer, size_t length) {
+    size_t count = 0;
+    while(count < length) {
+        int c = read();
+        if(c < 0) break;
+        *buffer++ = (char)c;
+        count++;
+    }
+    return count;
+}
+
+size_t Stream::readBytesUntil(char terminator, char *buffer, size_t length) {
+    size_t index = 0;
+    while(index < length) {
+        int c = read();
+        if(c < 0 || c == terminator) break;
+        *buffer++ = (char)c;
+        index++;
+    }
+    return index;
+}
+
+String Stream::readString() {
+    String ret;
+    int c;
+    while((c = read()) >= 0) ret += (char)c;
+    return ret;
+}
+
+String Stream::readStringUntil(char terminator) {
+    String ret;
+    int c;
+    while((c = read()) >= 0 && c != terminator) ret += (char)c;
+    return ret;
+}
@@ -0,0 +1,302 @@
+#include "WString.h"
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void formatInteger(char *buf, size_t size, unsigned long long value, bool negative,
+                          unsigned char base) {
+    char tmp[66];
+    size_t i = 0;
+    if(base < 2 || base > 36) base = 10;
+    do {
+        unsigned digit = value % base;
+        tmp[i++] = digit < 10 ? '0' + digit : 'a' + digit - 10;
+        value /= base;
+    } while(value && i < sizeof(tmp) - 1);
+    size_t o = 0;
+    if(negative && o < size - 1) buf[o++] = '-';
+    while(i && o < size - 1) buf[o++] = tmp[--i];
+    buf[o] = 0;
+}
+
+void String::init() {
+    buffer = nullptr;
+    capacity = 0;
+    len = 0;
+}
+
+void String::invalidate() {
+    delete[] buffer;
+    init();
+}
+
+bool String::changeBuffer(unsigned int maxStrLen) {
+    char *nb = new char[maxStrLen + 1];
+    if(buffer) memcpy(nb, buffer, len + 1);
+    else nb[0] = 0;
+    delete[] buffer;
+    buffer = nb;
+    capacity = maxStrLen;
+    return true;
+}
+
+bool String::reserve(unsigned int size) {
+    if(buffer && capacity >= size) return true;
+    return changeBuffer(size);
+}
+
+String &String::copy(const char *cstr, unsigned int length) {
+    if(!reserve(length)) { invalidate(); return *this; }
+    len = length;
+    memmove(buffer, cstr, length);
+    buffer[len] = 0;
+    return *this;
+}
+
+void String::move(String &rhs) {
+    delete[] buffer;
+    buffer = rhs.buffer;
+    capacity = rhs.capacity;
+    len = rhs.len;
+    rhs.init();
+}
+
+String::String(const char *cstr) {
+    if(cstr) copy(cstr, strlen(cstr));
+}
+
+String::String(const String &str) {
+    *this = str;
+}
+
+String::String(String &&rval) noexcept {
+    move(rval);
+}
+
+String::String(char c) {
+    char buf[2] = {c, 0};
+    *this = buf;
+}
+
+String::String(unsigned char value, unsigned char base) {
+    char buf[66];
+    formatInteger(buf, sizeof(buf), value, false, base);
+    *this = buf;
+}
+
+String::String(int value, unsigned char base) {
+    char buf[66];
+    bool neg = base == 10 && value < 0;
+    formatInteger(buf, sizeof(buf), neg ? -(long long)value : (unsigned)value, neg, base);
+    *this = buf;
+}
+
+String::String(unsigned int value, unsigned char base) {
+    char buf[66];
+    formatInteger(buf, sizeof(buf), value, false, base);
+    *this = buf;
+}
+
+String::String(long value, unsigned char base) {
+    char buf[66];
+    bool neg = base == 10 && value < 0;
+    formatInteger(buf, sizeof(buf), neg ? -(long long)value : (unsigned long)value, neg, base);
+    *this = buf;
+}
+
+String::String(unsigned long value, unsigned char base) {
+    char buf[66];
+    formatInteger(buf, sizeof(buf), value, false, base);
+    *this = buf;
+}
+
+String::String(long long value, unsigned char base) {
+    char buf[66];
+    bool neg = base == 10 && value < 0;
+    formatInteger(buf, sizeof(buf), neg ? 0ULL - (unsigned long long)value
+                                        : (unsigned long long)value, neg, base);
+    *this = buf;
+}
+
+String::String(unsigned long long value, unsigned char base) {
+    char buf[66];
+    formatInteger(buf, sizeof(buf), value, false, base);
+    *this = buf;
+}
+
+String::String(float value, unsigned int decimalPlaces) {
+    char buf[48];
+    snprintf(buf, sizeof(buf), "%.*f", (int)decimalPlaces, (double)value);
+    *this = buf;
+}
+
+String::String(double value, unsigned int decimalPlaces) {
+    char buf[48];
+    snprintf(buf, sizeof(buf), "%.*f", (int)decimalPlaces, value);
+    *this = buf;
+}
+
+String::~String() {
+    delete[] buffer;
+}
+
+String &String::operator=(const String &rhs) {
+    if(this == &rhs) return *this;
+    if(rhs.buffer) copy(rhs.buffer, rhs.len);
+    else invalidate();
+    return *this;
+}
+
+String &String::operator=(String &&rval) noexcept {
+    if(this != &rval) move(rval);
+    return *this;
+}
+
+String &String::operator=(const char *cstr) {
+    if(cstr) copy(cstr, strlen(cstr));
+    else invalidate();
+    return *this;
+}
+
+bool String::concat(const char *cstr, unsigned int length) {
+    if(!cstr) return false;
+    if(length == 0) return true;
+    unsigned int newlen = len + length;
+    if(!reserve(newlen)) return false;
+    memmove(buffer + len, cstr, length);
+    len = newlen;
+    buffer[len] = 0;
+    return true;
+}
+
+bool String::concat(const String &str) { return concat(str.c_str(), str.len); }
+bool String::concat(const char *cstr) { return cstr ? concat(cstr, strlen(cstr)) : false; }
+bool String::concat(char c) { return concat(&c, 1); }
+bool String::concat(int num) { return concat(String(num)); }
+bool String::concat(unsigned int num) { return concat(String(num)); }
+bool String::concat(long num) { return concat(String(num)); }
+bool String::concat(unsigned long num) { return concat(String(num)); }
+bool String::concat(float num) { return concat(String(num)); }
+bool String::concat(double num) { return concat(String(num)); }
+
+int String::compareTo(const String &s) const {
+    return strcmp(c_str(), s.c_str());
+}
+
+bool String::equals(const String &s) const {
+    return len == s.len && compareTo(s) == 0;
+}
+
+bool String::equals(const char *cstr) const {
+    return strcmp(c_str(), cstr ? cstr : "") == 0;
+}
+
+bool String::startsWith(const String &prefix) const {
+    return startsWith(prefix, 0);
+}
+
+bool String::startsWith(const String &prefix, unsigned int offset) const {
+    if(offset + prefix.len > len) return false;
+    return strncmp(c_str() + offset, prefix.c_str(), prefix.len) == 0;
+}
+
+bool String::endsWith(const String &suffix) const {
+    if(suffix.len > len) return false;
+    return strcmp(c_str() + len - suffix.len, suffix.c_str()) == 0;
+}
+
+char String::charAt(unsigned int index) const {
+    return index < len ? buffer[index] : 0;
+}
+
+char &String::operator[](unsigned int index) {
+    static char dummy;
+    if(index >= len) { dummy = 0; return dummy; }
+    return buffer[index];
+}
+
+int String::indexOf(char ch, unsigned int fromIndex) const {
+    if(fromIndex >= len) return -1;
+    const char *p = strchr(buffer + fromIndex, ch);
+    return p ? (int)(p - buffer) : -1;
+}
+
+int String::indexOf(const String &str, unsigned int fromIndex) const {
+    if(fromIndex >= len) return -1;
+    const char *p = strstr(buffer + fromIndex, str.c_str());
+    return p ? (int)(p - buffer) : -1;
+}
+
+int String::lastIndexOf(char ch) const {
+    if(!len) return -1;
+    const char *p = strrchr(buffer, ch);
+    return p ? (int)(p - buffer) : -1;
+}
+
+String String::substring(unsigned int left, unsigned int right) const {
+    if(left > right) { unsigned int t = left; left = right; right = t; }
+    String out;
+    if(left >= len) return out;
+    if(right > len) right = len;
+    out.copy(buffer + left, right - left);
+    return out;
+}
+
+void String::trim() {
+    if(!len) return;
+    unsigned int b = 0, e = len;
+    while(b < e && isspace((unsigned char)buffer[b])) b++;
+    while(e > b && isspace((unsigned char)buffer[e - 1])) e--;
+    len = e - b;
+    memmove(buffer, buffer + b, len);
+    buffer[len] = 0;
+}
+
+void String::toLowerCase() {
+    for(unsigned int i = 0; i < len; i++) buffer[i] = tolower((unsigned char)buffer[i]);
+}
+
+void String::toUpperCase() {
+    for(unsigned int i = 0; i < len; i++) buffer[i] = toupper((unsigned char)buffer[i]);
+}
+
+long String::toInt() const { return len ? atol(buffer) : 0; }
+float String::toFloat() const { return len ? (float)atof(buffer) : 0; }
+double String::toDouble() const { return len ? atof(buffer) : 0; }
+
+StringSumHelper &operator+(const StringSumHelper &lhs, const String &rhs) {
+    StringSumHelper &a = const_cast<StringSumHelper&>(lhs);
+    a.concat(rhs);
+    return a;
+}
+
+StringSumHelper &operator+(const StringSumHelper &lhs, const char *cstr) {
+    StringSumHelper &a = const_cast<StringSumHelper&>(lhs);
+    a.concat(cstr);
+    return a;
+}
+
+StringSumHelper &operator+(const StringSumHelper &lhs, char c) {
+    StringSumHelper &a = const_cast<StringSumHelper&>(lhs);
+    a.concat(c);
+    return a;
+}
+
+StringSumHelper operator+(const String &lhs, const String &rhs) {
+    StringSumHelper a(lhs);
+    a.concat(rhs);
+    return a;
+}
+
+StringSumHelper operator+(const String &lhs, const char *cstr) {
+    StringSumHelper a(lhs);
+    a.concat(cstr);
+    return a;
+}
+
+StringSumHelper operator+(const char *cstr, const String &rhs) {
+    StringSumHelper a(cstr);
+    a.concat(rhs);
+    return a;
+}
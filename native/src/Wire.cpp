@@ -0,0 +1,42 @@
+#include "Wire.h"
+
+TwoWire Wire(0);
+TwoWire Wire1(1);
+
+void TwoWire::beginTransmission(uint16_t address) {
+    txAddr = address;
+    txLen = 0;
+}
+
+size_t TwoWire::write(uint8_t c) {
+    if(txLen >= sizeof(txBuf)) return 0;
+    txBuf[txLen++] = c;
+    return 1;
+}
+
+uint8_t TwoWire::endTransmission(bool) {
+    transactions++;
+    bytes += txLen + 1;
+    if(txAddr >= 128 || (!receivers[txAddr] && !responders[txAddr])) return 2; // NACK on address
+    if(receivers[txAddr]) receivers[txAddr]((uint8_t)txAddr, txBuf, txLen);
+    return 0;
+}
+
+uint8_t TwoWire::requestFrom(int address, int quantity, int) {
+    transactions++;
+    rxPos = 0;
+    rxLen = 0;
+    if(address < 0 || address >= 128 || !responders[address]) return 0;
+    if(quantity > (int)sizeof(rxBuf)) quantity = sizeof(rxBuf);
+    rxLen = responders[address]((uint8_t)address, rxBuf, (size_t)quantity);
+    bytes += rxLen + 1;
+    return (uint8_t)rxLen;
+}
+
+void TwoWire::hostSetResponder(uint8_t address, Responder r) {
+    if(address < 128) responders[address] = r;
+}
+
+void TwoWire::hostSetReceiver(uint8_t address, Receiver r) {
+    if(address < 128) receivers[address] = r;
+}
@@ -0,0 +1,594 @@
+#include "mbedtls/base64.h"
+#include "mbedtls/ecdsa.h"
+#include "mbedtls/sha256.h"
+#include <string.h>
+
+static const uint32_t K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+static inline uint32_t ror(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+
+static void process(mbedtls_sha256_context *ctx, const unsigned char data[64]) {
+    uint32_t w[64];
+    for(int i = 0; i < 16; i++)
+        w[i] = (uint32_t)data[i * 4] << 24 | (uint32_t)data[i * 4 + 1] << 16 |
+               (uint32_t)data[i * 4 + 2] << 8 | data[i * 4 + 3];
+    for(int i = 16; i < 64; i++) {
+        uint32_t s0 = ror(w[i - 15], 7) ^ ror(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = ror(w[i - 2], 17) ^ ror(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+    uint32_t a = ctx->state[0], b = ctx->state[1], c = ctx->state[2], d = ctx->state[3];
+    uint32_t e = ctx->state[4], f = ctx->state[5], g = ctx->state[6], h = ctx->state[7];
+    for(int i = 0; i < 64; i++) {
+        uint32_t s1 = ror(e, 6) ^ ror(e, 11) ^ ror(e, 25);
+        uint32_t ch = (e & f) ^ (~e & g);
+        uint32_t t1 = h + s1 + ch + K[i] + w[i];
+        uint32_t s0 = ror(a, 2) ^ ror(a, 13) ^ ror(a, 22);
+        uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+        uint32_t t2 = s0 + maj;
+        h = g; g = f; f = e; e = d + t1;
+        d = c; c = b; b = a; a = t1 + t2;
+    }
+    ctx->state[0] += a; ctx->state[1] += b; ctx->state[2] += c; ctx->state[3] += d;
+    ctx->state[4] += e; ctx->state[5] += f; ctx->state[6] += g; ctx->state[7] += h;
+}
+
+void mbedtls_sha256_init(mbedtls_sha256_context *ctx) {
+    memset(ctx, 0, sizeof(*ctx));
+}
+
+void mbedtls_sha256_free(mbedtls_sha256_context *ctx) {
+    if(ctx) memset(ctx, 0, sizeof(*ctx));
+}
+
+void mbedtls_sha256_clone(mbedtls_sha256_context *dst, const mbedtls_sha256_context *src) {
+    *dst = *src;
+}
+
+int mbedtls_sha256_starts_ret(mbedtls_sha256_context *ctx, int is224) {
+    static const uint32_t init[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+        0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+    };
+    if(is224) return -1; // not needed by the firmware
+    ctx->total[0] = ctx->total[1] = 0;
+    memcpy(ctx->state, init, sizeof(init));
+    ctx->is224 = 0;
+    return 0;
+}
+
+int mbedtls_sha256_update_ret(mbedtls_sha256_context *ctx, const unsigned char *input, size_t ilen) {
+    while(ilen) {
+        size_t left = ctx->total[0] & 0x3F;
+        size_t fill = 64 - left;
+        size_t n = ilen < fill ? ilen : fill;
+        memcpy(ctx->buffer + left, input, n);
+        ctx->total[0] += (uint32_t)n;
+        if(ctx->total[0] < n) ctx->total[1]++;
+        input += n;
+        ilen -= n;
+        if(left + n == 64) process(ctx, ctx->buffer);
+    }
+    return 0;
+}
+
+int mbedtls_sha256_finish_ret(mbedtls_sha256_context *ctx, unsigned char output[32]) {
+    uint64_t bits = ((uint64_t)ctx->total[1] << 32 | ctx->total[0]) * 8;
+    unsigned char pad = 0x80;
+    mbedtls_sha256_update_ret(ctx, &pad, 1);
+    pad = 0;
+    while((ctx->total[0] & 0x3F) != 56) mbedtls_sha256_update_ret(ctx, &pad, 1);
+    unsigned char len[8];
+    for(int i = 0; i < 8; i++) len[i] = (unsigned char)(bits >> (56 - 8 * i));
+    mbedtls_sha256_update_ret(ctx, len, 8);
+    for(int i = 0; i < 8; i++) {
+        output[i * 4] = (unsigned char)(ctx->state[i] >> 24);
+        output[i * 4 + 1] = (unsigned char)(ctx->state[i] >> 16);
+        output[i * 4 + 2] = (unsigned char)(ctx->state[i] >> 8);
+        output[i * 4 + 3] = (unsigned char)ctx->state[i];
+    }
+    return 0;
+}
+
+int mbedtls_sha256_ret(const unsigned char *input, size_t ilen, unsigned char output[32], int is224) {
+    mbedtls_sha256_context ctx;
+    mbedtls_sha256_init(&ctx);
+    int ret = mbedtls_sha256_starts_ret(&ctx, is224);
+    if(!ret) ret = mbedtls_sha256_update_ret(&ctx, input, ilen);
+    if(!ret) ret = mbedtls_sha256_finish_ret(&ctx, output);
+    mbedtls_sha256_free(&ctx);
+    return ret;
+}
+
+static const char b64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+int mbedtls_base64_encode(unsigned char *dst, size_t dlen, size_t *olen,
+                          const unsigned char *src, size_t slen) {
+    size_t need = (slen + 2) / 3 * 4;
+    if(!dst || dlen < need + 1) { *olen = need + 1; return MBEDTLS_ERR_BASE64_BUFFER_TOO_SMALL; }
+    size_t o = 0;
+    for(size_t i = 0; i < slen; i += 3) {
+        uint32_t v = (uint32_t)src[i] << 16;
+        if(i + 1 < slen) v |= (uint32_t)src[i + 1] << 8;
+        if(i + 2 < slen) v |= src[i + 2];
+        dst[o++] = b64[(v >> 18) & 63];
+        dst[o++] = b64[(v >> 12) & 63];
+        dst[o++] = i + 1 < slen ? b64[(v >> 6) & 63] : '=';
+        dst[o++] = i + 2 < slen ? b64[v & 63] : '=';
+    }
+    dst[o] = 0;
+    *olen = o;
+    return 0;
+}
+
+static int decodeChar(unsigned char c) {
+    if(c >= 'A' && c <= 'Z') return c - 'A';
+    if(c >= 'a' && c <= 'z') return c - 'a' + 26;
+    if(c >= '0' && c <= '9') return c - '0' + 52;
+    if(c == '+') return 62;
+    if(c == '/') return 63;
+    return -1;
+}
+
+int mbedtls_base64_decode(unsigned char *dst, size_t dlen, size_t *olen,
+                          const unsigned char *src, size_t slen) {
+    size_t n = 0, pad = 0;
+    for(size_t i = 0; i < slen; i++) {
+        if(src[i] == '=') { pad++; continue; }
+        if(pad || decodeChar(src[i]) < 0) return MBEDTLS_ERR_BASE64_INVALID_CHARACTER;
+        n++;
+    }
+    if(pad > 2 || (n + pad) % 4 != 0) return MBEDTLS_ERR_BASE64_INVALID_CHARACTER;
+    size_t need = n * 6 / 8;
+    if(!dst || dlen < need) { *olen = need; return MBEDTLS_ERR_BASE64_BUFFER_TOO_SMALL; }
+    uint32_t acc = 0;
+    int bits = 0;
+    size_t o = 0;
+    for(size_t i = 0; i < slen && src[i] != '='; i++) {
+        acc = acc << 6 | (uint32_t)decodeChar(src[i]);
+        bits += 6;
+        if(bits >= 8) {
+            bits -= 8;
+            dst[o++] = (unsigned char)(acc >> bits);
+        }
+    }
+    *olen = o;
+    return 0;
+}
+
+// P-256 in Montgomery form over 4 x 64-bit limbs, for mod p and mod n alike.
+typedef uint64_t u256[4];
+typedef unsigned __int128 u128;
+
+struct Modulus {
+    u256 m;
+    uint64_t inv;       // -m^-1 mod 2^64
+    u256 r2;            // 2^512 mod m
+};
+
+static const u256 kP = {0xFFFFFFFFFFFFFFFF, 0x00000000FFFFFFFF, 0, 0xFFFFFFFF00000001};
+static const u256 kN = {0xF3B9CAC2FC632551, 0xBCE6FAADA7179E84, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFF00000000};
+static const u256 kB = {0x3BCE3C3E27D2604B, 0x651D06B0CC53B0F6, 0xB3EBBD55769886BC, 0x5AC635D8AA3A93E7};
+static const u256 kGx = {0xF4A13945D898C296, 0x77037D812DEB33A0, 0xF8BCE6E563A440F2, 0x6B17D1F2E12C4247};
+static const u256 kGy = {0xCBB6406837BF51F5, 0x2BCE33576B315ECE, 0x8EE7EB4A7C0F9E16, 0x4FE342E2FE1A7F9B};
+
+static const u256 kOne = {1, 0, 0, 0};
+
+static void copy(u256 r, const u256 a) { memcpy(r, a, sizeof(u256)); }
+
+static bool isZero(const u256 a) { return !(a[0] | a[1] | a[2] | a[3]); }
+
+static int compare(const u256 a, const u256 b) {
+    for(int i = 3; i >= 0; i--)
+        if(a[i] != b[i]) return a[i] < b[i] ? -1 : 1;
+    return 0;
+}
+
+static uint64_t sub(u256 r, const u256 a, const u256 b) {
+    uint64_t borrow = 0;
+    for(int i = 0; i < 4; i++) {
+        u128 d = (u128)a[i] - b[i] - borrow;
+        r[i] = (uint64_t)d;
+        borrow = (uint64_t)(d >> 64) & 1;
+    }
+    return borrow;
+}
+
+static void addMod(u256 r, const u256 a, const u256 b, const u256 m) {
+    uint64_t carry = 0;
+    u256 s;
+    for(int i = 0; i < 4; i++) {
+        u128 t = (u128)a[i] + b[i] + carry;
+        s[i] = (uint64_t)t;
+        carry = (uint64_t)(t >> 64);
+    }
+    u256 d;
+    if(sub(d, s, m) <= carry) copy(r, d);
+    else copy(r, s);
+}
+
+static void subMod(u256 r, const u256 a, const u256 b, const u256 m) {
+    u256 d;
+    if(sub(d, a, b)) {
+        uint64_t carry = 0;
+        for(int i = 0; i < 4; i++) {
+            u128 t = (u128)d[i] + m[i] + carry;
+            d[i] = (uint64_t)t;
+            carry = (uint64_t)(t >> 64);
+        }
+    }
+    copy(r, d);
+}
+
+static void initModulus(Modulus &M, const u256 m) {
+    copy(M.m, m);
+    uint64_t x = m[0];
+    for(int i = 0; i < 5; i++) x *= 2 - m[0] * x;
+    M.inv = -x;
+    u256 r = {1, 0, 0, 0};
+    for(int i = 0; i < 512; i++) addMod(r, r, r, m);
+    copy(M.r2, r);
+}
+
+// a * b / 2^256 mod m, for a, b < m.
+static void montMul(u256 r, const u256 a, const u256 b, const Modulus &M) {
+    uint64_t t[6] = {0};
+    for(int i = 0; i < 4; i++) {
+        u128 c = 0;
+        for(int j = 0; j < 4; j++) {
+            c += (u128)a[j] * b[i] + t[j];
+            t[j] = (uint64_t)c;
+            c >>= 64;
+        }
+        c += t[4];
+        t[4] = (uint64_t)c;
+        t[5] = (uint64_t)(c >> 64);
+        uint64_t q = t[0] * M.inv;
+        c = ((u128)q * M.m[0] + t[0]) >> 64;
+        for(int j = 1; j < 4; j++) {
+            c += (u128)q * M.m[j] + t[j];
+            t[j - 1] = (uint64_t)c;
+            c >>= 64;
+        }
+        c += t[4];
+        t[3] = (uint64_t)c;
+        t[4] = t[5] + (uint64_t)(c >> 64);
+    }
+    u256 d;
+    if(sub(d, t, M.m) <= t[4]) copy(r, d);
+    else copy(r, t);
+}
+
+static void toMont(u256 r, const u256 a, const Modulus &M) { montMul(r, a, M.r2, M); }
+
+static void fromMont(u256 r, const u256 a, const Modulus &M) { montMul(r, a, kOne, M); }
+
+// a^(m-2), both in Montgomery form: the inverse, m being prime.
+static void invMont(u256 r, const u256 a, const Modulus &M) {
+    u256 e, two = {2, 0, 0, 0};
+    sub(e, M.m, two);
+    u256 x;
+    toMont(x, kOne, M);
+    for(int i = 255; i >= 0; i--) {
+        montMul(x, x, x, M);
+        if(e[i / 64] >> (i % 64) & 1) montMul(x, x, a, M);
+    }
+    copy(r, x);
+}
+
+// a * b mod m, plain in and out.
+static void mulMod(u256 r, const u256 a, const u256 b, const Modulus &M) {
+    montMul(r, a, b, M);
+    montMul(r, r, M.r2, M);
+}
+
+static Modulus fieldP, orderN;
+
+static void initCurve() {
+    static bool done;
+    if(done) return;
+    initModulus(fieldP, kP);
+    initModulus(orderN, kN);
+    done = true;
+}
+
+// Jacobian point, coordinates in Montgomery form mod p; Z == 0 is infinity.
+struct Jac {
+    u256 x, y, z;
+};
+
+static void jacDouble(Jac &r, const Jac &a) {
+    const Modulus &M = fieldP;
+    if(isZero(a.z)) { r = a; return; }
+    u256 delta, gamma, beta, alpha, t, u;
+    montMul(delta, a.z, a.z, M);
+    montMul(gamma, a.y, a.y, M);
+    montMul(beta, a.x, gamma, M);
+    subMod(t, a.x, delta, kP);
+    addMod(u, a.x, delta, kP);
+    montMul(alpha, t, u, M);
+    addMod(t, alpha, alpha, kP);
+    addMod(alpha, t, alpha, kP);                // 3 (x - delta)(x + delta): a = -3
+    Jac o;
+    addMod(t, a.y, a.z, kP);
+    montMul(t, t, t, M);
+    subMod(t, t, gamma, kP);
+    subMod(o.z, t, delta, kP);
+    addMod(beta, beta, beta, kP);
+    addMod(beta, beta, beta, kP);               // 4 beta
+    montMul(t, alpha, alpha, M);
+    addMod(u, beta, beta, kP);
+    subMod(o.x, t, u, kP);
+    subMod(t, beta, o.x, kP);
+    montMul(t, alpha, t, M);
+    montMul(u, gamma, gamma, M);
+    addMod(u, u, u, kP);
+    addMod(u, u, u, kP);
+    addMod(u, u, u, kP);                        // 8 gamma^2
+    subMod(o.y, t, u, kP);
+    r = o;
+}
+
+static void jacAdd(Jac &r, const Jac &a, const Jac &b) {
+    const Modulus &M = fieldP;
+    if(isZero(a.z)) { r = b; return; }
+    if(isZero(b.z)) { r = a; return; }
+    u256 z1z1, z2z2, u1, u2, s1, s2, h, rr, t;
+    montMul(z1z1, a.z, a.z, M);
+    montMul(z2z2, b.z, b.z, M);
+    montMul(u1, a.x, z2z2, M);
+    montMul(u2, b.x, z1z1, M);
+    montMul(t, b.z, z2z2, M);
+    montMul(s1, a.y, t, M);
+    montMul(t, a.z, z1z1, M);
+    montMul(s2, b.y, t, M);
+    subMod(h, u2, u1, kP);
+    subMod(rr, s2, s1, kP);
+    if(isZero(h)) {
+        if(isZero(rr)) { jacDouble(r, a); return; }
+        memset(&r, 0, sizeof(r));
+        return;
+    }
+    u256 hh, hhh, v;
+    montMul(hh, h, h, M);
+    montMul(hhh, h, hh, M);
+    montMul(v, u1, hh, M);
+    Jac o;
+    montMul(t, rr, rr, M);
+    subMod(t, t, hhh, kP);
+    subMod(t, t, v, kP);
+    subMod(o.x, t, v, kP);
+    subMod(t, v, o.x, kP);
+    montMul(t, rr, t, M);
+    montMul(s1, s1, hhh, M);
+    subMod(o.y, t, s1, kP);
+    montMul(t, a.z, b.z, M);
+    montMul(o.z, t, h, M);
+    r = o;
+}
+
+static void jacMul(Jac &r, const u256 k, const Jac &p) {
+    Jac acc;
+    memset(&acc, 0, sizeof(acc));
+    for(int i = 255; i >= 0; i--) {
+        jacDouble(acc, acc);
+        if(k[i / 64] >> (i % 64) & 1) jacAdd(acc, acc, p);
+    }
+    r = acc;
+}
+
+static void toJac(Jac &r, const mbedtls_ecp_point *p) {
+    if(isZero(p->Z.p)) { memset(&r, 0, sizeof(r)); return; }
+    toMont(r.x, p->X.p, fieldP);
+    toMont(r.y, p->Y.p, fieldP);
+    toMont(r.z, kOne, fieldP);
+}
+
+static void fromJac(mbedtls_ecp_point *r, const Jac &p) {
+    mbedtls_ecp_point_init(r);
+    if(isZero(p.z)) return;
+    u256 zi, zi2, t;
+    invMont(zi, p.z, fieldP);
+    montMul(zi2, zi, zi, fieldP);
+    montMul(t, p.x, zi2, fieldP);
+    fromMont(r->X.p, t, fieldP);
+    montMul(t, zi2, zi, fieldP);
+    montMul(t, p.y, t, fieldP);
+    fromMont(r->Y.p, t, fieldP);
+    r->Z.p[0] = 1;
+}
+
+void mbedtls_mpi_init(mbedtls_mpi *X) {
+    memset(X, 0, sizeof(*X));
+}
+
+void mbedtls_mpi_free(mbedtls_mpi *X) {
+    if(X) memset(X, 0, sizeof(*X));
+}
+
+int mbedtls_mpi_read_binary(mbedtls_mpi *X, const unsigned char *buf, size_t buflen) {
+    mbedtls_mpi_init(X);
+    for(size_t i = 0; i < buflen; i++) {
+        size_t bit = (buflen - 1 - i) * 8;
+        if(!buf[i]) continue;
+        if(bit >= 256) return MBEDTLS_ERR_MPI_BAD_INPUT_DATA;
+        X->p[bit / 64] |= (uint64_t)buf[i] << (bit % 64);
+    }
+    return 0;
+}
+
+int mbedtls_mpi_write_binary(const mbedtls_mpi *X, unsigned char *buf, size_t buflen) {
+    for(size_t i = 0; i < buflen; i++) {
+        size_t bit = (buflen - 1 - i) * 8;
+        buf[i] = bit < 256 ? (unsigned char)(X->p[bit / 64] >> (bit % 64)) : 0;
+    }
+    for(size_t bit = buflen * 8; bit < 256; bit += 8)
+        if(X->p[bit / 64] >> (bit % 64) & 0xFF) return MBEDTLS_ERR_MPI_BUFFER_TOO_SMALL;
+    return 0;
+}
+
+void mbedtls_ecp_group_init(mbedtls_ecp_group *grp) {
+    memset(grp, 0, sizeof(*grp));
+}
+
+void mbedtls_ecp_group_free(mbedtls_ecp_group *grp) {
+    if(grp) memset(grp, 0, sizeof(*grp));
+}
+
+int mbedtls_ecp_group_load(mbedtls_ecp_group *grp, mbedtls_ecp_group_id id) {
+    mbedtls_ecp_group_init(grp);
+    if(id != MBEDTLS_ECP_DP_SECP256R1) return MBEDTLS_ERR_ECP_FEATURE_UNAVAILABLE;
+    initCurve();
+    grp->id = id;
+    copy(grp->P.p, kP);
+    copy(grp->B.p, kB);
+    copy(grp->N.p, kN);
+    copy(grp->G.X.p, kGx);
+    copy(grp->G.Y.p, kGy);
+    grp->G.Z.p[0] = 1;
+    return 0;
+}
+
+void mbedtls_ecp_point_init(mbedtls_ecp_point *pt) {
+    memset(pt, 0, sizeof(*pt));
+}
+
+void mbedtls_ecp_point_free(mbedtls_ecp_point *pt) {
+    if(pt) memset(pt, 0, sizeof(*pt));
+}
+
+int mbedtls_ecp_point_read_binary(const mbedtls_ecp_group *grp, mbedtls_ecp_point *P,
+                                  const unsigned char *buf, size_t ilen) {
+    mbedtls_ecp_point_init(P);
+    if(grp->id != MBEDTLS_ECP_DP_SECP256R1) return MBEDTLS_ERR_ECP_FEATURE_UNAVAILABLE;
+    if(ilen == 1 && buf[0] == 0) return 0;
+    if(ilen != 65) return MBEDTLS_ERR_ECP_BAD_INPUT_DATA;
+    if(buf[0] != 0x04) return MBEDTLS_ERR_ECP_FEATURE_UNAVAILABLE;
+    mbedtls_mpi_read_binary(&P->X, buf + 1, 32);
+    mbedtls_mpi_read_binary(&P->Y, buf + 33, 32);
+    P->Z.p[0] = 1;
+    return 0;
+}
+
+int mbedtls_ecp_point_write_binary(const mbedtls_ecp_group *grp, const mbedtls_ecp_point *P,
+                                   int format, size_t *olen, unsigned char *buf, size_t buflen) {
+    if(grp->id != MBEDTLS_ECP_DP_SECP256R1 || format != MBEDTLS_ECP_PF_UNCOMPRESSED)
+        return MBEDTLS_ERR_ECP_BAD_INPUT_DATA;
+    *olen = isZero(P->Z.p) ? 1 : 65;
+    if(buflen < *olen) return MBEDTLS_ERR_ECP_BUFFER_TOO_SMALL;
+    if(*olen == 1) { buf[0] = 0; return 0; }
+    buf[0] = 0x04;
+    mbedtls_mpi_write_binary(&P->X, buf + 1, 32);
+    mbedtls_mpi_write_binary(&P->Y, buf + 33, 32);
+    return 0;
+}
+
+// y^2 == x^3 - 3x + b with both coordinates below p.
+int mbedtls_ecp_check_pubkey(const mbedtls_ecp_group *grp, const mbedtls_ecp_point *pt) {
+    if(grp->id != MBEDTLS_ECP_DP_SECP256R1) return MBEDTLS_ERR_ECP_BAD_INPUT_DATA;
+    if(pt->Z.p[0] != 1 || compare(pt->X.p, kP) >= 0 || compare(pt->Y.p, kP) >= 0)
+        return MBEDTLS_ERR_ECP_INVALID_KEY;
+    const Modulus &M = fieldP;
+    u256 x, y, l, r, t;
+    toMont(x, pt->X.p, M);
+    toMont(y, pt->Y.p, M);
+    montMul(l, y, y, M);
+    montMul(r, x, x, M);
+    montMul(r, r, x, M);
+    addMod(t, x, x, kP);
+    addMod(t, t, x, kP);
+    subMod(r, r, t, kP);
+    toMont(t, kB, M);
+    addMod(r, r, t, kP);
+    return compare(l, r) == 0 ? 0 : MBEDTLS_ERR_ECP_INVALID_KEY;
+}
+
+int mbedtls_ecp_mul(mbedtls_ecp_group *grp, mbedtls_ecp_point *R, const mbedtls_mpi *m,
+                    const mbedtls_ecp_point *P,
+                    int (*)(void *, unsigned char *, size_t), void *) {
+    if(grp->id != MBEDTLS_ECP_DP_SECP256R1) return MBEDTLS_ERR_ECP_BAD_INPUT_DATA;
+    Jac p, r;
+    toJac(p, P);
+    jacMul(r, m->p, p);
+    fromJac(R, r);
+    return 0;
+}
+
+// The leftmost 256 bits of the hash, reduced mod n.
+static void hashToScalar(u256 e, const unsigned char *buf, size_t blen) {
+    mbedtls_mpi h;
+    mbedtls_mpi_read_binary(&h, buf, blen < 32 ? blen : 32);
+    copy(e, h.p);
+    if(compare(e, kN) >= 0) sub(e, e, kN);
+}
+
+int mbedtls_ecdsa_sign(mbedtls_ecp_group *grp, mbedtls_mpi *r, mbedtls_mpi *s,
+                       const mbedtls_mpi *d, const unsigned char *buf, size_t blen,
+                       int (*f_rng)(void *, unsigned char *, size_t), void *p_rng) {
+    if(grp->id != MBEDTLS_ECP_DP_SECP256R1 || !f_rng) return MBEDTLS_ERR_ECP_BAD_INPUT_DATA;
+    if(isZero(d->p) || compare(d->p, kN) >= 0) return MBEDTLS_ERR_ECP_INVALID_KEY;
+    u256 e;
+    hashToScalar(e, buf, blen);
+    for(int tries = 0; tries < 10; tries++) {
+        unsigned char kb[32];
+        if(f_rng(p_rng, kb, sizeof(kb))) return MBEDTLS_ERR_ECP_RANDOM_FAILED;
+        mbedtls_mpi k;
+        mbedtls_mpi_read_binary(&k, kb, sizeof(kb));
+        if(isZero(k.p) || compare(k.p, kN) >= 0) continue;
+        Jac g, kg;
+        toJac(g, &grp->G);
+        jacMul(kg, k.p, g);
+        mbedtls_ecp_point R;
+        fromJac(&R, kg);
+        mbedtls_mpi_init(r);
+        copy(r->p, R.X.p);
+        if(compare(r->p, kN) >= 0) sub(r->p, r->p, kN);
+        if(isZero(r->p)) continue;
+        // s = (e + r d) / k mod n
+        u256 t, ki;
+        mulMod(t, r->p, d->p, orderN);
+        addMod(t, t, e, kN);
+        toMont(ki, k.p, orderN);
+        invMont(ki, ki, orderN);
+        fromMont(ki, ki, orderN);
+        mbedtls_mpi_init(s);
+        mulMod(s->p, t, ki, orderN);
+        if(!isZero(s->p)) return 0;
+    }
+    return MBEDTLS_ERR_ECP_RANDOM_FAILED;
+}
+
+int mbedtls_ecdsa_verify(mbedtls_ecp_group *grp, const unsigned char *buf, size_t blen,
+                         const mbedtls_ecp_point *Q, const mbedtls_mpi *r, const mbedtls_mpi *s) {
+    if(grp->id != MBEDTLS_ECP_DP_SECP256R1) return MBEDTLS_ERR_ECP_BAD_INPUT_DATA;
+    if(isZero(r->p) || compare(r->p, kN) >= 0 || isZero(s->p) || compare(s->p, kN) >= 0)
+        return MBEDTLS_ERR_ECP_VERIFY_FAILED;
+    if(mbedtls_ecp_check_pubkey(grp, Q)) return MBEDTLS_ERR_ECP_INVALID_KEY;
+    u256 e, w, u1, u2;
+    hashToScalar(e, buf, blen);
+    toMont(w, s->p, orderN);
+    invMont(w, w, orderN);
+    fromMont(w, w, orderN);
+    mulMod(u1, e, w, orderN);
+    mulMod(u2, r->p, w, orderN);
+    Jac g, q, a, b;
+    toJac(g, &grp->G);
+    toJac(q, Q);
+    jacMul(a, u1, g);
+    jacMul(b, u2, q);
+    jacAdd(a, a, b);
+    mbedtls_ecp_point R;
+    fromJac(&R, a);
+    if(isZero(R.Z.p)) return MBEDTLS_ERR_ECP_VERIFY_FAILED;
+    if(compare(R.X.p, kN) >= 0) sub(R.X.p, R.X.p, kN);
+    return compare(R.X.p, r->p) == 0 ? 0 : MBEDTLS_ERR_ECP_VERIFY_FAILED;
+}
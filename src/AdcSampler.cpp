@@ -0,0 +1,100 @@
+#include "AdcSampler.h"
+#include "Metrics.h"
+#include "driver/adc.h"
+
+static const uint32_t kFrameSamples = 256;      // conversions per DMA interrupt
+static const uint32_t kFrameBytes = kFrameSamples * 4;
+static const uint32_t kPoolBytes = 4 * kFrameBytes;
+
+static AdcDecimator decimator;
+static bool running;
+static std::atomic<uint32_t> overruns{0};
+
+void AdcDecimator::begin(uint8_t ch) {
+    channel = ch;
+    sum = 0;
+    count = 0;
+    smooth = 0;
+    latest = -1;
+    sampleCount = 0;
+    blockCount = 0;
+}
+
+void AdcDecimator::feed(const uint8_t *data, size_t len) {
+    uint32_t taken = 0;
+    for(size_t i = 0; i + 4 <= len; i += 4) {
+        uint32_t w = data[i] | (data[i + 1] << 8) | (data[i + 2] << 16) | ((uint32_t)data[i + 3] << 24);
+        if(((w >> 13) & 0x1F) != channel) continue;     // other channel or ADC2
+        sum += w & 0xFFF;
+        taken++;
+        if(++count < kAdcDecimation) continue;
+        // 512 conversions sum to at most 21 bits; keep 16 of them.
+        uint32_t v = sum >> 5;
+        sum = 0;
+        count = 0;
+        if(latest < 0) smooth = v << kAdcSmoothShift;
+        else smooth += v - (smooth >> kAdcSmoothShift);
+        latest = smooth >> kAdcSmoothShift;
+        blockCount++;
+    }
+    sampleCount += taken;
+}
+
+bool AdcDecimator::value(uint16_t &v) const {
+    int32_t x = latest;
+    if(x < 0) return false;
+    v = x;
+    return true;
+}
+
+static void samplerTask(void*) {
+    static uint8_t frame[kFrameBytes];
+    for(;;) {
+        uint32_t got = 0;
+        esp_err_t err = adc_digi_read_bytes(frame, sizeof(frame), &got, ADC_MAX_DELAY);
+        // INVALID_STATE: the pool overflowed and conversions were lost, but
+        // what was read is good.
+        if(err == ESP_ERR_INVALID_STATE) overruns++;
+        if(err == ESP_OK || err == ESP_ERR_INVALID_STATE) decimator.feed(frame, got);
+    }
+}
+
+bool adcSamplerBegin(uint8_t pin) {
+    if(running) return true;
+    int8_t ch = digitalPinToAnalogChannel(pin);
+    if(ch < 0 || ch >= 10) return false;            // ADC2 is shared with Wi-Fi
+    adc_digi_init_config_t init = {};
+    init.max_store_buf_size = kPoolBytes;
+    init.conv_num_each_intr = kFrameBytes;
+    init.adc1_chan_mask = 1u << ch;
+    if(adc_digi_initialize(&init) != ESP_OK) return false;
+    adc_digi_pattern_config_t pattern = {};
+    pattern.atten = ADC_ATTEN_DB_11;                // 0..3.1 V, as analogRead()
+    pattern.channel = ch;
+    pattern.unit = 0;
+    pattern.bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+    adc_digi_configuration_t cfg = {};
+    cfg.pattern_num = 1;
+    cfg.adc_pattern = &pattern;
+    cfg.sample_freq_hz = kAdcSampleHz;
+    cfg.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+    cfg.format = ADC_DIGI_OUTPUT_FORMAT_TYPE2;
+    decimator.begin(ch);
+    if(adc_digi_controller_configure(&cfg) != ESP_OK || adc_digi_start() != ESP_OK) {
+        adc_digi_deinitialize();
+        return false;
+    }
+    running = true;
+    TaskHandle_t task = nullptr;
+    xTaskCreatePinnedToCore(samplerTask, "adc", 2048, nullptr, 1, &task, 1);
+    metricsWatchTask("adc", task);
+    return true;
+}
+
+bool adcSamplerValue(uint16_t &value) {
+    return running && decimator.value(value);
+}
+
+AdcSamplerStats adcSamplerStats() {
+    return {decimator.samples(), decimator.blocks(), overruns.load()};
+}
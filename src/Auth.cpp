@@ -0,0 +1,189 @@
+#include "Auth.h"
+#include "Config.h"
+#include <esp_system.h>
+#include "mbedtls/sha256.h"
+#include "mbedtls/base64.h"
+
+static const uint8_t kCacheSize = 4;
+static const uint32_t kCacheMs = 300000;
+static const size_t kMaxBasic = 128;            // longest "Basic ..." value accepted
+
+struct CacheEntry {
+    uint64_t tag;           // SipHash of the whole header value
+    uint32_t verifiedMs;
+    bool used;
+};
+
+static uint64_t sipKey[2];
+static CacheEntry cache[kCacheSize];
+static bool keysReady;
+
+static bool equalsConst(const void *a, const void *b, size_t len) {
+    const uint8_t *x = (const uint8_t*)a, *y = (const uint8_t*)b;
+    uint8_t diff = 0;
+    for(size_t i = 0; i < len; i++) diff |= x[i] ^ y[i];
+    return diff == 0;
+}
+
+static void toHex(const uint8_t *in, size_t len, char *out) {
+    static const char digits[] = "0123456789abcdef";
+    for(size_t i = 0; i < len; i++) {
+        out[i * 2] = digits[in[i] >> 4];
+        out[i * 2 + 1] = digits[in[i] & 15];
+    }
+    out[len * 2] = 0;
+}
+
+static inline uint64_t rotl(uint64_t x, int b) {
+    return (x << b) | (x >> (64 - b));
+}
+
+// SipHash-2-4: a keyed hash made for short inputs.  Without the key, a
+// header whose tag matches a cached one, or a token, cannot be forged.
+static uint64_t sipHash(const uint8_t *in, size_t len) {
+    uint64_t v0 = 0x736f6d6570736575ULL ^ sipKey[0], v1 = 0x646f72616e646f6dULL ^ sipKey[1];
+    uint64_t v2 = 0x6c7967656e657261ULL ^ sipKey[0], v3 = 0x7465646279746573ULL ^ sipKey[1];
+    auto round = [&]() {
+        v0 += v1; v1 = rotl(v1, 13); v1 ^= v0; v0 = rotl(v0, 32);
+        v2 += v3; v3 = rotl(v3, 16); v3 ^= v2;
+        v0 += v3; v3 = rotl(v3, 21); v3 ^= v0;
+        v2 += v1; v1 = rotl(v1, 17); v1 ^= v2; v2 = rotl(v2, 32);
+    };
+    size_t i = 0;
+    for(; i + 8 <= len; i += 8) {
+        uint64_t m = 0;
+        for(int j = 0; j < 8; j++) m |= (uint64_t)in[i + j] << (8 * j);
+        v3 ^= m; round(); round(); v0 ^= m;
+    }
+    uint64_t m = (uint64_t)len << 56;
+    for(int j = 0; i + j < len; j++) m |= (uint64_t)in[i + j] << (8 * j);
+    v3 ^= m; round(); round(); v0 ^= m;
+    v2 ^= 0xff;
+    round(); round(); round(); round();
+    return v0 ^ v1 ^ v2 ^ v3;
+}
+
+void authReset() {
+    esp_fill_random(sipKey, sizeof(sipKey));
+    memset(cache, 0, sizeof(cache));
+    keysReady = true;
+}
+
+// Draw the keys on first use rather than at boot: the RNG is only fully
+// random once the radio is running.
+static void ensureKeys() {
+    if(!keysReady) authReset();
+}
+
+// Hex SipHash tag of the token's 8-character expiry field.  Cached Basic
+// headers are longer than 8 bytes, and the length is part of the hash.
+static void tokenTag(const char *expiry, char hex[17]) {
+    uint64_t tag = sipHash((const uint8_t*)expiry, 8);
+    uint8_t bytes[8];
+    for(int i = 0; i < 8; i++) bytes[i] = tag >> (8 * i);
+    toHex(bytes, sizeof(bytes), hex);
+}
+
+static uint32_t uptimeSec() {
+    return millis() / 1000;
+}
+
+void authIssue(char *token) {
+    ensureKeys();
+    snprintf(token, 10, "%08lx.", (unsigned long)(uptimeSec() + kSessionSec));
+    tokenTag(token, token + 9);
+}
+
+// A token of exactly kTokenLen characters at ``t`` with a valid tag that
+// has not expired.
+static bool tokenValid(const char *t, size_t len) {
+    if(len != kTokenLen || t[8] != '.') return false;
+    char expiry[9];
+    memcpy(expiry, t, 8);
+    expiry[8] = 0;
+    char *end;
+    uint32_t exp = strtoul(expiry, &end, 16);
+    if(*end) return false;
+    char tag[17];
+    tokenTag(expiry, tag);
+    if(!equalsConst(tag, t + 9, 16)) return false;
+    int32_t left = (int32_t)(exp - uptimeSec());
+    return left > 0 && left <= (int32_t)kSessionSec;
+}
+
+// The value of the ``session`` cookie, or nullptr.
+static const char *sessionCookie(const char *cookies, size_t &len) {
+    for(const char *p = cookies; (p = strstr(p, "session=")); p += 8) {
+        if(p != cookies && p[-1] != ' ' && p[-1] != ';') continue;
+        p += 8;
+        len = strcspn(p, ";");
+        return p;
+    }
+    return nullptr;
+}
+
+void authHashPassword(const char *pwd, char hex[65]) {
+    uint8_t hash[32];
+    mbedtls_sha256_ret((const uint8_t*)pwd, strlen(pwd), hash, 0);
+    toHex(hash, sizeof(hash), hex);
+}
+
+bool authVerify(const char *user, const char *pass) {
+    if(strcmp(user, settings.uiUser) != 0) return false;
+    char hex[65];
+    authHashPassword(pass, hex);
+    return equalsConst(hex, settings.uiPass, 64);
+}
+
+static bool checkBasic(const char *value, size_t len) {
+    uint64_t tag = sipHash((const uint8_t*)value, len);
+    uint32_t now = millis();
+    // Look at every entry so the time taken does not tell which one matched.
+    bool hit = false;
+    for(uint8_t i = 0; i < kCacheSize; i++) {
+        bool live = cache[i].used && now - cache[i].verifiedMs < kCacheMs;
+        hit |= live & equalsConst(&cache[i].tag, &tag, sizeof(tag));
+    }
+    if(hit) return true;
+
+    unsigned char decoded[kMaxBasic];
+    size_t outLen = 0;
+    if(mbedtls_base64_decode(decoded, sizeof(decoded) - 1, &outLen,
+                             (const unsigned char*)value + 6, len - 6) != 0)
+        return false;
+    decoded[outLen] = 0;
+    char *sep = strchr((char*)decoded, ':');
+    if(!sep || sep == (char*)decoded) return false;
+    *sep = 0;
+    bool ok = authVerify((char*)decoded, sep + 1);
+    memset(decoded, 0, sizeof(decoded));
+    if(!ok) return false;
+
+    // Replace a free or the oldest entry.
+    uint8_t slot = 0;
+    for(uint8_t i = 0; i < kCacheSize; i++) {
+        if(!cache[i].used) {
+            slot = i;
+            break;
+        }
+        if(now - cache[i].verifiedMs > now - cache[slot].verifiedMs) slot = i;
+    }
+    cache[slot] = {tag, now, true};
+    return true;
+}
+
+bool authCheck(AsyncWebServerRequest *req) {
+    ensureKeys();
+    // header() by C string returns an empty value when absent and, unlike
+    // hasHeader(), builds no String for the name.
+    const String &value = req->header("Authorization");
+    const char *v = value.c_str();
+    size_t len = value.length();
+    if(len > 7 && strncmp(v, "Bearer ", 7) == 0) return tokenValid(v + 7, len - 7);
+    // The web UI sends both its session cookie and the Basic header the
+    // browser keeps; the cookie is the cheaper check.
+    size_t tokenLen = 0;
+    const char *t = sessionCookie(req->header("Cookie").c_str(), tokenLen);
+    if(t && tokenValid(t, tokenLen)) return true;
+    return len > 6 && len <= kMaxBasic && strncmp(v, "Basic ", 6) == 0 && checkBasic(v, len);
+}
@@ -0,0 +1,151 @@
+#include "ClogDetect.h"
+#include "Config.h"
+
+static const float kLevelGain = 0.5f;       // Holt smoothing of the distance
+static const float kTrendGain = 0.3f;       // and of its slope, both per kGainStepMin
+static const float kGainStepMin = 10;       // the default lidar period
+static const float kBaseGain = 0.05f;       // baselines follow quiet reads this fast
+static const float kMinRate = 0.05f;        // mm/min; a slower fall is no trend
+static const float kMinStepMin = 1 / 60.0f; // reads closer together count as this far apart
+static const float kReadsAhead = 10;        // reads wanted before ClogMin at the fill rate
+
+static float level = NAN;       // Holt estimate, mm
+static float trend;             // mm/min, negative while filling
+static float lastRead = NAN;
+static float recent[3];         // last raw reads, for the median
+static uint8_t recentCount;
+static uint32_t lastMs;
+static float base;              // empty-chute distance
+static float lidarSum;
+static float presBase = NAN;
+static float presSum;
+static uint8_t below;           // consecutive reads under clogMin
+static ClogLevel grade = CLOG_CLEAR;
+static ClogStatus shared = {CLOG_CLEAR, NAN, NAN, 0, INFINITY, 0, 0};
+static portMUX_TYPE statusMux = portMUX_INITIALIZER_UNLOCKED;
+
+static float median3(float a, float b, float c) {
+    return max(min(a, b), min(max(a, b), c));
+}
+
+// The median of the last three reads, which drops a lone spike (a bird,
+// a bag in flight) and lets a steady fill through one read late.
+static float despike(float mm) {
+    recent[recentCount % 3] = mm;
+    if(++recentCount < 3) return mm;
+    if(recentCount == 6) recentCount = 3;
+    return median3(recent[0], recent[1], recent[2]);
+}
+
+static float etaMin(uint16_t clogMin) {
+    if(isnan(level) || -trend < kMinRate) return INFINITY;
+    return level <= clogMin ? 0 : (level - clogMin) / -trend;
+}
+
+// Grade the current state and publish it.  True when the grade changed.
+static bool evaluate(const Settings &cfg) {
+    const ClogDetectSettings &d = cfg.detect;
+    float eta = etaMin(cfg.clogMin);
+    ClogLevel next;
+    if(below && below >= cfg.clogHold) {
+        next = CLOG_BLOCKED;
+    } else {
+        bool lidarHit = lidarSum >= d.alarmMm;
+        bool presHit = presSum >= d.alarmPa && -trend >= kMinRate;
+        bool held = grade != CLOG_CLEAR &&
+                    (lidarSum >= d.alarmMm / 2.0f || presSum >= d.alarmPa / 2);
+        if(!lidarHit && !presHit && !held) {
+            next = CLOG_CLEAR;
+        } else {
+            // A quarter more horizon to leave PREDICTED, so a noisy ETA
+            // near the horizon does not flip the grade on every read.
+            float horizon = d.horizonMin * (grade >= CLOG_PREDICTED ? 1.25f : 1.0f);
+            next = eta <= horizon ? CLOG_PREDICTED : CLOG_FILLING;
+        }
+    }
+    bool changed = next != grade;
+    grade = next;
+    ClogStatus s = {grade, lastRead, level, -trend, eta, lidarSum, presSum};
+    portENTER_CRITICAL(&statusMux);
+    shared = s;
+    portEXIT_CRITICAL(&statusMux);
+    return changed;
+}
+
+void clogReset() {
+    level = NAN;
+    trend = 0;
+    lastRead = NAN;
+    recentCount = 0;
+    lidarSum = 0;
+    presBase = NAN;
+    presSum = 0;
+    below = 0;
+    grade = CLOG_CLEAR;
+    evaluate(*SettingsRef());
+}
+
+bool clogAddLidar(uint32_t ms, float read) {
+    SettingsRef cfg;
+    const ClogDetectSettings &d = cfg->detect;
+    float mm = despike(read);
+    if(isnan(level)) {
+        level = mm;
+        trend = 0;
+        base = mm;
+    } else {
+        // Scale the gains to the time since the last read, so that the
+        // smoothing per minute stays the same when the cadence changes.
+        float dt = max((ms - lastMs) / 60000.0f, kMinStepMin);
+        float a = 1 - powf(1 - kLevelGain, dt / kGainStepMin);
+        float b = 1 - powf(1 - kTrendGain, dt / kGainStepMin);
+        float prev = level;
+        level = a * mm + (1 - a) * (level + trend * dt);
+        trend = b * (level - prev) / dt + (1 - b) * trend;
+    }
+    lastMs = ms;
+    lastRead = read;
+
+    float step = min(base - mm - d.driftMm, d.alarmMm / 3.0f);
+    lidarSum = constrain(lidarSum + step, 0.0f, (float)d.alarmMm);
+    // The baseline climbs by at most the drift per read, so a spurious
+    // long read cannot lift it far; it sinks only on reads that look like
+    // noise, or filling would be learnt as the new empty chute.
+    if(mm > base) base += min(mm - base, (float)d.driftMm);
+    else if(grade == CLOG_CLEAR && lidarSum == 0) base += kBaseGain * (mm - base);
+
+    if(read >= cfg->clogMin) below = 0;
+    else if(below < UINT8_MAX) below++;
+    return evaluate(*cfg);
+}
+
+bool clogAddPressure(float pa) {
+    if(isnan(pa)) return false;
+    SettingsRef cfg;
+    const ClogDetectSettings &d = cfg->detect;
+    if(isnan(presBase)) presBase = pa;
+    float step = min(fabsf(pa - presBase) - d.driftPa, d.alarmPa / 2);
+    presSum = constrain(presSum + step, 0.0f, d.alarmPa);
+    if(grade == CLOG_CLEAR && presSum == 0) presBase += kBaseGain * (pa - presBase);
+    return evaluate(*cfg);
+}
+
+uint32_t clogSamplePeriodMs(uint32_t fastMs, uint32_t slowMs) {
+    fastMs = min(fastMs, slowMs);
+    if(isnan(level)) return slowMs;
+    uint16_t clogMin = SettingsRef()->clogMin;
+    // In proportion to the room left between the empty chute and ClogMin...
+    float span = base - clogMin;
+    float period = span > 0 ? slowMs * constrain((level - clogMin) / span, 0.0f, 1.0f) : 0;
+    // ...and short enough for several reads before the fill rate gets there.
+    float eta = etaMin(clogMin);
+    if(eta < INFINITY) period = min(period, eta * 60000 / kReadsAhead);
+    return constrain((uint32_t)period, fastMs, slowMs);
+}
+
+ClogStatus clogStatus() {
+    portENTER_CRITICAL(&statusMux);
+    ClogStatus s = shared;
+    portEXIT_CRITICAL(&statusMux);
+    return s;
+}
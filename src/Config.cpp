@@ -1,11 +1,54 @@
 #include "Config.h"
+#include "Crc.h"
 #include <Preferences.h>
+#include <atomic>
 
 Settings settings;
 Preferences prefs;
 
-void loadSettings() {
-    prefs.begin("config", true);
+// Layout version of the blob.  Fields are only ever appended to Settings,
+// and a shorter blob leaves the later fields at their defaults, so adding
+// a field needs no bump; change the version when a field moves or changes
+// meaning, and convert the old layout in loadSettings().
+static const uint16_t kSettingsVersion = 1;
+static const uint32_t kSaveDelayMs = 2000;
+static const char *kBlobKey = "blob";
+static const uint8_t kMaxListeners = 8;
+
+struct BlobHeader {
+    uint16_t version;
+    uint16_t len;           // bytes of Settings that follow
+    uint32_t crc;           // CRC-32 of those bytes
+};
+
+struct Blob {
+    BlobHeader h;
+    Settings s;
+};
+
+static Settings stored;                 // as last written to NVS
+static Settings pending;                // snapshot taken by scheduleSave()
+static bool dirty;
+static uint32_t dirtyMs;
+static portMUX_TYPE saveMux = portMUX_INITIALIZER_UNLOCKED;
+
+// Published snapshots: ``current`` is the one new readers pin; the other
+// is rewritten by the next commit once its reader count drops to zero.
+static Settings snapshots[2];
+static std::atomic<uint32_t> current(0);
+static std::atomic<uint32_t> readers[2];
+
+struct Listener {
+    uint32_t sections;
+    SettingsListener fn;
+};
+static Listener listeners[kMaxListeners];
+static uint8_t listenerCount;
+
+// Per-key layout written before the blob existed.  Kept as the migration
+// source; the keys are left in place so that older firmware still boots
+// with the same settings after a downgrade.
+static void loadLegacy() {
     prefs.getString("siteName", settings.siteName, sizeof(settings.siteName));
     prefs.getString("wifiSSID", settings.wifiSSID, sizeof(settings.wifiSSID));
     prefs.getString("wifiPass", settings.wifiPass, sizeof(settings.wifiPass));
@@ -14,6 +57,8 @@ void loadSettings() {
     prefs.getString("mqttUser", settings.mqttUser, sizeof(settings.mqttUser));
     prefs.getString("mqttPass", settings.mqttPass, sizeof(settings.mqttPass));
     settings.mqttQos = prefs.getUChar("mqttQos", settings.mqttQos);
+    settings.mqttFormat = prefs.getUChar("mqttFormat", settings.mqttFormat);
+    settings.bufSpillSec = prefs.getUShort("bufSpillSec", settings.bufSpillSec);
     prefs.getString("uiUser", settings.uiUser, sizeof(settings.uiUser));
     prefs.getString("uiPass", settings.uiPass, sizeof(settings.uiPass));
     settings.debugEnable = prefs.getBool("debugEnable", settings.debugEnable);
@@ -29,33 +74,141 @@ void loadSettings() {
     settings.thr.presMax  = prefs.getFloat("presMax", settings.thr.presMax);
     settings.clogMin = prefs.getUShort("clogMin", settings.clogMin);
     settings.clogHold = prefs.getUChar("clogHold", settings.clogHold);
-    prefs.end();
+    settings.envPeriodSec = prefs.getUShort("envPeriod", settings.envPeriodSec);
+    settings.lidarPeriodSec = prefs.getUShort("lidarPeriod", settings.lidarPeriodSec);
+    settings.scan.xMin = prefs.getUChar("scanXMin", settings.scan.xMin);
+    settings.scan.xMax = prefs.getUChar("scanXMax", settings.scan.xMax);
+    settings.scan.yMin = prefs.getUChar("scanYMin", settings.scan.yMin);
+    settings.scan.yMax = prefs.getUChar("scanYMax", settings.scan.yMax);
+    settings.scan.cols = prefs.getUChar("scanCols", settings.scan.cols);
+    settings.scan.rows = prefs.getUChar("scanRows", settings.scan.rows);
+    settings.scan.periodMin = prefs.getUShort("scanPeriod", settings.scan.periodMin);
 }
 
-void saveSettings() {
+// Read the blob into ``settings``.  False when it is missing, torn or of
+// a layout this firmware does not know.
+static bool loadBlob() {
+    static Blob b;
+    size_t n = prefs.getBytes(kBlobKey, &b, sizeof(b));
+    if(n < sizeof(BlobHeader) || b.h.version != kSettingsVersion ||
+       b.h.len > sizeof(Settings) || n != sizeof(BlobHeader) + b.h.len ||
+       crc32Update(0, &b.s, b.h.len) != b.h.crc)
+        return false;
+    memcpy(&settings, &b.s, b.h.len);
+    return true;
+}
+
+static void writeBlob(const Settings &s) {
+    static Blob b;
+    b.h = {kSettingsVersion, (uint16_t)sizeof(Settings), crc32Update(0, &s, sizeof(Settings))};
+    b.s = s;
     prefs.begin("config", false);
-    prefs.putString("siteName", settings.siteName);
-    prefs.putString("wifiSSID", settings.wifiSSID);
-    prefs.putString("wifiPass", settings.wifiPass);
-    prefs.putString("mqttHost", settings.mqttHost);
-    prefs.putUShort("mqttPort", settings.mqttPort);
-    prefs.putString("mqttUser", settings.mqttUser);
-    prefs.putString("mqttPass", settings.mqttPass);
-    prefs.putUChar("mqttQos", settings.mqttQos);
-    prefs.putString("uiUser", settings.uiUser);
-    prefs.putString("uiPass", settings.uiPass);
-    prefs.putBool("debugEnable", settings.debugEnable);
-    prefs.putFloat("lidarMin", settings.thr.lidarMin);
-    prefs.putFloat("lidarMax", settings.thr.lidarMax);
-    prefs.putFloat("smokeMin", settings.thr.smokeMin);
-    prefs.putFloat("smokeMax", settings.thr.smokeMax);
-    prefs.putFloat("eco2Min", settings.thr.eco2Min);
-    prefs.putFloat("eco2Max", settings.thr.eco2Max);
-    prefs.putFloat("tvocMin", settings.thr.tvocMin);
-    prefs.putFloat("tvocMax", settings.thr.tvocMax);
-    prefs.putFloat("presMin", settings.thr.presMin);
-    prefs.putFloat("presMax", settings.thr.presMax);
-    prefs.putUShort("clogMin", settings.clogMin);
-    prefs.putUChar("clogHold", settings.clogHold);
+    prefs.putBytes(kBlobKey, &b, sizeof(b));
+    prefs.end();
+}
+
+// Snapshot ``settings`` for settingsFlush().
+static void scheduleSave() {
+    portENTER_CRITICAL(&saveMux);
+    pending = settings;
+    dirty = true;
+    dirtyMs = millis();
+    portEXIT_CRITICAL(&saveMux);
+}
+
+template<class T> static bool differs(const T &a, const T &b) {
+    return memcmp(&a, &b, sizeof(T)) != 0;
+}
+
+static uint32_t changedSections(const Settings &a, const Settings &b) {
+    uint32_t m = 0;
+    if(differs(a.siteName, b.siteName)) m |= SET_SITE;
+    if(differs(a.wifiSSID, b.wifiSSID) || differs(a.wifiPass, b.wifiPass)) m |= SET_WIFI;
+    if(differs(a.mqttHost, b.mqttHost) || a.mqttPort != b.mqttPort ||
+       differs(a.mqttUser, b.mqttUser) || differs(a.mqttPass, b.mqttPass) ||
+       a.mqttQos != b.mqttQos)
+        m |= SET_BROKER;
+    if(a.mqttFormat != b.mqttFormat || a.bufSpillSec != b.bufSpillSec ||
+       a.debugEnable != b.debugEnable)
+        m |= SET_PUBLISH;
+    if(differs(a.uiUser, b.uiUser) || differs(a.uiPass, b.uiPass)) m |= SET_UI;
+    if(differs(a.thr, b.thr) || a.clogMin != b.clogMin || a.clogHold != b.clogHold ||
+       differs(a.detect, b.detect))
+        m |= SET_THRESHOLDS;
+    if(a.envPeriodSec != b.envPeriodSec || a.lidarPeriodSec != b.lidarPeriodSec ||
+       a.lidarFastSec != b.lidarFastSec)
+        m |= SET_PERIODS;
+    if(differs(a.scan, b.scan)) m |= SET_SCAN;
+    return m;
+}
+
+uint8_t settingsPin() {
+    for(;;) {
+        uint32_t slot = current.load();
+        readers[slot].fetch_add(1);
+        // A commit may have made the other slot current in between and
+        // already be rewriting this one; then try again.
+        if(current.load() == slot) return slot;
+        readers[slot].fetch_sub(1);
+    }
+}
+
+void settingsUnpin(uint8_t slot) {
+    readers[slot].fetch_sub(1);
+}
+
+const Settings &settingsSnapshot(uint8_t slot) {
+    return snapshots[slot];
+}
+
+// Copy ``settings`` into the idle snapshot and make it current.  Readers
+// still on the idle one from before the last switch are waited out.
+static void publish() {
+    uint32_t next = current.load() ^ 1;
+    while(readers[next].load()) vTaskDelay(1);
+    snapshots[next] = settings;
+    current.store(next);
+}
+
+bool settingsSubscribe(uint32_t sections, SettingsListener fn) {
+    if(listenerCount >= kMaxListeners) return false;
+    listeners[listenerCount++] = {sections, fn};
+    return true;
+}
+
+uint32_t settingsCommit() {
+    uint32_t cur = current.load();
+    uint32_t changed = changedSections(snapshots[cur], settings);
+    if(!changed) return 0;
+    publish();
+    scheduleSave();
+    for(uint8_t i = 0; i < listenerCount; i++)
+        if(listeners[i].sections & changed) listeners[i].fn(changed);
+    return changed;
+}
+
+void loadSettings() {
+    prefs.begin("config", true);
+    bool ok = loadBlob();
+    if(!ok) loadLegacy();
     prefs.end();
+    if(!ok) writeBlob(settings);
+    stored = settings;
+    publish();
+}
+
+void settingsService() {
+    if(dirty && millis() - dirtyMs >= kSaveDelayMs) settingsFlush();
+}
+
+void settingsFlush() {
+    static Settings snap;
+    portENTER_CRITICAL(&saveMux);
+    bool was = dirty;
+    snap = pending;
+    dirty = false;
+    portEXIT_CRITICAL(&saveMux);
+    if(!was || memcmp(&snap, &stored, sizeof(Settings)) == 0) return;
+    writeBlob(snap);
+    stored = snap;
 }
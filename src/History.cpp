@@ -0,0 +1,515 @@
+#include "History.h"
+#include "Crc.h"
+#include <LittleFS.h>
+
+// On-flash layout, one directory per tier:
+//   /hist/<tier>/<seq>   segment files of back-to-back sealed blocks,
+//                        <seq> is 8 hex digits and only grows
+//   /hist/<tier>/open    OpenState and payload of the unsealed block
+// A block is a BlockHeader followed by ``len`` bytes of rows.  A row is
+//   varint  seconds since the previous row (0 for the first)
+//   u8      mask of the sensors present
+//   per present sensor, in HistSensor order:
+//     zigzag varint  value - previous value of that sensor in the block
+//     rollup tiers only: varint value - min, varint max - value
+// Values are fixed point, scaled by kScale.
+static const char *kRoot = "/hist";
+static const char *kTierDir[HIST_TIERS] = {"/hist/raw", "/hist/1m", "/hist/1h"};
+static const uint32_t kTierPeriod[HIST_TIERS] = {0, 60, 3600};
+static const size_t kTierCap[HIST_TIERS] = {48 * 1024, 192 * 1024, 64 * 1024};
+static const size_t kSegmentSize = 16 * 1024;
+static const size_t kBlockSize = 512;
+static const uint8_t kBlockMagic = 0xB7;
+static const uint32_t kSaveMs = 10 * 60 * 1000UL;
+static const uint32_t kMinEpoch = 1609459200UL;  // 2021-01-01: clock is set
+static const float kScale[HIST_COUNT] = {1, 10, 1, 1, 10, 10, 10};
+static const char *kNames[HIST_COUNT] = {
+    "lidar", "smoke", "eco2", "tvoc", "temp", "rh", "pressure"};
+
+struct BlockHeader {
+    uint8_t magic;
+    uint8_t tier;
+    uint16_t len;           // payload bytes after the header
+    uint16_t rows;
+    uint16_t reserved;
+    uint32_t t0;            // time of the first row
+    uint32_t t1;            // time of the last row
+    uint32_t crc;           // CRC-32 over the header up to here and the payload
+};
+
+static const size_t kPayloadMax = kBlockSize - sizeof(BlockHeader);
+static const size_t kMaxRow = 5 + 1 + HIST_COUNT * 15;
+
+// Values of one rollup period being accumulated from raw samples.
+struct Rollup {
+    uint32_t bucket;
+    float min[HIST_COUNT];
+    float max[HIST_COUNT];
+    float sum[HIST_COUNT];
+    uint16_t n[HIST_COUNT];
+};
+
+// Everything about a tier that is not on flash yet.
+struct OpenState {
+    BlockHeader h;
+    int32_t last[HIST_COUNT];   // delta base for the next row
+    Rollup acc;                 // rollup tiers: the period feeding this tier
+    uint32_t crc;               // over the fields above and the payload
+};
+
+struct Tier {
+    uint32_t headSeq;
+    uint32_t tailSeq;
+    size_t tailSize;
+    size_t total;
+    OpenState st;
+    uint8_t payload[kPayloadMax];
+    bool dirty;
+    uint32_t savedMs;
+};
+
+static Tier tiers[HIST_TIERS];
+static SemaphoreHandle_t lock;
+
+const char *historySensorName(HistSensor s) {
+    return s < HIST_COUNT ? kNames[s] : "";
+}
+
+bool historySensorFromName(const char *name, HistSensor &s) {
+    for(uint8_t i = 0; i < HIST_COUNT; i++) {
+        if(strcmp(name, kNames[i]) == 0) {
+            s = (HistSensor)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+static uint8_t *putVarint(uint8_t *p, uint32_t v) {
+    while(v >= 0x80) {
+        *p++ = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    *p++ = (uint8_t)v;
+    return p;
+}
+
+// Returns false when the varint runs past ``end``.
+static bool getVarint(const uint8_t *&p, const uint8_t *end, uint32_t &v) {
+    v = 0;
+    for(int shift = 0; shift < 35; shift += 7) {
+        if(p == end) return false;
+        uint8_t b = *p++;
+        v |= (uint32_t)(b & 0x7F) << shift;
+        if(!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+static uint32_t zigzag(int32_t v) { return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31); }
+static int32_t unzigzag(uint32_t v) { return (int32_t)(v >> 1) ^ -(int32_t)(v & 1); }
+
+static int32_t quantise(float v, uint8_t sensor) {
+    float q = roundf(v * kScale[sensor]);
+    const float lim = 1e9f;
+    return (int32_t)(q > lim ? lim : q < -lim ? -lim : q);
+}
+
+static uint32_t blockCrc(const BlockHeader &h, const uint8_t *payload) {
+    uint32_t crc = crc32Update(0, &h, offsetof(BlockHeader, crc));
+    return crc32Update(crc, payload, h.len);
+}
+
+static void segmentPath(char *out, size_t len, uint8_t tier, uint32_t seq) {
+    snprintf(out, len, "%s/%08lx", kTierDir[tier], (unsigned long)seq);
+}
+
+static void openPath(char *out, size_t len, uint8_t tier) {
+    snprintf(out, len, "%s/open", kTierDir[tier]);
+}
+
+static void saveOpen(uint8_t tier) {
+    Tier &tr = tiers[tier];
+    char path[24];
+    openPath(path, sizeof(path), tier);
+    tr.st.crc = crc32Update(0, &tr.st, offsetof(OpenState, crc));
+    tr.st.crc = crc32Update(tr.st.crc, tr.payload, tr.st.h.len);
+    File f = LittleFS.open(path, FILE_WRITE);
+    if(f) {
+        f.write((const uint8_t*)&tr.st, sizeof(tr.st));
+        f.write(tr.payload, tr.st.h.len);
+        f.close();
+    }
+    tr.dirty = false;
+    tr.savedMs = millis();
+}
+
+static void loadOpen(uint8_t tier) {
+    Tier &tr = tiers[tier];
+    memset(&tr.st, 0, sizeof(tr.st));
+    tr.st.h.magic = kBlockMagic;
+    tr.st.h.tier = tier;
+    char path[24];
+    openPath(path, sizeof(path), tier);
+    File f = LittleFS.open(path, FILE_READ);
+    if(!f) return;
+    OpenState st;
+    bool ok = f.read((uint8_t*)&st, sizeof(st)) == sizeof(st) &&
+              st.h.magic == kBlockMagic && st.h.tier == tier && st.h.len <= kPayloadMax &&
+              f.read(tr.payload, st.h.len) == st.h.len;
+    f.close();
+    if(ok) {
+        uint32_t crc = crc32Update(0, &st, offsetof(OpenState, crc));
+        ok = crc32Update(crc, tr.payload, st.h.len) == st.crc;
+    }
+    if(ok) tr.st = st;
+}
+
+// Append the open block to the tier's log and start an empty one.
+static void seal(uint8_t tier) {
+    Tier &tr = tiers[tier];
+    BlockHeader &h = tr.st.h;
+    if(h.rows == 0) return;
+    h.crc = blockCrc(h, tr.payload);
+    size_t bytes = sizeof(h) + h.len;
+    if(tr.tailSize && tr.tailSize + bytes > kSegmentSize) {
+        tr.tailSeq++;
+        tr.tailSize = 0;
+    }
+    char path[24];
+    segmentPath(path, sizeof(path), tier, tr.tailSeq);
+    File f = LittleFS.open(path, FILE_APPEND, true);
+    if(f) {
+        f.write((const uint8_t*)&h, sizeof(h));
+        f.write(tr.payload, h.len);
+        f.close();
+        tr.tailSize += bytes;
+        tr.total += bytes;
+    }
+    while(tr.total > kTierCap[tier] && tr.headSeq < tr.tailSeq) {
+        segmentPath(path, sizeof(path), tier, tr.headSeq);
+        File old = LittleFS.open(path, FILE_READ);
+        if(old) {
+            tr.total -= min(tr.total, old.size());
+            old.close();
+        }
+        LittleFS.remove(path);
+        tr.headSeq++;
+    }
+    h.rows = 0;
+    h.len = 0;
+    saveOpen(tier);     // the saved copy must not bring the rows back after a reset
+}
+
+static void addRow(uint8_t tier, uint32_t t, uint8_t mask, const int32_t *q,
+                   const int32_t *lo, const int32_t *hi) {
+    Tier &tr = tiers[tier];
+    BlockHeader &h = tr.st.h;
+    if(h.rows && (t < h.t1 || h.len + kMaxRow > kPayloadMax || h.rows == UINT16_MAX))
+        seal(tier);
+    if(h.rows == 0) {
+        h.magic = kBlockMagic;
+        h.tier = tier;
+        h.t0 = h.t1 = t;
+        memset(tr.st.last, 0, sizeof(tr.st.last));
+    }
+    uint8_t *p = tr.payload + h.len;
+    p = putVarint(p, t - h.t1);
+    *p++ = mask;
+    for(uint8_t i = 0; i < HIST_COUNT; i++) {
+        if(!(mask & (1 << i))) continue;
+        p = putVarint(p, zigzag(q[i] - tr.st.last[i]));
+        tr.st.last[i] = q[i];
+        if(lo) {
+            p = putVarint(p, (uint32_t)(q[i] - lo[i]));
+            p = putVarint(p, (uint32_t)(hi[i] - q[i]));
+        }
+    }
+    h.len = p - tr.payload;
+    h.rows++;
+    h.t1 = t;
+    tr.dirty = true;
+}
+
+// Close the period held in ``tier``'s accumulator as one row of that tier.
+static void emitRollup(uint8_t tier) {
+    Rollup &a = tiers[tier].st.acc;
+    int32_t q[HIST_COUNT], lo[HIST_COUNT], hi[HIST_COUNT];
+    uint8_t mask = 0;
+    for(uint8_t i = 0; i < HIST_COUNT; i++) {
+        if(!a.n[i]) continue;
+        mask |= 1 << i;
+        q[i] = quantise(a.sum[i] / a.n[i], i);
+        lo[i] = min(quantise(a.min[i], i), q[i]);
+        hi[i] = max(quantise(a.max[i], i), q[i]);
+    }
+    if(mask) addRow(tier, a.bucket, mask, q, lo, hi);
+    memset(&a, 0, sizeof(a));
+}
+
+static void accumulate(uint8_t tier, uint32_t t, const float *v) {
+    Rollup &a = tiers[tier].st.acc;
+    uint32_t bucket = t - t % kTierPeriod[tier];
+    bool empty = true;
+    for(uint8_t i = 0; i < HIST_COUNT; i++) if(a.n[i]) empty = false;
+    if(!empty && bucket != a.bucket) emitRollup(tier);
+    a.bucket = bucket;
+    for(uint8_t i = 0; i < HIST_COUNT; i++) {
+        if(isnan(v[i])) continue;
+        if(!a.n[i] || v[i] < a.min[i]) a.min[i] = v[i];
+        if(!a.n[i] || v[i] > a.max[i]) a.max[i] = v[i];
+        a.sum[i] += v[i];
+        if(a.n[i] < UINT16_MAX) a.n[i]++;
+    }
+    tiers[tier].dirty = true;
+}
+
+void historyInit() {
+    if(!lock) lock = xSemaphoreCreateMutex();
+    xSemaphoreTake(lock, portMAX_DELAY);
+    LittleFS.mkdir(kRoot);
+    for(uint8_t t = 0; t < HIST_TIERS; t++) {
+        Tier &tr = tiers[t];
+        LittleFS.mkdir(kTierDir[t]);
+        bool found = false;
+        uint32_t lo = 0, hi = 0;
+        tr.total = 0;
+        File dir = LittleFS.open(kTierDir[t]);
+        if(dir) {
+            for(File f = dir.openNextFile(); f; f = dir.openNextFile()) {
+                const char *name = strrchr(f.name(), '/');
+                name = name ? name + 1 : f.name();
+                char *end;
+                uint32_t seq = strtoul(name, &end, 16);
+                if(strlen(name) != 8 || *end) continue;
+                if(!found || seq < lo) lo = seq;
+                if(!found || seq > hi) hi = seq;
+                found = true;
+                tr.total += f.size();
+            }
+            dir.close();
+        }
+        // Append to a fresh segment so that a block torn at the end of the
+        // last one never hides the blocks written after it.
+        tr.headSeq = lo;
+        tr.tailSeq = found ? hi + 1 : 0;
+        tr.tailSize = 0;
+        loadOpen(t);
+        tr.dirty = false;
+        tr.savedMs = millis();
+    }
+    xSemaphoreGive(lock);
+}
+
+void historyAdd(uint32_t t, const float v[HIST_COUNT]) {
+    if(t < kMinEpoch || !lock) return;
+    int32_t q[HIST_COUNT];
+    uint8_t mask = 0;
+    for(uint8_t i = 0; i < HIST_COUNT; i++) {
+        if(isnan(v[i])) continue;
+        mask |= 1 << i;
+        q[i] = quantise(v[i], i);
+    }
+    if(!mask) return;
+    xSemaphoreTake(lock, portMAX_DELAY);
+    addRow(HIST_RAW, t, mask, q, nullptr, nullptr);
+    accumulate(HIST_MINUTE, t, v);
+    accumulate(HIST_HOUR, t, v);
+    for(uint8_t i = 0; i < HIST_TIERS; i++) {
+        Tier &tr = tiers[i];
+        if(tr.dirty && millis() - tr.savedMs >= kSaveMs) saveOpen(i);
+    }
+    xSemaphoreGive(lock);
+}
+
+void historySave() {
+    if(!lock) return;
+    xSemaphoreTake(lock, portMAX_DELAY);
+    for(uint8_t i = 0; i < HIST_TIERS; i++) if(tiers[i].dirty) saveOpen(i);
+    xSemaphoreGive(lock);
+}
+
+// ---- Queries ----
+
+// Time of the oldest row kept in ``tier``, UINT32_MAX when it is empty.
+static uint32_t oldestRow(uint8_t tier) {
+    const Tier &tr = tiers[tier];
+    for(uint32_t seq = tr.headSeq; seq <= tr.tailSeq; seq++) {
+        char path[24];
+        segmentPath(path, sizeof(path), tier, seq);
+        File f = LittleFS.open(path, FILE_READ);
+        if(!f) continue;
+        BlockHeader h;
+        bool ok = f.read((uint8_t*)&h, sizeof(h)) == sizeof(h) && h.magic == kBlockMagic;
+        f.close();
+        if(ok) return h.t0;
+    }
+    return tr.st.h.rows ? tr.st.h.t0 : UINT32_MAX;
+}
+
+HistoryReader::HistoryReader(HistSensor s, uint32_t f, uint32_t t, uint32_t st)
+    : sensor(s), from(f), to(t), step(st ? st : 1) {
+    tier = step >= 3600 ? HIST_HOUR : step >= 60 ? HIST_MINUTE : HIST_RAW;
+    // Fall back to a coarser tier when this one no longer reaches back to
+    // the start of the range and the coarser one does better.
+    xSemaphoreTake(lock, portMAX_DELAY);
+    for(uint32_t have = oldestRow(tier); tier < HIST_HOUR && have > from;) {
+        uint32_t coarser = oldestRow(tier + 1);
+        if(coarser >= have) break;
+        tier = (HistTier)(tier + 1);
+        have = coarser;
+    }
+    seq = tiers[tier].headSeq;
+    xSemaphoreGive(lock);
+}
+
+// Load the next block that overlaps the range into ``blk``.
+bool HistoryReader::loadBlock() {
+    BlockHeader h;
+    xSemaphoreTake(lock, portMAX_DELAY);
+    const Tier &tr = tiers[tier];
+    if(seq < tr.headSeq) {          // dropped while we were reading
+        seq = tr.headSeq;
+        offset = 0;
+    }
+    bool got = false;
+    while(!got && seq <= tr.tailSeq) {
+        char path[24];
+        segmentPath(path, sizeof(path), tier, seq);
+        File f = LittleFS.open(path, FILE_READ);
+        bool ok = f && f.seek(offset) &&
+                  f.read((uint8_t*)&h, sizeof(h)) == sizeof(h) &&
+                  h.magic == kBlockMagic && h.len <= kPayloadMax;
+        if(ok && h.t1 >= from && h.t0 <= to) {
+            ok = f.read(blk, h.len) == h.len && blockCrc(h, blk) == h.crc;
+            got = ok;
+        }
+        if(f) f.close();
+        if(ok) {
+            offset += sizeof(h) + h.len;
+        } else {
+            seq++;
+            offset = 0;
+        }
+    }
+    if(!got && !openDone) {
+        openDone = true;
+        h = tr.st.h;
+        if(h.rows && h.t1 >= from && h.t0 <= to) {
+            memcpy(blk, tr.payload, h.len);
+            got = true;
+        }
+    }
+    xSemaphoreGive(lock);
+    if(!got) return false;
+    len = h.len;
+    rows = h.rows;
+    pos = 0;
+    rowT = h.t0;
+    memset(last, 0, sizeof(last));
+    return true;
+}
+
+// Decode rows until one carries the sensor within the range.
+bool HistoryReader::nextRow(uint32_t &t, float &lo, float &hi, float &avg) {
+    bool rollup = tier != HIST_RAW;
+    for(;;) {
+        if(rows == 0 && !loadBlock()) return false;
+        const uint8_t *p = blk + pos, *end = blk + len;
+        uint32_t dt;
+        bool ok = getVarint(p, end, dt) && p < end;
+        uint8_t mask = ok ? *p++ : 0;
+        bool hit = false;
+        for(uint8_t i = 0; ok && i < HIST_COUNT; i++) {
+            if(!(mask & (1 << i))) continue;
+            uint32_t d, dLo = 0, dHi = 0;
+            ok = getVarint(p, end, d) &&
+                 (!rollup || (getVarint(p, end, dLo) && getVarint(p, end, dHi)));
+            last[i] += unzigzag(d);
+            if(i == sensor) {
+                hit = true;
+                avg = last[i] / kScale[i];
+                lo = (last[i] - (int32_t)dLo) / kScale[i];
+                hi = (last[i] + (int32_t)dHi) / kScale[i];
+            }
+        }
+        if(!ok) {                   // corrupt row: drop the rest of the block
+            rows = 0;
+            continue;
+        }
+        pos = p - blk;
+        rows--;
+        rowT += dt;
+        if(hit && rowT >= from && rowT <= to) {
+            t = rowT;
+            return true;
+        }
+    }
+}
+
+bool HistoryReader::next(HistPoint &p) {
+    for(;;) {
+        uint32_t t;
+        float lo, hi, avg;
+        bool have = !ended && nextRow(t, lo, hi, avg);
+        if(!have) ended = true;
+        uint32_t b = have ? t - t % step : 0;
+        if(bN && (!have || b != bucket)) {
+            p.t = bucket;
+            p.min = bMin;
+            p.max = bMax;
+            p.avg = bSum / bN;
+            bN = 0;
+            if(have) {
+                bucket = b;
+                bMin = lo;
+                bMax = hi;
+                bSum = avg;
+                bN = 1;
+            }
+            return true;
+        }
+        if(!have) return false;
+        if(!bN) {
+            bucket = b;
+            bMin = lo;
+            bMax = hi;
+            bSum = 0;
+        }
+        bMin = min(bMin, lo);
+        bMax = max(bMax, hi);
+        bSum += avg;
+        bN++;
+    }
+}
+
+size_t HistoryReader::readJson(uint8_t *buf, size_t maxLen) {
+    size_t n = 0;
+    int dec = kScale[sensor] > 1 ? 1 : 0;
+    while(n < maxLen) {
+        if(pendPos == pendLen) {
+            int w = 0;
+            HistPoint pt;
+            if(jsonState == 0) {
+                w = snprintf(pend, sizeof(pend), "{\"sensor\":\"%s\",\"step\":%lu,\"points\":[",
+                             kNames[sensor], (unsigned long)step);
+                jsonState = 1;
+            } else if(jsonState == 1 && next(pt)) {
+                w = snprintf(pend, sizeof(pend), "%s[%lu,%.*f,%.*f,%.*f]", emitted++ ? "," : "",
+                             (unsigned long)pt.t, dec, pt.min, dec, pt.max, dec, pt.avg);
+            } else if(jsonState == 1) {
+                w = snprintf(pend, sizeof(pend), "]}");
+                jsonState = 2;
+            } else {
+                break;
+            }
+            pendLen = (uint8_t)min(w, (int)sizeof(pend) - 1);
+            pendPos = 0;
+        }
+        size_t c = min((size_t)(pendLen - pendPos), maxLen - n);
+        memcpy(buf + n, pend + pendPos, c);
+        pendPos += c;
+        n += c;
+    }
+    return n;
+}
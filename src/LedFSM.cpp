@@ -1,15 +1,26 @@
 #include "LedFSM.h"
+#include <atomic>
 
 static uint8_t ledPin = 2;
-static LedState current = LedState::NORMAL;
+static std::atomic<bool> linkUp{false};
+static std::atomic<bool> alarmOn{false};
 
 void ledInit(uint8_t pin) {
     ledPin = pin;
     pinMode(ledPin, OUTPUT);
 }
 
-void ledSetState(LedState s) {
-    current = s;
+void ledSetLink(bool up) {
+    linkUp = up;
+}
+
+void ledSetAlarm(bool on) {
+    alarmOn = on;
+}
+
+LedState ledState() {
+    if(alarmOn) return LedState::ALARM;
+    return linkUp ? LedState::NORMAL : LedState::ERROR;
 }
 
 void ledTask(void*) {
@@ -17,7 +28,7 @@ void ledTask(void*) {
     const TickType_t normalOff = pdMS_TO_TICKS(9900);
     const TickType_t errorShort = pdMS_TO_TICKS(100);
     for(;;) {
-        switch(current) {
+        switch(ledState()) {
             case LedState::NORMAL:
                 digitalWrite(ledPin, HIGH);
                 vTaskDelay(normalOn);
@@ -0,0 +1,160 @@
+#include "Lidar.h"
+#include "Filter.h"
+
+static const uint8_t kMaxLine = 24;             // longer lines are noise
+static const int32_t kMaxWhole = 1000;          // metres; guards overflow
+static const int32_t kRangeMm = 120000;         // SF11/C maximum range
+
+static HardwareSerial *uart;
+static LidarParser parser;
+static SMAFilter<int32_t, kLidarAvg> window;
+static LidarReading latest;
+static LidarStats stats;
+static portMUX_TYPE lidarMux = portMUX_INITIALIZER_UNLOCKED;
+static SemaphoreHandle_t frameSem;
+
+void LidarParser::reset() {
+    state = LEAD;
+    neg = false;
+    bad = false;
+    len = 0;
+    fracDigits = 0;
+    whole = 0;
+    frac = 0;
+}
+
+LidarParser::Result LidarParser::feed(uint8_t c) {
+    if(c == '\n') {
+        Result r = NONE;
+        if(bad || (state == LEAD && neg)) r = ERROR;
+        else if(state != LEAD) {
+            int32_t f = frac;
+            for(uint8_t i = fracDigits; i < 3; i++) f *= 10;
+            value = whole * 1000 + f;
+            if(neg) value = -value;
+            r = FRAME;
+        }
+        reset();
+        return r;
+    }
+    if(bad || c == '\r') return NONE;
+    if(++len > kMaxLine) {
+        bad = true;
+        return NONE;
+    }
+    if(c >= '0' && c <= '9') {
+        int32_t d = c - '0';
+        if(state == LEAD) state = INT;
+        if(state == INT) {
+            whole = whole * 10 + d;
+            if(whole >= kMaxWhole) bad = true;
+        } else if(state == FRAC) {
+            if(fracDigits < 3) {
+                frac = frac * 10 + d;
+                fracDigits++;
+            }
+        } else {
+            bad = true;                 // digits after the unit
+        }
+    } else if(c == '.') {
+        if(state == LEAD || state == INT) state = FRAC;
+        else bad = true;
+    } else if(c == ' ' || c == '\t') {
+        if(state != LEAD) state = TAIL;
+    } else if(c == '-' || c == '+') {
+        if(state == LEAD && !neg) neg = c == '-';
+        else bad = true;
+    } else if(c == 'm') {
+        if(state == LEAD) bad = true;
+        else state = TAIL;
+    } else {
+        bad = true;
+    }
+    return NONE;
+}
+
+static void onFrame(int32_t mm) {
+    if(mm <= 0 || mm > kRangeMm) {             // lost signal or out of range
+        portENTER_CRITICAL(&lidarMux);
+        stats.noTarget++;
+        portEXIT_CRITICAL(&lidarMux);
+        return;
+    }
+    uint32_t now = millis();
+    portENTER_CRITICAL(&lidarMux);
+    window.add(mm);
+    latest.ms = now;
+    latest.last = (float)mm;
+    latest.distance = (float)window.value();
+    if(latest.samples < UINT16_MAX) latest.samples++;
+    stats.frames++;
+    portEXIT_CRITICAL(&lidarMux);
+    if(frameSem) xSemaphoreGive(frameSem);
+}
+
+void lidarFeed(const uint8_t *data, size_t len) {
+    for(size_t i = 0; i < len; i++) {
+        LidarParser::Result r = parser.feed(data[i]);
+        if(r == LidarParser::FRAME) {
+            onFrame(parser.mm());
+        } else if(r == LidarParser::ERROR) {
+            portENTER_CRITICAL(&lidarMux);
+            stats.errors++;
+            portEXIT_CRITICAL(&lidarMux);
+        }
+    }
+}
+
+// Runs in the UART driver's event task whenever bytes arrive or the line
+// goes idle, so a frame is parsed within a couple of symbol times.
+static void onReceive() {
+    uint8_t buf[64];
+    for(;;) {
+        int n = uart->available();
+        if(n <= 0) return;
+        if(n > (int)sizeof(buf)) n = sizeof(buf);
+        lidarFeed(buf, uart->readBytes(buf, n));
+    }
+}
+
+void lidarBegin(HardwareSerial &port, int8_t rxPin, int8_t txPin) {
+    uart = &port;
+    if(!frameSem) frameSem = xSemaphoreCreateBinary();
+    port.setRxBufferSize(512);
+    port.begin(115200, SERIAL_8N1, rxPin, txPin);
+    port.setRxTimeout(2);
+    port.onReceive(onReceive);
+}
+
+bool lidarGet(LidarReading &r) {
+    portENTER_CRITICAL(&lidarMux);
+    r = latest;
+    portEXIT_CRITICAL(&lidarMux);
+    r.valid = r.samples > 0 && millis() - r.ms < kLidarStaleMs;
+    return r.valid;
+}
+
+void lidarFlush() {
+    portENTER_CRITICAL(&lidarMux);
+    window.reset();
+    latest.samples = 0;
+    latest.distance = NAN;
+    portEXIT_CRITICAL(&lidarMux);
+}
+
+bool lidarWait(LidarReading &r, uint16_t frames, uint32_t timeoutMs) {
+    uint32_t start = millis();
+    for(;;) {
+        if(lidarGet(r) && r.samples >= frames) return true;
+        uint32_t waited = millis() - start;
+        if(waited >= timeoutMs) return false;
+        xSemaphoreTake(frameSem, pdMS_TO_TICKS(timeoutMs - waited));
+    }
+}
+
+LidarStats lidarStats() {
+    portENTER_CRITICAL(&lidarMux);
+    LidarStats s = stats;
+    portEXIT_CRITICAL(&lidarMux);
+    return s;
+}
@@ -0,0 +1,173 @@
+#include "LivePush.h"
+#include "Readings.h"
+
+static const uint8_t kMaxViewers = 8;           // AsyncWebSocket's client limit
+static const uint16_t kMinIntervalMs = 100;     // per client
+static const uint16_t kMaxIntervalMs = 5000;    // for a client that stays backed up
+static const uint32_t kCleanupMs = 1000;
+static const int32_t kNull = INT32_MIN;         // value is NAN
+static const int32_t kUnsent = INT32_MIN + 1;   // client has not seen the field
+
+// The Readings followed by the head position.
+enum LiveField : uint8_t {
+    LIVE_X = READ_COUNT,
+    LIVE_Y,
+    LIVE_COUNT
+};
+
+static const char *kNames[LIVE_COUNT] = {
+    "lidar", "smoke", "eco2", "tvoc", "temp", "rh", "pressure", "x", "y"};
+static const uint8_t kDecimals[LIVE_COUNT] = {0, 1, 0, 0, 1, 1, 1, 0, 0};
+
+struct Viewer {
+    uint32_t id;            // 0: free slot
+    uint32_t gen;           // claim of the slot, new for every client
+    uint32_t lastMs;
+    uint16_t intervalMs;
+    int32_t sent[LIVE_COUNT];
+};
+
+static AsyncWebSocket *socket;
+static int32_t current[LIVE_COUNT];             // fixed point, kDecimals places
+static uint32_t version;                        // of the Readings in current
+static bool changed;                            // a client connected
+static bool backlog;                            // only touched by livePush()
+static Viewer viewers[kMaxViewers];             // under liveMux
+static uint32_t claims;                         // last Viewer::gen handed out
+static LiveStats stats;
+static uint32_t lastCleanup;
+static portMUX_TYPE liveMux = portMUX_INITIALIZER_UNLOCKED;
+
+static int32_t quantise(float v, uint8_t f) {
+    if(isnan(v)) return kNull;
+    float q = roundf(kDecimals[f] ? v * 10 : v);
+    return q > 1e9f ? 1000000000 : q < -1e9f ? -1000000000 : (int32_t)q;
+}
+
+void liveBegin(AsyncWebSocket *ws) {
+    socket = ws;
+    for(uint8_t i = 0; i < LIVE_COUNT; i++) current[i] = kNull;
+    version = 0;
+}
+
+// Take the latest Readings into ``current``.  True when any field changed.
+static bool refresh() {
+    Readings r;
+    readingsGet(r);
+    if(r.version == version) return false;
+    version = r.version;
+    int32_t next[LIVE_COUNT];
+    for(uint8_t i = 0; i < READ_COUNT; i++) next[i] = quantise(r.value[i], i);
+    next[LIVE_X] = r.headX;
+    next[LIVE_Y] = r.headY;
+    if(memcmp(next, current, sizeof(next)) == 0) return false;
+    memcpy(current, next, sizeof(next));
+    return true;
+}
+
+void liveOnEvent(AsyncWebSocketClient *client, AwsEventType type) {
+    portENTER_CRITICAL(&liveMux);
+    if(type == WS_EVT_CONNECT) {
+        for(Viewer &v : viewers) {
+            if(v.id) continue;
+            v.id = client->id();
+            v.gen = ++claims;
+            v.lastMs = millis() - kMaxIntervalMs;
+            v.intervalMs = kMinIntervalMs;
+            for(int32_t &s : v.sent) s = kUnsent;
+            changed = true;
+            break;
+        }
+    } else if(type == WS_EVT_DISCONNECT) {
+        for(Viewer &v : viewers) if(v.id == client->id()) v.id = 0;
+    }
+    portEXIT_CRITICAL(&liveMux);
+}
+
+// Write the fields of ``cur`` that differ from ``sent`` as a JSON object.
+// Returns its length, 0 when nothing differs.
+static size_t buildFrame(char *out, size_t len, const int32_t *cur, const int32_t *sent) {
+    size_t n = 0;
+    for(uint8_t i = 0; i < LIVE_COUNT && n < len; i++) {
+        if(cur[i] == sent[i]) continue;
+        const char *sep = n ? "," : "{";
+        int w;
+        if(cur[i] == kNull)
+            w = snprintf(out + n, len - n, "%s\"%s\":null", sep, kNames[i]);
+        else if(kDecimals[i])
+            w = snprintf(out + n, len - n, "%s\"%s\":%s%ld.%ld", sep, kNames[i],
+                         cur[i] < 0 ? "-" : "", labs(cur[i] / 10), labs(cur[i] % 10));
+        else
+            w = snprintf(out + n, len - n, "%s\"%s\":%ld", sep, kNames[i], (long)cur[i]);
+        n += w;
+    }
+    if(!n || n + 2 > len) return 0;
+    out[n++] = '}';
+    out[n] = 0;
+    return n;
+}
+
+// Store livePush()'s working copy of slot ``i`` unless the client left or
+// the slot was claimed again meanwhile.
+static void commit(uint8_t i, const Viewer &v) {
+    portENTER_CRITICAL(&liveMux);
+    if(viewers[i].id && viewers[i].gen == v.gen) viewers[i] = v;
+    portEXIT_CRITICAL(&liveMux);
+}
+
+void livePush() {
+    if(!socket) return;
+    uint32_t now = millis();
+    if(now - lastCleanup >= kCleanupMs) {
+        socket->cleanupClients(kMaxViewers);
+        lastCleanup = now;
+    }
+    bool any = refresh();
+    portENTER_CRITICAL(&liveMux);
+    any |= changed;
+    changed = false;
+    portEXIT_CRITICAL(&liveMux);
+    // A client that was held back still owes a frame even when nothing
+    // new was published.
+    if(!any && !backlog) return;
+    backlog = false;
+    char frame[192];
+    // Work on a copy of each slot: liveOnEvent() may free or reclaim it
+    // from the socket's task while a frame is being sent.
+    for(uint8_t i = 0; i < kMaxViewers; i++) {
+        portENTER_CRITICAL(&liveMux);
+        Viewer v = viewers[i];
+        portEXIT_CRITICAL(&liveMux);
+        if(!v.id) continue;
+        size_t n = buildFrame(frame, sizeof(frame), current, v.sent);
+        if(!n) continue;
+        if(now - v.lastMs < v.intervalMs) {
+            backlog = true;
+            continue;
+        }
+        AsyncWebSocketClient *c = socket->client(v.id);
+        if(!c) {
+            v.id = 0;
+            commit(i, v);
+            continue;
+        }
+        v.lastMs = now;
+        if(!c->canSend()) {
+            v.intervalMs = min<uint16_t>(v.intervalMs * 2, kMaxIntervalMs);
+            commit(i, v);
+            stats.throttled++;
+            backlog = true;
+            continue;
+        }
+        c->text(frame, n);
+        memcpy(v.sent, current, sizeof(v.sent));
+        v.intervalMs = max<uint16_t>(v.intervalMs / 2, kMinIntervalMs);
+        commit(i, v);
+        stats.frames++;
+        stats.bytes += n;
+    }
+}
+
+LiveStats liveStats() {
+    return stats;
+}
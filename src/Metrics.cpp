@@ -0,0 +1,165 @@
+#include "Metrics.h"
+#include <atomic>
+
+static const uint8_t kCores = 2;
+
+struct Histogram {
+    std::atomic<uint32_t> bucket[kMetricBuckets];
+    std::atomic<uint32_t> sumUs;
+    std::atomic<uint32_t> wraps;        // times sumUs passed 2^32
+};
+
+struct WatchedTask {
+    const char *name;
+    TaskHandle_t task;
+};
+
+static std::atomic<uint32_t> counters[kCores][MET_COUNTER_COUNT];
+static Histogram timers[kCores][MET_TIMER_COUNT];
+static std::atomic<int32_t> gauges[MET_GAUGE_COUNT];
+static WatchedTask tasks[kMetricTasks];
+static std::atomic<uint8_t> taskClaims(0);     // slots handed out
+static std::atomic<uint8_t> taskCount(0);      // slots written, readable
+
+static const char *const kCounterNames[MET_COUNTER_COUNT] = {
+    "wifi_connects", "mqtt_connects", "mqtt_lost", "publish_fails"};
+static const char *const kTimerNames[MET_TIMER_COUNT] = {
+    "sensors_loop", "read_mq2", "read_ens160", "read_aht21", "read_sdp810",
+    "read_lidar", "mqtt_publish", "buffer_flush"};
+static const char *const kGaugeNames[MET_GAUGE_COUNT] = {"ws_clients", "buffer_backlog_bytes"};
+
+static inline uint8_t core() {
+    return (uint8_t)xPortGetCoreID() % kCores;
+}
+
+static uint8_t bucketOf(uint32_t us) {
+    uint8_t i = 0;
+    while(i < kMetricBuckets - 1 && us > kMetricBucketsUs[i]) i++;
+    return i;
+}
+
+void metricsCount(MetricCounter c, uint32_t n) {
+    counters[core()][c].fetch_add(n, std::memory_order_relaxed);
+}
+
+void metricsTime(MetricTimer t, uint32_t us) {
+    Histogram &h = timers[core()][t];
+    h.bucket[bucketOf(us)].fetch_add(1, std::memory_order_relaxed);
+    uint32_t before = h.sumUs.fetch_add(us, std::memory_order_relaxed);
+    if(before + us < before) h.wraps.fetch_add(1, std::memory_order_relaxed);
+}
+
+void metricsSet(MetricGauge g, int32_t value) {
+    gauges[g].store(value, std::memory_order_relaxed);
+}
+
+// Tasks register from setup() and from the tasks they start, possibly at
+// the same time: each caller claims its own slot, then slots become
+// visible in order so readers never see one that is still being written.
+void metricsWatchTask(const char *name, TaskHandle_t task) {
+    if(!task) return;
+    uint8_t i = taskClaims.fetch_add(1);
+    if(i >= kMetricTasks) return;
+    tasks[i] = {name, task};
+    uint8_t expect = i;
+    while(!taskCount.compare_exchange_weak(expect, i + 1)) {
+        expect = i;
+        yield();
+    }
+}
+
+uint32_t MetricsHistogram::quantileUs(float q) const {
+    if(!count) return 0;
+    uint32_t rank = (uint32_t)ceilf(q * count), seen = 0;
+    for(uint8_t i = 0; i < kMetricBuckets - 1; i++) {
+        seen += bucket[i];
+        if(seen >= rank) return kMetricBucketsUs[i];
+    }
+    return UINT32_MAX;
+}
+
+uint32_t metricsCounter(MetricCounter c) {
+    uint32_t n = 0;
+    for(uint8_t k = 0; k < kCores; k++) n += counters[k][c].load(std::memory_order_relaxed);
+    return n;
+}
+
+void metricsHistogram(MetricTimer t, MetricsHistogram &out) {
+    memset(&out, 0, sizeof(out));
+    for(uint8_t k = 0; k < kCores; k++) {
+        const Histogram &h = timers[k][t];
+        for(uint8_t i = 0; i < kMetricBuckets; i++) {
+            uint32_t n = h.bucket[i].load(std::memory_order_relaxed);
+            out.bucket[i] += n;
+            out.count += n;
+        }
+        out.sumUs += ((uint64_t)h.wraps.load(std::memory_order_relaxed) << 32) |
+                     h.sumUs.load(std::memory_order_relaxed);
+    }
+}
+
+static uint32_t minStackBytes() {
+    uint32_t least = UINT32_MAX;
+    uint8_t n = taskCount.load();
+    for(uint8_t i = 0; i < n; i++)
+        least = min(least, (uint32_t)uxTaskGetStackHighWaterMark(tasks[i].task));
+    return n ? least : 0;
+}
+
+void metricsWrite(Print &out) {
+    out.print("# TYPE chp_uptime_seconds counter\n");
+    out.printf("chp_uptime_seconds %lu\n", (unsigned long)(millis() / 1000));
+    out.print("# TYPE chp_heap_free_bytes gauge\n");
+    out.printf("chp_heap_free_bytes %lu\n", (unsigned long)ESP.getFreeHeap());
+    out.print("# TYPE chp_heap_max_block_bytes gauge\n");
+    out.printf("chp_heap_max_block_bytes %lu\n", (unsigned long)ESP.getMaxAllocHeap());
+    // ESP-IDF counts stacks in bytes.
+    out.print("# TYPE chp_task_stack_free_bytes gauge\n");
+    for(uint8_t i = 0, n = taskCount.load(); i < n; i++)
+        out.printf("chp_task_stack_free_bytes{task=\"%s\"} %lu\n", tasks[i].name,
+                   (unsigned long)uxTaskGetStackHighWaterMark(tasks[i].task));
+    for(uint8_t g = 0; g < MET_GAUGE_COUNT; g++) {
+        out.printf("# TYPE chp_%s gauge\n", kGaugeNames[g]);
+        out.printf("chp_%s %ld\n", kGaugeNames[g], (long)gauges[g].load());
+    }
+    for(uint8_t c = 0; c < MET_COUNTER_COUNT; c++) {
+        out.printf("# TYPE chp_%s_total counter\n", kCounterNames[c]);
+        out.printf("chp_%s_total %lu\n", kCounterNames[c],
+                   (unsigned long)metricsCounter((MetricCounter)c));
+    }
+    MetricsHistogram h;
+    for(uint8_t t = 0; t < MET_TIMER_COUNT; t++) {
+        const char *name = kTimerNames[t];
+        metricsHistogram((MetricTimer)t, h);
+        out.printf("# TYPE chp_%s_seconds histogram\n", name);
+        uint32_t cumulative = 0;
+        for(uint8_t i = 0; i < kMetricBuckets - 1; i++) {
+            cumulative += h.bucket[i];
+            out.printf("chp_%s_seconds_bucket{le=\"%g\"} %lu\n", name,
+                       kMetricBucketsUs[i] / 1e6, (unsigned long)cumulative);
+        }
+        out.printf("chp_%s_seconds_bucket{le=\"+Inf\"} %lu\n", name, (unsigned long)h.count);
+        out.printf("chp_%s_seconds_sum %.6f\n", name, h.sumUs / 1e6);
+        out.printf("chp_%s_seconds_count %lu\n", name, (unsigned long)h.count);
+    }
+}
+
+static uint32_t p95Ms(MetricTimer t) {
+    MetricsHistogram h;
+    metricsHistogram(t, h);
+    uint32_t us = h.quantileUs(0.95f);
+    return us == UINT32_MAX ? UINT32_MAX / 1000 : (us + 999) / 1000;
+}
+
+MetricsSummary metricsSummary() {
+    MetricsSummary s;
+    s.maxBlock = ESP.getMaxAllocHeap();
+    s.minStack = minStackBytes();
+    s.loopMs = p95Ms(MET_SENSORS_LOOP);
+    s.publishMs = p95Ms(MET_MQTT_PUBLISH);
+    s.flushMs = p95Ms(MET_BUFFER_FLUSH);
+    s.backlog = gauges[MET_BUFFER_BACKLOG].load();
+    s.wsClients = gauges[MET_WS_CLIENTS].load();
+    s.reconnects = metricsCounter(MET_MQTT_LOST);
+    return s;
+}
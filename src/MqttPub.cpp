@@ -0,0 +1,92 @@
+#include "MqttPub.h"
+#include "MsgBuffer.h"
+#include "NetMgr.h"
+#include "Metrics.h"
+#include <PubSubClient.h>
+
+extern PubSubClient mqtt;
+
+static const UBaseType_t kQueueLength = 16;
+
+// Preformatted record passed by value through the queue.  Sized for the
+// heartbeat JSON; longer payloads bypass the queue through MsgBuffer.
+struct PubMsg {
+    bool persist;
+    uint16_t len;
+    char topic[64];
+    char payload[kPubMaxPayload];
+};
+
+static QueueHandle_t queue;
+static volatile uint32_t maxDepth = 0;
+static volatile uint32_t sent = 0;
+static volatile uint32_t diverted = 0;
+static volatile uint32_t lastUs = 0;
+static volatile uint32_t maxUs = 0;
+
+// Hand a message that cannot be published now to the offline buffer, or
+// drop it when it is not worth keeping.
+static bool divert(const char *topic, const char *payload, size_t len, bool persist) {
+    diverted++;
+    return persist && bufferStore(topic, payload, len);
+}
+
+void pubInit() {
+    if(!queue) queue = xQueueCreate(kQueueLength, sizeof(PubMsg));
+}
+
+bool pubEnqueue(const char *topic, const char *payload, bool persist) {
+    return pubEnqueueBytes(topic, payload, strlen(payload), persist);
+}
+
+bool pubEnqueueBytes(const char *topic, const char *payload, size_t len, bool persist) {
+    PubMsg m;
+    m.persist = persist;
+    m.len = len;
+    if(!queue || len > sizeof(m.payload) ||
+       strlcpy(m.topic, topic, sizeof(m.topic)) >= sizeof(m.topic))
+        return divert(topic, payload, len, persist);
+    memcpy(m.payload, payload, len);
+    if(xQueueSend(queue, &m, 0) != pdTRUE) return divert(topic, payload, len, persist);
+    uint32_t depth = uxQueueMessagesWaiting(queue);
+    if(depth > maxDepth) maxDepth = depth;
+    return true;
+}
+
+static void publish(const PubMsg &m) {
+    if(!mqtt.connected()) {
+        divert(m.topic, m.payload, m.len, m.persist);
+        return;
+    }
+    uint32_t start = micros();
+    bool ok = mqtt.publish(m.topic, (const uint8_t*)m.payload, m.len, false);
+    uint32_t took = micros() - start;
+    lastUs = took;
+    if(took > maxUs) maxUs = took;
+    metricsTime(MET_MQTT_PUBLISH, took);
+    if(ok) {
+        sent++;
+    } else {
+        metricsCount(MET_PUBLISH_FAILS);
+        divert(m.topic, m.payload, m.len, m.persist);
+    }
+}
+
+void pubService(TickType_t wait) {
+    netService();                      // keep Wi-Fi and the broker session up
+    bufferPoll();                      // flush or spill the offline buffer
+    PubMsg m;
+    if(!queue || !xQueueReceive(queue, &m, wait)) return;
+    do {
+        publish(m);
+    } while(xQueueReceive(queue, &m, 0));
+}
+
+void pubTask(void*) {
+    for(;;) pubService(pdMS_TO_TICKS(10));
+}
+
+PubStats pubStats() {
+    return {queue ? (uint32_t)uxQueueMessagesWaiting(queue) : 0, maxDepth, sent, diverted,
+            lastUs, maxUs};
+}
@@ -1,60 +1,682 @@
 #include "MsgBuffer.h"
 #include "Config.h"
+#include "Crc.h"
+#include "Metrics.h"
+#include "NtpSync.h"
 #include <PubSubClient.h>
+#include <atomic>
 
 extern PubSubClient mqtt;
 
-void bufferInit() {
-    LittleFS.begin(true);
+// On-flash layout, one log per lane:
+//   <dir>/<seq>    segment files, <seq> is 8 hex digits and only grows
+//   <dir>/cursor   CursorRec: first unsent byte (segment, offset)
+// The bulk lane lives in /mbuf itself, where older firmware kept its single
+// log, and the other lanes in subdirectories.  A segment holds
+// back-to-back records, each a RecordHeader followed by the topic and
+// payload bytes (no terminators).
+static const char *kRootDir = "/mbuf";
+static const char *kLegacyPath = "/buf";
+static const size_t kSegmentSize = 16 * 1024;   // roll over to a new segment
+static const uint8_t kRecordMagic = 0xA6;
+static const uint8_t kRecordMagicV1 = 0xA5;     // before capture times
+static const size_t kHeaderLenV1 = 8;
+static const size_t kMaxTopic = 127;
+static const size_t kMaxPayload = 1024;
+static const size_t kRamSize = 8 * 1024;        // RAM staging ring
+static const size_t kRamHighWater = kRamSize * 3 / 4;
+static const time_t kValidTime = 1600000000;    // earlier: the clock was never set
+static const size_t kStampLen = 32;             // room for the added "ts"
+static const uint32_t kCursorSaveMs = 1000;     // while a replay is under way
+
+struct RecordHeader {
+    uint8_t magic;
+    uint8_t topicLen;
+    uint16_t payloadLen;
+    uint32_t crc;           // CRC-32 over time, topicLen, payloadLen, topic, payload
+    uint32_t time;          // ntpNow() when stored; absent from v1 records
+};
+
+// Header of an entry in the RAM ring, followed by topic and payload.
+struct RamHeader {
+    uint8_t topicLen;
+    uint8_t lane;
+    uint8_t sent;           // set by the consumer once published
+    uint16_t payloadLen;
+    uint32_t storedMs;      // millis() when the message was stored
+    uint32_t time;          // ntpNow() when the message was stored
+};
+
+struct CursorRec {
+    uint32_t seq;
+    uint32_t offset;
+    uint32_t crc;
+};
+
+// One lane's segment log.  Guarded by ``lock``.
+struct Log {
+    const char *dir;
+    uint32_t maxSegments;   // hard cap; the oldest segment goes first
+    uint32_t headSeq;       // oldest segment still on flash
+    uint32_t tailSeq;       // segment currently appended to
+    size_t tailSize;
+    uint32_t readSeq;       // read cursor
+    uint32_t readOffset;
+    size_t backlog;         // bytes from the cursor to the end of the log
+    uint32_t savedMs;       // millis() of the last cursor save
+    File writer;
+};
+
+static Log logs[LANE_COUNT] = {
+    {"/mbuf/alarm", 4, 0, 0, 0, 0, 0, 0, 0, File()},
+    {"/mbuf/event", 4, 0, 0, 0, 0, 0, 0, 0, File()},
+    {"/mbuf", 16, 0, 0, 0, 0, 0, 0, 0, File()},    // 256 KiB of backlog
+};
+
+static SemaphoreHandle_t lock;
+// Scratch space for the record being replayed.  Only the flushing task
+// writes it, so it stays valid while the lock is released for publish().
+static char recTopic[kMaxTopic + 1];
+static char recPayload[kMaxPayload + 1];
+static size_t recPayloadLen;        // payloads may be binary (MessagePack)
+static uint32_t recTime;            // capture time, 0 when unknown
+static uint8_t stamped[kMaxPayload + kStampLen];
+static uint32_t lastFlushMs;
+
+// RAM staging ring.  Single producer, single consumer: producers serialise
+// among themselves on ``ramMux`` (there are two producer tasks), the
+// consumer is whichever task calls bufferPoll()/bufferFlush().  Positions
+// are free-running byte counters; the difference is the fill level.  The
+// consumer may publish entries out of order by lane; it marks them sent
+// and the tail moves past them once everything before them is sent too.
+static uint8_t ram[kRamSize];
+static std::atomic<uint32_t> ramHead{0};     // written by producers
+static std::atomic<uint32_t> ramTail{0};     // written by the consumer
+static std::atomic<uint32_t> ramCount{0};    // entries not sent yet
+static std::atomic<uint32_t> spilledCount{0};
+static std::atomic<uint32_t> droppedCount{0};
+static portMUX_TYPE ramMux = portMUX_INITIALIZER_UNLOCKED;
+
+BufferLane bufferLaneOf(const char *topic) {
+    const char *ev = strstr(topic, "/event/");
+    if(!ev) return LANE_BULK;
+    ev += 7;
+    if(strncmp(ev, "clog", 4) == 0 || strcmp(ev, "filling") == 0) return LANE_ALARM;
+    return LANE_EVENT;
+}
+
+static uint32_t captureTime() {
+    time_t now = ntpNow();
+    return now >= kValidTime ? (uint32_t)now : 0;
+}
+
+static void segmentPath(const Log &g, char *out, size_t len, uint32_t seq) {
+    snprintf(out, len, "%s/%08lx", g.dir, (unsigned long)seq);
 }
 
-void bufferStore(const String& topic, const String& payload) {
-    File f = LittleFS.open("/buf", FILE_APPEND);
+static void cursorPath(const Log &g, char *out, size_t len) {
+    snprintf(out, len, "%s/cursor", g.dir);
+}
+
+static size_t segmentSize(const Log &g, uint32_t seq) {
+    char path[24];
+    segmentPath(g, path, sizeof(path), seq);
+    File f = LittleFS.open(path, FILE_READ);
+    if(!f) return 0;
+    size_t n = f.size();
+    f.close();
+    return n;
+}
+
+static uint32_t recordCrc(const RecordHeader &h, const char *topic, const char *payload) {
+    uint32_t crc = 0;
+    if(h.magic == kRecordMagic) crc = crc32Update(crc, &h.time, sizeof(h.time));
+    crc = crc32Update(crc, &h.topicLen, sizeof(h.topicLen));
+    crc = crc32Update(crc, &h.payloadLen, sizeof(h.payloadLen));
+    crc = crc32Update(crc, topic, h.topicLen);
+    return crc32Update(crc, payload, h.payloadLen);
+}
+
+// Read the record at the current position of ``f`` into the scratch
+// buffers.  Returns its total size, or 0 when the data there is not a
+// complete, valid record (end of segment or torn write).
+static size_t readRecord(File &f) {
+    RecordHeader h;
+    if(f.read((uint8_t*)&h, kHeaderLenV1) != kHeaderLenV1) return 0;
+    size_t headerLen = kHeaderLenV1;
+    h.time = 0;
+    if(h.magic == kRecordMagic) {
+        if(f.read((uint8_t*)&h.time, sizeof(h.time)) != sizeof(h.time)) return 0;
+        headerLen = sizeof(h);
+    } else if(h.magic != kRecordMagicV1) {
+        return 0;
+    }
+    if(h.topicLen == 0 || h.topicLen > kMaxTopic || h.payloadLen > kMaxPayload) return 0;
+    if(f.read((uint8_t*)recTopic, h.topicLen) != h.topicLen) return 0;
+    if(f.read((uint8_t*)recPayload, h.payloadLen) != h.payloadLen) return 0;
+    if(recordCrc(h, recTopic, recPayload) != h.crc) return 0;
+    recTopic[h.topicLen] = 0;
+    recPayload[h.payloadLen] = 0;
+    recPayloadLen = h.payloadLen;
+    recTime = h.time;
+    return headerLen + h.topicLen + h.payloadLen;
+}
+
+static void saveCursor(Log &g) {
+    g.savedMs = millis();
+    CursorRec c{g.readSeq, g.readOffset, 0};
+    c.crc = crc32Update(0, &c, offsetof(CursorRec, crc));
+    char path[24];
+    cursorPath(g, path, sizeof(path));
+    File f = LittleFS.open(path, FILE_WRITE);
     if(!f) return;
-    f.println(topic + "|" + payload);
+    f.write((const uint8_t*)&c, sizeof(c));
     f.close();
 }
 
-void bufferFlush() {
-    if(!LittleFS.exists("/buf")) return;
+static bool loadCursor(Log &g) {
+    char path[24];
+    cursorPath(g, path, sizeof(path));
+    File f = LittleFS.open(path, FILE_READ);
+    if(!f) return false;
+    CursorRec c;
+    bool ok = f.read((uint8_t*)&c, sizeof(c)) == sizeof(c) &&
+              c.crc == crc32Update(0, &c, offsetof(CursorRec, crc));
+    f.close();
+    if(!ok) return false;
+    g.readSeq = c.seq;
+    g.readOffset = c.offset;
+    return true;
+}
 
-    File rf = LittleFS.open("/buf", FILE_READ);
-    if(!rf) return;
+static void removeSegment(const Log &g, uint32_t seq) {
+    char path[24];
+    segmentPath(g, path, sizeof(path), seq);
+    LittleFS.remove(path);
+}
 
-    File wf;               // Создается только при ошибке отправки
-    bool failure = false;
+// Close the current segment and start appending to a fresh one, dropping
+// the oldest segment when the log would exceed its cap.
+static void startSegment(Log &g) {
+    if(g.writer) g.writer.close();
+    g.tailSeq++;
+    g.tailSize = 0;
+    while(g.tailSeq - g.headSeq >= g.maxSegments) {
+        if(g.readSeq == g.headSeq) {
+            size_t lost = segmentSize(g, g.headSeq);
+            g.backlog -= min(g.backlog, lost - min(lost, (size_t)g.readOffset));
+            g.readSeq = g.headSeq + 1;
+            g.readOffset = 0;
+        }
+        removeSegment(g, g.headSeq);
+        g.headSeq++;
+    }
+}
 
-    while(rf.available()) {
-        String line = rf.readStringUntil('\n');
-        int sep = line.indexOf('|');
-        if(sep <= 0) continue;
-        String topic   = line.substring(0, sep);
-        String payload = line.substring(sep + 1);
-
-        if(!failure && mqtt.publish(topic.c_str(), payload.c_str(), settings.mqttQos, false)) {
-            continue;           // успешно отправлено, переходим к следующей строке
-        }
-
-        if(!failure) {
-            // первая ошибка, открываем временный файл и записываем текущую строку
-            failure = true;
-            wf = LittleFS.open("/buf.tmp", FILE_WRITE);
-            if(!wf) {
-                // если не удалось открыть файл, выходим без изменений
-                rf.close();
-                return;
-            }
+static bool openWriter(Log &g) {
+    if(g.writer) return true;
+    char path[24];
+    segmentPath(g, path, sizeof(path), g.tailSeq);
+    g.writer = LittleFS.open(path, FILE_APPEND, true);
+    return (bool)g.writer;
+}
+
+// Append one record to the tail segment.  With ``sync`` false the caller
+// flushes the writer once after a batch.
+static bool appendLocked(Log &g, const char *topic, size_t topicLen, const char *payload,
+                         size_t payloadLen, uint32_t time, bool sync = true) {
+    if(topicLen == 0 || topicLen > kMaxTopic || payloadLen > kMaxPayload) return false;
+    RecordHeader h{kRecordMagic, (uint8_t)topicLen, (uint16_t)payloadLen, 0, time};
+    h.crc = recordCrc(h, topic, payload);
+    size_t len = sizeof(h) + topicLen + payloadLen;
+    if(g.tailSize > 0 && g.tailSize + len > kSegmentSize) startSegment(g);
+    if(!openWriter(g)) return false;
+    size_t n = g.writer.write((const uint8_t*)&h, sizeof(h));
+    n += g.writer.write((const uint8_t*)topic, topicLen);
+    n += g.writer.write((const uint8_t*)payload, payloadLen);
+    if(sync) g.writer.flush();
+    g.tailSize += n;
+    g.backlog += n;
+    if(n != len) {
+        // Partial write (flash full?): the torn record stays behind, so seal
+        // the segment and let the reader skip its tail.
+        startSegment(g);
+        return false;
+    }
+    return true;
+}
+
+// Find the end of the last complete record in the tail segment.  Anything
+// after it was torn by a reset; seal the segment so new records never
+// follow garbage.
+static void recoverTail(Log &g) {
+    char path[24];
+    segmentPath(g, path, sizeof(path), g.tailSeq);
+    File f = LittleFS.open(path, FILE_READ);
+    if(!f) { g.tailSize = 0; return; }
+    size_t fileSize = f.size();
+    size_t valid = 0;
+    size_t n;
+    while((n = readRecord(f)) > 0) valid += n;
+    f.close();
+    g.tailSize = fileSize;
+    if(valid != fileSize) startSegment(g);
+}
+
+// Find the segments of ``g`` and its cursor, and drop what was sent.
+static void openLog(Log &g) {
+    if(g.writer) g.writer.close();
+    LittleFS.mkdir(g.dir);
+    bool found = false;
+    uint32_t lo = 0, hi = 0;
+    size_t total = 0;
+    File dir = LittleFS.open(g.dir);
+    if(dir) {
+        for(File f = dir.openNextFile(); f; f = dir.openNextFile()) {
+            const char *name = strrchr(f.name(), '/');
+            name = name ? name + 1 : f.name();
+            char *end;
+            uint32_t seq = strtoul(name, &end, 16);
+            if(strlen(name) != 8 || *end) continue;
+            if(!found || seq < lo) lo = seq;
+            if(!found || seq > hi) hi = seq;
+            found = true;
+            total += f.size();
         }
-        wf.println(line);       // сохраняем текущую или последующие строки
+        dir.close();
+    }
+    bool haveCursor = loadCursor(g);
+    if(!found && haveCursor) lo = hi = g.readSeq;  // keep numbering monotonic
+    g.headSeq = lo;
+    g.tailSeq = hi;
+    if(!haveCursor || g.readSeq < g.headSeq || g.readSeq > g.tailSeq) {
+        g.readSeq = g.headSeq;
+        g.readOffset = 0;
     }
+    // Segments before the cursor were sent but not deleted yet.
+    for(uint32_t s = g.headSeq; s < g.readSeq; s++) {
+        total -= min(total, segmentSize(g, s));
+        removeSegment(g, s);
+    }
+    g.headSeq = g.readSeq;
+    g.backlog = total - min(total, (size_t)g.readOffset);
+    recoverTail(g);
+}
 
+// Convert the newline-separated ``topic|payload`` file written by older
+// firmware into log records.
+static void importLegacy() {
+    File rf = LittleFS.open(kLegacyPath, FILE_READ);
+    if(!rf) return;
+    if(rf.isDirectory()) { rf.close(); return; }
+    char line[kMaxTopic + kMaxPayload + 4];
+    while(rf.available()) {
+        size_t len = rf.readBytesUntil('\n', line, sizeof(line) - 1);
+        line[len] = 0;
+        if(len && line[len - 1] == '\r') line[--len] = 0;
+        char *sep = strchr(line, '|');
+        if(!sep || sep == line) continue;
+        *sep = 0;
+        appendLocked(logs[bufferLaneOf(line)], line, sep - line, sep + 1,
+                     len - (sep + 1 - line), 0, false);
+    }
+    for(Log &g : logs)
+        if(g.writer) g.writer.flush();
     rf.close();
+    LittleFS.remove(kLegacyPath);
+}
+
+static void ramCopyIn(uint32_t pos, const void *data, size_t len) {
+    size_t at = pos % kRamSize;
+    size_t first = min(len, kRamSize - at);
+    memcpy(ram + at, data, first);
+    memcpy(ram, (const uint8_t*)data + first, len - first);
+}
+
+static void ramCopyOut(uint32_t pos, void *data, size_t len) {
+    size_t at = pos % kRamSize;
+    size_t first = min(len, kRamSize - at);
+    memcpy(data, ram + at, first);
+    memcpy((uint8_t*)data + first, ram, len - first);
+}
+
+static bool ramPush(const char *topic, size_t topicLen, const char *payload, size_t payloadLen) {
+    RamHeader h{(uint8_t)topicLen, (uint8_t)bufferLaneOf(topic), 0, (uint16_t)payloadLen,
+                (uint32_t)millis(), captureTime()};
+    size_t len = sizeof(h) + topicLen + payloadLen;
+    portENTER_CRITICAL(&ramMux);
+    uint32_t head = ramHead.load(std::memory_order_relaxed);
+    uint32_t tail = ramTail.load(std::memory_order_acquire);
+    bool fits = kRamSize - (head - tail) >= len;
+    if(fits) {
+        ramCopyIn(head, &h, sizeof(h));
+        ramCopyIn(head + sizeof(h), topic, topicLen);
+        ramCopyIn(head + sizeof(h) + topicLen, payload, payloadLen);
+        ramHead.store(head + len, std::memory_order_release);
+        ramCount++;
+    }
+    portEXIT_CRITICAL(&ramMux);
+    return fits;
+}
+
+// Header of the RAM entry at ``pos``.  Returns the entry's size.
+// Consumer side only, like the rest of the ram* readers.
+static size_t ramHeader(uint32_t pos, RamHeader &h) {
+    ramCopyOut(pos, &h, sizeof(h));
+    return sizeof(h) + h.topicLen + h.payloadLen;
+}
+
+// Copy the RAM entry at ``pos`` into the scratch buffers.
+static void ramLoad(uint32_t pos, const RamHeader &h) {
+    ramCopyOut(pos + sizeof(h), recTopic, h.topicLen);
+    ramCopyOut(pos + sizeof(h) + h.topicLen, recPayload, h.payloadLen);
+    recTopic[h.topicLen] = 0;
+    recPayload[h.payloadLen] = 0;
+    recPayloadLen = h.payloadLen;
+    recTime = h.time;
+}
+
+static void ramMarkSent(uint32_t pos) {
+    uint8_t one = 1;
+    ramCopyIn(pos + offsetof(RamHeader, sent), &one, 1);
+    ramCount--;
+}
+
+// Move the tail past the entries already sent.  Returns the oldest
+// unsent entry's storedMs through ``oldestMs``, or false when none is left.
+static bool ramTrim(uint32_t *oldestMs = nullptr) {
+    uint32_t tail = ramTail.load(std::memory_order_relaxed);
+    uint32_t head = ramHead.load(std::memory_order_acquire);
+    RamHeader h;
+    while(tail != head) {
+        size_t n = ramHeader(tail, h);
+        if(!h.sent) break;
+        tail += n;
+    }
+    ramTail.store(tail, std::memory_order_release);
+    if(tail == head) return false;
+    if(oldestMs) *oldestMs = h.storedMs;
+    return true;
+}
+
+static size_t ramUsed() {
+    return ramHead.load(std::memory_order_acquire) - ramTail.load(std::memory_order_acquire);
+}
+
+// Move everything staged in RAM to the flash logs in one batch.
+static void spill() {
+    xSemaphoreTake(lock, portMAX_DELAY);
+    uint32_t tail = ramTail.load(std::memory_order_relaxed);
+    uint32_t head = ramHead.load(std::memory_order_acquire);
+    while(tail != head) {
+        RamHeader h;
+        size_t n = ramHeader(tail, h);
+        if(!h.sent) {
+            ramLoad(tail, h);
+            if(appendLocked(logs[h.lane], recTopic, h.topicLen, recPayload, recPayloadLen,
+                            h.time, false))
+                spilledCount++;
+            else
+                droppedCount++;
+            ramCount--;
+        }
+        tail += n;
+    }
+    ramTail.store(tail, std::memory_order_release);
+    for(Log &g : logs)
+        if(g.writer) g.writer.flush();
+    xSemaphoreGive(lock);
+}
+
+void bufferInit() {
+    LittleFS.begin(true);
+    if(!lock) lock = xSemaphoreCreateMutex();
+    xSemaphoreTake(lock, portMAX_DELAY);
+    LittleFS.mkdir(kRootDir);
+    for(Log &g : logs) openLog(g);
+    importLegacy();
+    xSemaphoreGive(lock);
+}
+
+bool bufferStore(const char* topic, const char* payload) {
+    return bufferStore(topic, payload, strlen(payload));
+}
+
+bool bufferStore(const char* topic, const char* payload, size_t payloadLen) {
+    size_t topicLen = strlen(topic);
+    if(topicLen == 0 || topicLen > kMaxTopic || payloadLen > kMaxPayload ||
+       !ramPush(topic, topicLen, payload, payloadLen)) {
+        droppedCount++;
+        return false;
+    }
+    return true;
+}
+
+void bufferPoll() {
+    if(!lock) return;
+    metricsSet(MET_BUFFER_BACKLOG, bufferBacklogBytes());
+    if(mqtt.connected()) {
+        // One paced batch per interval leaves the client time for its
+        // keepalive and for live messages between batches.
+        if(bufferBacklogBytes() && millis() - lastFlushMs >= kFlushIntervalMs) {
+            lastFlushMs = millis();
+            bufferFlush();
+        }
+        return;
+    }
+    uint32_t storedMs;
+    if(!ramTrim(&storedMs)) return;
+    if(ramUsed() >= kRamHighWater ||
+       millis() - storedMs >= (uint32_t)SettingsRef()->bufSpillSec * 1000)
+        spill();
+}
+
+size_t bufferBacklogBytes() {
+    size_t n = ramUsed();
+    for(const Log &g : logs) n += g.backlog;
+    return n;
+}
+
+BufferStats bufferStats() {
+    return {ramCount.load(), spilledCount.load(), droppedCount.load()};
+}
+
+// Add the capture time to the scratch payload as ``ts``: as the first
+// member of a JSON object or MessagePack map, or by wrapping a scalar as
+// {"value": ..., "ts": ...}.  Returns the payload to publish and its length
+// in ``len``.
+static const uint8_t *stampPayload(size_t &len) {
+    const uint8_t *p = (const uint8_t*)recPayload;
+    len = recPayloadLen;
+    if(!recTime || !len) return p;
+    uint8_t *out = stamped;
+    uint8_t first = p[0];
+    if(first == '{') {
+        int n = snprintf((char*)out, kStampLen, "{\"ts\":%lu%s", (unsigned long)recTime,
+                         len > 1 && p[1] != '}' ? "," : "");
+        memcpy(out + n, p + 1, len - 1);
+        len += n - 1;
+        return out;
+    }
+    static const uint8_t tsKey[] = {0xa2, 't', 's', 0xce};
+    if((first >= 0x80 && first < 0x8f) || first == 0xde) {
+        // A MessagePack map: one more entry, "ts" first.
+        size_t skip = first == 0xde ? 3 : 1;
+        if(first == 0xde) {
+            uint16_t count = (p[1] << 8 | p[2]) + 1;
+            out[0] = 0xde;
+            out[1] = count >> 8;
+            out[2] = count;
+        } else {
+            out[0] = first + 1;
+        }
+        memcpy(out + skip, tsKey, sizeof(tsKey));
+        uint8_t *q = out + skip + sizeof(tsKey);
+        for(int i = 3; i >= 0; i--) *q++ = recTime >> (8 * i);
+        memcpy(q, p + skip, len - skip);
+        len += sizeof(tsKey) + 4;
+        return out;
+    }
+    if(first == 0xca || first == 0xcb) {
+        // A MessagePack float: {"value": <float>, "ts": <time>}.
+        static const uint8_t valueKey[] = {0x82, 0xa5, 'v', 'a', 'l', 'u', 'e'};
+        uint8_t *q = out;
+        memcpy(q, valueKey, sizeof(valueKey));
+        q += sizeof(valueKey);
+        memcpy(q, p, len);
+        q += len;
+        memcpy(q, tsKey, sizeof(tsKey));
+        q += sizeof(tsKey);
+        for(int i = 3; i >= 0; i--) *q++ = recTime >> (8 * i);
+        len = q - out;
+        return out;
+    }
+    char *end;
+    float v = strtof(recPayload, &end);
+    if(end != recPayload + len || !isfinite(v)) return p;   // not a number: as stored
+    len = snprintf((char*)out, sizeof(stamped), "{\"value\":%s,\"ts\":%lu}", recPayload,
+                   (unsigned long)recTime);
+    return out;
+}
+
+// What one bufferFlush() may still send.
+struct Budget {
+    uint16_t messages;
+    size_t bytes;
+    size_t sent;
+    bool failed;
+
+    bool open() const { return !failed && messages && bytes; }
+};
+
+// Publish the scratch record and charge it to the batch.
+static bool replay(Budget &b) {
+    size_t len;
+    const uint8_t *payload = stampPayload(len);
+    if(!mqtt.publish(recTopic, payload, len, false)) {
+        metricsCount(MET_PUBLISH_FAILS);
+        b.failed = true;
+        return false;
+    }
+    b.messages--;
+    b.bytes -= min(b.bytes, len + strlen(recTopic));
+    b.sent++;
+    return true;
+}
 
-    if(!failure) {
-        LittleFS.remove("/buf");
-    } else {
-        wf.close();
-        LittleFS.remove("/buf");
-        LittleFS.rename("/buf.tmp", "/buf");
+// Replay the flash log of one lane from its cursor, within the budget.
+// Returns true when the log is empty.
+static bool flushLog(Log &g, Budget &b) {
+    xSemaphoreTake(lock, portMAX_DELAY);
+    bool moved = false;
+    File rf;
+    uint32_t openSeq = 0;
+    bool fresh = false;     // rf was opened since the lock was last released
+    while(b.open()) {
+        if(g.readSeq == g.tailSeq && g.readOffset >= g.tailSize) {
+            // Everything sent: drop the segment and start the next one
+            // empty so the log does not keep growing a sent file.
+            if(g.tailSize > 0) {
+                if(rf) rf.close();
+                if(g.writer) g.writer.close();
+                removeSegment(g, g.tailSeq);
+                g.tailSeq++;
+                g.tailSize = 0;
+                g.headSeq = g.readSeq = g.tailSeq;
+                g.readOffset = 0;
+                g.backlog = 0;
+                moved = true;
+            }
+            break;
+        }
+        if(!rf || openSeq != g.readSeq) {
+            if(rf) rf.close();
+            char path[24];
+            segmentPath(g, path, sizeof(path), g.readSeq);
+            rf = LittleFS.open(path, FILE_READ);
+            openSeq = g.readSeq;
+            fresh = true;
+            if(!rf || !rf.seek(g.readOffset)) {
+                if(rf) rf.close();
+                if(g.readSeq == g.tailSeq) break;
+                g.readSeq++;
+                g.readOffset = 0;
+                moved = true;
+                continue;
+            }
+        }
+        size_t n = readRecord(rf);
+        if(n == 0 && !fresh) {
+            // Records appended while the lock was released may not be
+            // visible through this handle yet; look again before deciding.
+            rf.close();
+            continue;
+        }
+        if(n == 0) {
+            // End of segment, or a torn record.  In the tail segment that
+            // can only be a failed write; seal it so the reader moves on.
+            uint32_t done = g.readSeq;
+            size_t size = segmentSize(g, done);
+            size_t rest = size - min(size, (size_t)g.readOffset);
+            rf.close();
+            if(done == g.tailSeq) startSegment(g);
+            if(g.readSeq == done) {
+                g.backlog -= min(g.backlog, rest);
+                removeSegment(g, done);
+                g.readSeq = g.headSeq = done + 1;
+                g.readOffset = 0;
+            }
+            moved = true;
+            continue;
+        }
+        // Publish without holding the lock so producers never wait on the
+        // broker.  Only eviction can touch the read side meanwhile; if it
+        // dropped this segment the cursor has already moved past it.
+        uint32_t seq = g.readSeq;
+        fresh = false;
+        xSemaphoreGive(lock);
+        bool sent = replay(b);
+        xSemaphoreTake(lock, portMAX_DELAY);
+        if(!sent) break;
+        if(g.readSeq == seq) {
+            g.readOffset += n;
+            g.backlog -= min(g.backlog, n);
+        }
+        moved = true;
     }
+    if(rf) rf.close();
+    // Paced batches save the cursor about once a second: a reset in between
+    // repeats at most that much, and the cursor file is not rewritten for
+    // every batch.
+    bool empty = g.readSeq == g.tailSeq && g.readOffset >= g.tailSize;
+    if(moved && (empty || b.failed || millis() - g.savedMs >= kCursorSaveMs)) saveCursor(g);
+    xSemaphoreGive(lock);
+    return empty;
+}
+
+// Replay the RAM entries of one lane, oldest first, within the budget.
+static void flushRam(uint8_t lane, Budget &b) {
+    uint32_t pos = ramTail.load(std::memory_order_relaxed);
+    uint32_t head = ramHead.load(std::memory_order_acquire);
+    while(pos != head && b.open()) {
+        RamHeader h;
+        size_t n = ramHeader(pos, h);
+        if(!h.sent && h.lane == lane) {
+            ramLoad(pos, h);
+            if(!replay(b)) return;
+            ramMarkSent(pos);
+        }
+        pos += n;
+    }
+}
+
+size_t bufferFlush(uint16_t maxMessages, size_t maxBytes) {
+    if(!lock) return 0;
+    MetricsScope timed(MET_BUFFER_FLUSH);
+    Budget b = {maxMessages, maxBytes, 0, false};
+    // Lane by lane; within a lane the flash log is older than the RAM ring.
+    for(uint8_t lane = 0; lane < LANE_COUNT && b.open(); lane++)
+        if(flushLog(logs[lane], b)) flushRam(lane, b);
+    ramTrim();
+    return b.sent;
 }
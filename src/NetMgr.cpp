@@ -0,0 +1,200 @@
+#include "NetMgr.h"
+#include "Config.h"
+#include "LedFSM.h"
+#include "Metrics.h"
+#include "MqttPub.h"
+#include "Topics.h"
+#include "Trace.h"
+#include <WiFi.h>
+#include <PubSubClient.h>
+#include <atomic>
+
+extern PubSubClient mqtt;
+
+static const uint32_t kRetryMinMs = 500;
+static const uint32_t kRetryBaseMs = 1000;      // first backoff window
+static const uint32_t kRetryCapMs = 300000;     // backoff never exceeds 5 min
+
+static NetState state = NetState::WIFI_DOWN;
+static volatile bool linkUp = false;            // set from the Wi-Fi event task
+static uint32_t failures = 0;
+static uint32_t dueMs = 0;                      // next attempt, millis()
+static std::atomic<uint32_t> changes(0);        // SettingsSection bits not yet applied
+
+// Broker settings of the current attempt.  PubSubClient keeps the host
+// pointer, so it must not point into a settings snapshot that a later
+// commit rewrites.
+static char host[sizeof(Settings::mqttHost)];
+static char user[sizeof(Settings::mqttUser)];
+static char pass[sizeof(Settings::mqttPass)];
+
+// PubSubClient builds each packet in one buffer and refuses anything
+// larger (256 bytes by default).  Room for a 63-character topic, the
+// largest queued payload, the "ts" added on replay and the headers.
+static const uint16_t kMqttPacketSize = 512;
+static_assert(kMqttPacketSize >= 5 + 2 + 63 + kPubMaxPayload + 32, "MQTT packet buffer too small");
+
+static void mqttCallback(char*, byte*, unsigned int) {
+    // handle incoming messages
+}
+
+// Wait before retry number ``failures``: uniformly random within a window
+// that doubles with each failure.  Full jitter keeps nodes that lost the
+// broker at the same moment from coming back in lockstep.
+static uint32_t retryDelay(uint32_t n) {
+    uint32_t window = n >= 19 ? kRetryCapMs : min(kRetryCapMs, kRetryBaseMs << n);
+    return kRetryMinMs + esp_random() % window;
+}
+
+static void schedule(uint32_t delayMs) {
+    dueMs = millis() + delayMs;
+}
+
+static bool due() {
+    return (int32_t)(millis() - dueMs) >= 0;
+}
+
+static void enter(NetState s) {
+    if(s == state) return;
+    state = s;
+    failures = 0;
+    ledSetLink(s == NetState::ONLINE);
+}
+
+static void onWiFiEvent(arduino_event_id_t event) {
+    if(event == ARDUINO_EVENT_WIFI_STA_GOT_IP) linkUp = true;
+    else if(event == ARDUINO_EVENT_WIFI_STA_DISCONNECTED ||
+            event == ARDUINO_EVENT_WIFI_STA_LOST_IP) linkUp = false;
+}
+
+// Single connection attempt to the broker defined in Settings.  A Last
+// Will message is registered so that clients are notified when the
+// device goes offline.
+static bool connectMQTT() {
+    uint16_t port;
+    uint8_t qos;
+    {
+        SettingsRef cfg;                // copied out: connect() blocks
+        strlcpy(host, cfg->mqttHost, sizeof(host));
+        strlcpy(user, cfg->mqttUser, sizeof(user));
+        strlcpy(pass, cfg->mqttPass, sizeof(pass));
+        port = cfg->mqttPort;
+        qos = cfg->mqttQos;
+    }
+    mqtt.setServer(host, port);
+    mqtt.setBufferSize(kMqttPacketSize);
+    mqtt.setCallback(mqttCallback);
+    mqtt.setSocketTimeout(5);
+    const char *willTopic = topic(TOPIC_STATUS);
+    String clientId = String("client-") + String((uint32_t)ESP.getEfuseMac(), HEX);
+    if(!mqtt.connect(clientId.c_str(), user, pass, willTopic, qos, true, "offline"))
+        return false;
+    mqtt.publish(willTopic, "online", true);
+    return true;
+}
+
+// Connect to Wi-Fi using credentials from Settings.  When no credentials
+// are configured the board starts in AP mode so that the user can provide
+// them via the web interface.
+static void startWiFi() {
+    SettingsRef cfg;
+    if(strlen(cfg->wifiSSID) == 0) {
+        WiFi.disconnect();
+        WiFi.softAP("start", "starttrats");
+        state = NetState::AP_MODE;
+        failures = 0;
+        ledSetLink(false);
+        trace(TR_WIFI_AP);
+        return;
+    }
+    WiFi.mode(WIFI_STA);                // also ends a soft AP
+    WiFi.setAutoReconnect(false);       // retries follow our backoff
+    WiFi.begin(cfg->wifiSSID, cfg->wifiPass);
+    linkUp = false;
+    state = NetState::WIFI_DOWN;
+    failures = 0;
+    schedule(10000);                    // as long as the old blocking wait
+    ledSetLink(false);
+}
+
+// Settings listener, called in the web server task: note the change for
+// netService(), which owns the connections.
+static void onSettingsChanged(uint32_t changed) {
+    changes.fetch_or(changed);
+}
+
+void netBegin() {
+    WiFi.onEvent(onWiFiEvent);
+    settingsSubscribe(SET_WIFI | SET_BROKER | SET_SITE, onSettingsChanged);
+    startWiFi();
+}
+
+// Apply settings committed since the last call.  New Wi-Fi credentials
+// restart the station (or the soft AP); a new broker or site name, which
+// is part of the Last Will topic, ends the MQTT session so that the next
+// attempt, made at once, uses the new values.
+static void applyChanges() {
+    uint32_t changed = changes.exchange(0);
+    if(!changed) return;
+    if(changed & SET_WIFI) {
+        if(state == NetState::ONLINE) mqtt.disconnect();
+        trace(TR_WIFI_SETTINGS);
+        startWiFi();
+    } else if(state == NetState::ONLINE || state == NetState::MQTT_WAIT) {
+        if(state == NetState::ONLINE) mqtt.disconnect();
+        trace(TR_MQTT_SETTINGS);
+        enter(NetState::MQTT_WAIT);
+        failures = 0;
+        schedule(0);
+    }
+}
+
+void netService() {
+    applyChanges();
+    switch(state) {
+        case NetState::AP_MODE:
+            return;
+        case NetState::WIFI_DOWN:
+            if(linkUp) {
+                metricsCount(MET_WIFI_CONNECTS);
+                trace(TR_WIFI_UP);
+                enter(NetState::MQTT_WAIT);
+                schedule(esp_random() % kRetryBaseMs);
+            } else if(due()) {
+                WiFi.reconnect();
+                schedule(retryDelay(++failures));
+            }
+            return;
+        case NetState::MQTT_WAIT:
+            if(!linkUp) {
+                enter(NetState::WIFI_DOWN);
+                schedule(retryDelay(0));
+            } else if(due()) {
+                if(connectMQTT()) {
+                    metricsCount(MET_MQTT_CONNECTS);
+                    enter(NetState::ONLINE);
+                    trace(TR_MQTT_UP);
+                } else {
+                    schedule(retryDelay(++failures));
+                    trace(TR_MQTT_FAIL, failures);
+                }
+            }
+            return;
+        case NetState::ONLINE:
+            if(linkUp && mqtt.loop()) return;
+            mqtt.disconnect();
+            metricsCount(MET_MQTT_LOST);
+            trace(linkUp ? TR_MQTT_LOST : TR_WIFI_LOST);
+            enter(linkUp ? NetState::MQTT_WAIT : NetState::WIFI_DOWN);
+            schedule(retryDelay(0));
+            return;
+    }
+}
+
+NetState netState() {
+    return state;
+}
+
+uint32_t netFailures() {
+    return failures;
+}
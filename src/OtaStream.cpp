@@ -0,0 +1,194 @@
+#include "OtaStream.h"
+#include "mbedtls/ecdsa.h"
+
+// Manifest layout, little-endian:
+//   0  magic "CHPO"      4  version        5  format
+//   6  window bits       7  lookahead bits 8  image size (u32)
+//   12 SHA-256 of the image
+//   44 ECDSA P-256 signature of SHA-256(bytes 0..43), r || s big-endian
+static const uint8_t kVersion = 2;
+static const size_t kSignedLen = 44;
+
+static bool equalsConst(const uint8_t *a, const uint8_t *b, size_t len) {
+    uint8_t diff = 0;
+    for(size_t i = 0; i < len; i++) diff |= a[i] ^ b[i];
+    return diff == 0;
+}
+
+static bool verifySignature(const uint8_t *publicKey, const uint8_t *msg, size_t len,
+                            const uint8_t sig[64]) {
+    uint8_t hash[32];
+    mbedtls_sha256_ret(msg, len, hash, 0);
+    mbedtls_ecp_group grp;
+    mbedtls_ecp_point q;
+    mbedtls_mpi r, s;
+    mbedtls_ecp_group_init(&grp);
+    mbedtls_ecp_point_init(&q);
+    mbedtls_mpi_init(&r);
+    mbedtls_mpi_init(&s);
+    int ret = mbedtls_ecp_group_load(&grp, MBEDTLS_ECP_DP_SECP256R1);
+    if(!ret) ret = mbedtls_ecp_point_read_binary(&grp, &q, publicKey, kOtaPublicKeyLen);
+    if(!ret) ret = mbedtls_mpi_read_binary(&r, sig, 32);
+    if(!ret) ret = mbedtls_mpi_read_binary(&s, sig + 32, 32);
+    if(!ret) ret = mbedtls_ecdsa_verify(&grp, hash, sizeof(hash), &q, &r, &s);
+    mbedtls_mpi_free(&s);
+    mbedtls_mpi_free(&r);
+    mbedtls_ecp_point_free(&q);
+    mbedtls_ecp_group_free(&grp);
+    return ret == 0;
+}
+
+void OtaStream::begin(Writer w, const uint8_t *key) {
+    writer = w;
+    publicKey = key;
+    err = OTA_OK;
+    state = HEADER;
+    memset(&man, 0, sizeof(man));
+    mbedtls_sha256_init(&sha);
+    mbedtls_sha256_starts_ret(&sha, 0);
+    total = 0;
+    headerLen = 0;
+    acc = 0;
+    accBits = 0;
+    head = 0;
+    outLen = 0;
+}
+
+bool OtaStream::fail(OtaError e) {
+    if(!err) err = e;
+    state = DONE;
+    return false;
+}
+
+bool OtaStream::parseHeader() {
+    const uint8_t *h = header;
+    man.version = h[4];
+    man.format = (OtaFormat)h[5];
+    man.window = h[6];
+    man.lookahead = h[7];
+    man.imageSize = h[8] | (h[9] << 8) | (h[10] << 16) | ((uint32_t)h[11] << 24);
+    memcpy(man.sha256, h + 12, sizeof(man.sha256));
+    if(man.version != kVersion || man.format > OTA_HEATSHRINK) return fail(OTA_BAD_MANIFEST);
+    if(man.format == OTA_HEATSHRINK &&
+       (man.window < 4 || man.window > kOtaMaxWindow ||
+        man.lookahead < 3 || man.lookahead >= man.window))
+        return fail(OTA_BAD_MANIFEST);
+    if(!verifySignature(publicKey, h, kSignedLen, h + kSignedLen)) return fail(OTA_BAD_SIGNATURE);
+    memset(window, 0, sizeof(window));
+    state = man.format == OTA_HEATSHRINK ? TAG : PLAIN;
+    return true;
+}
+
+bool OtaStream::flush() {
+    if(!outLen) return true;
+    mbedtls_sha256_update_ret(&sha, out, outLen);
+    bool ok = writer(out, outLen);
+    outLen = 0;
+    return ok || fail(OTA_WRITE_FAILED);
+}
+
+bool OtaStream::emit(uint8_t b) {
+    if(total >= man.imageSize) return fail(OTA_TOO_LONG);
+    out[outLen++] = b;
+    total++;
+    return outLen < sizeof(out) || flush();
+}
+
+bool OtaStream::takeBits(uint8_t n, uint16_t &v) {
+    while(accBits < n) {
+        if(!inLen) return false;
+        acc = (acc << 8) | *in++;
+        inLen--;
+        accBits += 8;
+    }
+    accBits -= n;
+    v = (acc >> accBits) & ((1u << n) - 1);
+    return true;
+}
+
+// Heatshrink: a 1 bit, then a literal byte; or a 0 bit, then the distance
+// back minus one (window bits) and the length minus one (lookahead bits)
+// of a copy from the window.  Runs until the chunk is used up.
+bool OtaStream::decode() {
+    uint16_t mask = (1 << man.window) - 1;
+    uint16_t v;
+    for(;;) {
+        switch(state) {
+            case TAG:
+                if(!takeBits(1, v)) return true;
+                state = v ? LITERAL : INDEX;
+                break;
+            case LITERAL:
+                if(!takeBits(8, v)) return true;
+                window[head] = v;
+                head = (head + 1) & mask;
+                if(!emit(v)) return false;
+                state = TAG;
+                break;
+            case INDEX:
+                if(!takeBits(man.window, index)) return true;
+                state = COUNT;
+                break;
+            case COUNT:
+                if(!takeBits(man.lookahead, v)) return true;
+                for(uint16_t i = 0; i <= v; i++) {
+                    uint8_t b = window[(head - index - 1) & mask];
+                    window[head] = b;
+                    head = (head + 1) & mask;
+                    if(!emit(b)) return false;
+                }
+                state = TAG;
+                break;
+            default:
+                return state != DONE;
+        }
+    }
+}
+
+bool OtaStream::feed(const uint8_t *data, size_t len) {
+    if(err) return false;
+    while(state == HEADER && len) {
+        header[headerLen++] = *data++;
+        len--;
+        if(headerLen <= sizeof(kOtaMagic) && header[headerLen - 1] != kOtaMagic[headerLen - 1])
+            return fail(OTA_UNSIGNED);          // not a package: a plain image
+        if(headerLen == kOtaHeaderLen && !parseHeader()) return false;
+    }
+    if(state == PLAIN) {
+        if(len > man.imageSize - total) return fail(OTA_TOO_LONG);
+        if(!flush()) return false;
+        mbedtls_sha256_update_ret(&sha, data, len);
+        total += len;
+        return !len || writer(data, len) || fail(OTA_WRITE_FAILED);
+    }
+    in = data;
+    inLen = len;
+    return decode();
+}
+
+bool OtaStream::finish() {
+    if(err) return false;
+    if(!flush()) return false;
+    State was = state;
+    state = DONE;
+    if(was == HEADER) return fail(OTA_TRUNCATED);
+    if(total != man.imageSize) return fail(OTA_TRUNCATED);
+    uint8_t digest[32];
+    mbedtls_sha256_finish_ret(&sha, digest);
+    mbedtls_sha256_free(&sha);
+    return equalsConst(digest, man.sha256, sizeof(digest)) || fail(OTA_BAD_HASH);
+}
+
+const char *OtaStream::errorText(OtaError e) {
+    switch(e) {
+        case OTA_OK:            return "ok";
+        case OTA_BAD_MANIFEST:  return "bad manifest";
+        case OTA_BAD_SIGNATURE: return "bad signature";
+        case OTA_UNSIGNED:      return "unsigned image";
+        case OTA_TOO_LONG:      return "image too long";
+        case OTA_TRUNCATED:     return "image truncated";
+        case OTA_BAD_HASH:      return "hash mismatch";
+        case OTA_WRITE_FAILED:  return "flash write failed";
+    }
+    return "?";
+}
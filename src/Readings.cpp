@@ -0,0 +1,51 @@
+#include "Readings.h"
+#include <atomic>
+
+static Readings data = {0, {NAN, NAN, NAN, NAN, NAN, NAN, NAN}, {0}, 0, 90, 90};
+static std::atomic<uint32_t> seq(0);            // odd while data is being written
+static portMUX_TYPE writeMux = portMUX_INITIALIZER_UNLOCKED;
+
+// Open a write: readers that overlap it see an odd or changed sequence
+// number and retry.  The critical section also keeps a reader on this
+// core from running until the write is closed.
+static void beginWrite() {
+    portENTER_CRITICAL(&writeMux);
+    seq.store(seq.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+static void endWrite() {
+    data.version++;
+    seq.store(seq.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    portEXIT_CRITICAL(&writeMux);
+}
+
+void readingsPublish(uint8_t mask, const float values[READ_COUNT]) {
+    uint32_t now = millis();
+    beginWrite();
+    for(uint8_t i = 0; i < READ_COUNT; i++) {
+        if(!(mask & (1 << i))) continue;
+        data.value[i] = values[i];
+        data.sampledMs[i] = now;
+        if(isnan(values[i])) data.valid &= ~(1 << i);
+        else data.valid |= 1 << i;
+    }
+    endWrite();
+}
+
+void readingsSetHead(int x, int y) {
+    beginWrite();
+    data.headX = x;
+    data.headY = y;
+    endWrite();
+}
+
+void readingsGet(Readings &out) {
+    for(;;) {
+        uint32_t before = seq.load(std::memory_order_acquire);
+        if(before & 1) continue;        // a writer on the other core, a few µs at most
+        out = data;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if(seq.load(std::memory_order_relaxed) == before) return;
+    }
+}
@@ -1,8 +1,10 @@
 #include "SDP810.h"
+#include "Crc.h"
 
 bool SDP810::begin(TwoWire &w, uint8_t addr) {
     wire = &w;
     address = addr;
+    scale = 0;
     wire->begin();
     wire->beginTransmission(address);
     wire->write(0x36);
@@ -10,19 +12,32 @@ bool SDP810::begin(TwoWire &w, uint8_t addr) {
     return wire->endTransmission() == 0;
 }
 
-float SDP810::readPressure(float *temperature) {
-    if(!wire) return NAN;
-    wire->requestFrom((int)address, 9);
+bool SDP810::read(float &pressure, float *temperature) {
+    if(!wire) return false;
+    // Words: differential pressure, temperature, scale factor; each is two
+    // bytes followed by a CRC byte.
+    int words = scale == 0 ? 3 : (temperature ? 2 : 1);
+    int len = words * 3;
     uint8_t data[9];
-    int i = 0;
-    while(wire->available() && i < 9) {
-        data[i++] = wire->read();
+    if(wire->requestFrom((int)address, len) != len) return false;
+    for(int i = 0; i < len; i++) data[i] = wire->read();
+    for(int w = 0; w < words; w++)
+        if(crc8Sensirion(&data[w * 3], 2) != data[w * 3 + 2]) return false;
+    if(words == 3) {
+        int16_t s = (data[6] << 8) | data[7];
+        if(s == 0) return false;
+        scale = s;
     }
-    if(i != 9) return NAN;
     int16_t dpRaw = (data[0] << 8) | data[1];
-    int16_t tempRaw = (data[3] << 8) | data[4];
-    int16_t scale = (data[6] << 8) | data[7];
-    if(scale == 0) return NAN;
-    if(temperature) *temperature = tempRaw / 200.0f;
-    return (float)dpRaw / (float)scale;
+    pressure = (float)dpRaw / (float)scale;
+    if(temperature && words >= 2) {
+        int16_t tempRaw = (data[3] << 8) | data[4];
+        *temperature = tempRaw / 200.0f;
+    }
+    return true;
+}
+
+float SDP810::readPressure(float *temperature) {
+    float p;
+    return read(p, temperature) ? p : NAN;
 }
@@ -0,0 +1,163 @@
+#include "Scan.h"
+#include "Lidar.h"
+
+static const uint32_t kServoMsPerDeg = 2;       // hobby servo, ~0.1 s per 60°
+static const uint32_t kServoMinMs = 10;
+static const uint32_t kPointTimeoutMs = 300;    // leave the cell empty after this
+static const float kSettleMm = 20;              // frames this close: head is still
+static const int kChangeMm = 50;
+
+static DepthMap maps[2];
+static uint8_t latest;                          // maps[latest] is the last result
+static ScanMetrics metrics;
+static ScanStatus status;
+static portMUX_TYPE scanMux = portMUX_INITIALIZER_UNLOCKED;
+
+static uint8_t pct(int part, int whole) {
+    return whole ? (uint8_t)((part * 100 + whole / 2) / whole) : 0;
+}
+
+// Angle of point ``i`` of ``n`` spread evenly from ``a`` to ``b``.
+static int spread(uint8_t a, uint8_t b, int i, int n) {
+    return a + ((b - a) * i * 2 + (n - 1)) / (2 * (n - 1));
+}
+
+// Wait until the head has come to rest and return the settled distance,
+// or 0 when the sensor gives nothing usable in time.
+static uint16_t capture() {
+    lidarFlush();
+    uint32_t start = millis();
+    float prev = NAN;
+    uint16_t want = 1;
+    for(;;) {
+        uint32_t waited = millis() - start;
+        if(waited >= kPointTimeoutMs) return 0;
+        LidarReading r;
+        if(!lidarWait(r, want, kPointTimeoutMs - waited)) return 0;
+        if(fabsf(r.last - prev) <= kSettleMm) {
+            float mm = (r.last + prev) / 2 + 0.5f;
+            return mm > UINT16_MAX ? UINT16_MAX : (uint16_t)mm;
+        }
+        prev = r.last;
+        want = r.samples + 1;
+    }
+}
+
+bool scanRun(const ScanSettings &grid, uint16_t blockMm, ScanMoveFn move, ScanAbortFn abort) {
+    int cols = constrain(grid.cols, 2, kScanMaxDim);
+    int rows = constrain(grid.rows, 2, kScanMaxDim);
+    int total = cols * rows;
+    DepthMap &map = maps[latest ^ 1];           // only this task writes it
+    map.cols = cols;
+    map.rows = rows;
+    portENTER_CRITICAL(&scanMux);
+    status.running = true;
+    status.done = 0;
+    status.total = total;
+    portEXIT_CRITICAL(&scanMux);
+
+    // Serpentine order: odd rows run right to left.
+    int x = 0, y = 0;
+    auto moveTo = [&](int i) -> uint32_t {
+        int r = i / cols, c = i % cols;
+        if(r & 1) c = cols - 1 - c;
+        int nx = spread(grid.xMin, grid.xMax, c, cols);
+        int ny = spread(grid.yMin, grid.yMax, r, rows);
+        uint32_t travel = i == 0 ? 180 : max(abs(nx - x), abs(ny - y));
+        x = nx;
+        y = ny;
+        move(x, y);
+        return max(kServoMinMs, travel * kServoMsPerDeg);
+    };
+
+    uint32_t start = millis();
+    uint32_t travelMs = moveTo(0);
+    bool done = false;
+    for(int i = 0; ; i++) {
+        vTaskDelay(pdMS_TO_TICKS(travelMs));
+        uint16_t mm = capture();
+        int r = i / cols, c = i % cols;
+        if(r & 1) c = cols - 1 - c;
+        bool last = i + 1 == total;
+        bool stop = !last && abort && abort();
+        uint32_t moved = millis();
+        if(!last && !stop) travelMs = moveTo(i + 1);
+        map.mm[r * cols + c] = mm;
+        portENTER_CRITICAL(&scanMux);
+        status.done = i + 1;
+        portEXIT_CRITICAL(&scanMux);
+        if(last || stop) {
+            done = last;
+            break;
+        }
+        uint32_t spent = millis() - moved;
+        travelMs = travelMs > spent ? travelMs - spent : 0;
+    }
+
+    uint32_t now = millis();
+    if(done) {
+        map.ms = now;
+        const DepthMap &prev = maps[latest];
+        ScanMetrics m;
+        scanCompare(map, prev.ms ? &prev : nullptr, blockMm, m);
+        portENTER_CRITICAL(&scanMux);
+        latest ^= 1;
+        metrics = m;
+        portEXIT_CRITICAL(&scanMux);
+    }
+    portENTER_CRITICAL(&scanMux);
+    status.running = false;
+    if(done) status.durationMs = now - start;
+    portEXIT_CRITICAL(&scanMux);
+    return done;
+}
+
+void scanCompare(const DepthMap &cur, const DepthMap *prev, uint16_t blockMm, ScanMetrics &m) {
+    int n = cur.cols * cur.rows;
+    bool same = prev && prev->cols == cur.cols && prev->rows == cur.rows;
+    int valid = 0, blocked = 0, compared = 0, changed = 0;
+    int32_t delta = 0;
+    uint16_t minMm = 0;
+    for(int i = 0; i < n; i++) {
+        uint16_t v = cur.mm[i];
+        if(!v) continue;
+        valid++;
+        if(!minMm || v < minMm) minMm = v;
+        if(v < blockMm) blocked++;
+        if(same && prev->mm[i]) {
+            int d = (int)v - (int)prev->mm[i];
+            compared++;
+            delta += d;
+            if(abs(d) > kChangeMm) changed++;
+        }
+    }
+    m.minMm = minMm;
+    m.validPct = pct(valid, n);
+    m.blockedPct = pct(blocked, valid);
+    m.changedPct = pct(changed, compared);
+    m.meanDeltaMm = compared ? (int16_t)(delta / compared) : 0;
+    m.compared = compared;
+}
+
+bool scanLatest(DepthMap &map, ScanMetrics &m) {
+    portENTER_CRITICAL(&scanMux);
+    map = maps[latest];
+    m = metrics;
+    portEXIT_CRITICAL(&scanMux);
+    return map.ms != 0;
+}
+
+bool scanMetrics(ScanMetrics &m) {
+    portENTER_CRITICAL(&scanMux);
+    m = metrics;
+    bool have = maps[latest].ms != 0;
+    portEXIT_CRITICAL(&scanMux);
+    return have;
+}
+
+ScanStatus scanStatus() {
+    portENTER_CRITICAL(&scanMux);
+    ScanStatus s = status;
+    portEXIT_CRITICAL(&scanMux);
+    return s;
+}
@@ -0,0 +1,77 @@
+#include "Scheduler.h"
+
+int Scheduler::add(Job job, uint32_t periodMs, uint32_t firstDueMs) {
+    if(count == kMaxJobs) return -1;
+    int id = count++;
+    jobs[id] = {job, periodMs, firstDueMs, firstDueMs - periodMs};
+    heap[id] = id;
+    pos[id] = id;
+    siftUp(id);
+    return id;
+}
+
+void Scheduler::setPeriod(int id, uint32_t periodMs) {
+    Entry &e = jobs[id];
+    if(e.period == periodMs) return;
+    e.period = periodMs;
+    uint32_t next = e.lastRun + periodMs;
+    if(before(next, e.due)) reschedule(id, next);
+}
+
+void Scheduler::trigger(int id, uint32_t atMs) {
+    if(before(atMs, jobs[id].due)) reschedule(id, atMs);
+}
+
+void Scheduler::runDue(uint32_t now) {
+    while(count > 0) {
+        int id = heap[0];
+        Entry &e = jobs[id];
+        if(before(now, e.due)) return;
+        e.lastRun = now;
+        // Keep the grid of deadlines unless we fell more than a period
+        // behind (first run, long job, trigger); then restart from now.
+        uint32_t next = e.due + e.period;
+        if(!before(now, next)) next = now + e.period;
+        reschedule(id, next);
+        e.job();
+    }
+}
+
+uint32_t Scheduler::msUntilNext(uint32_t now) const {
+    if(count == 0) return portMAX_DELAY;
+    uint32_t due = jobs[heap[0]].due;
+    return before(now, due) ? due - now : 0;
+}
+
+void Scheduler::reschedule(int id, uint32_t due) {
+    bool earlier = before(due, jobs[id].due);
+    jobs[id].due = due;
+    if(earlier) siftUp(pos[id]);
+    else siftDown(pos[id]);
+}
+
+void Scheduler::swap(int i, int j) {
+    uint8_t t = heap[i];
+    heap[i] = heap[j];
+    heap[j] = t;
+    pos[heap[i]] = i;
+    pos[heap[j]] = j;
+}
+
+void Scheduler::siftUp(int i) {
+    while(i > 0 && less(i, (i - 1) / 2)) {
+        swap(i, (i - 1) / 2);
+        i = (i - 1) / 2;
+    }
+}
+
+void Scheduler::siftDown(int i) {
+    for(;;) {
+        int c = 2 * i + 1;
+        if(c >= count) return;
+        if(c + 1 < count && less(c + 1, c)) c++;
+        if(!less(c, i)) return;
+        swap(i, c);
+        i = c;
+    }
+}
@@ -0,0 +1,131 @@
+#include "Sensors.h"
+#include <Wire.h>
+#include <MQUnifiedsensor.h>
+#include <Preferences.h>
+#include "SparkFun_ENS160.h"
+#include <Adafruit_AHTX0.h>
+#include "SDP810.h"
+#include "AdcSampler.h"
+#include "Metrics.h"
+#include <atomic>
+
+static const uint8_t kMq2Pin = 34;
+static const float kMq2CleanAir = 9.83f;        // Rs/R0 in clean air (datasheet)
+static const char *kMq2Prefs = "mq2";           // NVS namespace holding "r0"
+
+MQUnifiedsensor mq2("ESP32", 3.3, 12, kMq2Pin, "MQ-2");
+SparkFun_ENS160 ens160;
+Adafruit_AHTX0 aht21;
+SDP810 sdp810;
+
+// ENS160 registers read in one burst: DEVICE_STATUS, DATA_AQI,
+// DATA_TVOC (LE16), DATA_ECO2 (LE16).
+static const uint8_t kEns160Addr = 0x53;
+static const uint8_t kEns160Status = 0x20;
+static const uint8_t kEns160NewData = 0x02;
+static const uint8_t kEns160Error = 0x40;
+static const uint8_t kEns160Invalid = 0x0C;     // VALIDITY == 3
+
+static bool mq2Oversampled;         // the ADC sampler runs; else one analogRead()
+static float mq2R0 = NAN;           // NAN until calibrated
+static std::atomic<bool> mq2Recalibrate{false};
+
+static float loadMq2R0() {
+    Preferences p;
+    p.begin(kMq2Prefs, true);
+    float r0 = p.getFloat("r0", NAN);
+    p.end();
+    return r0;
+}
+
+// Take the current reading as clean air and keep the R0 it gives.
+static bool calibrateMq2() {
+    float r0 = mq2.calibrate(kMq2CleanAir);
+    if(!(r0 > 0) || !isfinite(r0)) return false;
+    mq2.setR0(r0);
+    mq2R0 = r0;
+    Preferences p;
+    p.begin(kMq2Prefs, false);
+    p.putFloat("r0", r0);
+    p.end();
+    return true;
+}
+
+void sensorsBegin() {
+    mq2.init();
+    mq2.setRegressionMethod(1);
+    mq2.setA(574.25); mq2.setB(-2.222);
+    mq2.setRL(5);
+    mq2R0 = loadMq2R0();
+    if(mq2R0 > 0) mq2.setR0(mq2R0);
+    mq2Oversampled = adcSamplerBegin(kMq2Pin);
+    ens160.begin(Wire, kEns160Addr);
+    aht21.begin();
+    sdp810.begin();
+}
+
+void sensorsRecalibrateMq2() {
+    mq2Recalibrate = true;
+}
+
+float sensorsMq2R0() {
+    return mq2R0;
+}
+
+// The MQ-2 voltage comes from the oversampler when it runs.  Without a
+// stored R0 the first reading calibrates, as every boot used to.
+static void sampleMq2(SensorSample &s) {
+    MetricsScope timed(MET_READ_MQ2);
+    uint16_t code;
+    if(!mq2Oversampled) mq2.update();
+    else if(adcSamplerValue(code)) mq2.externalADCUpdate(code * 3.3f / kAdcFullScale);
+    else return;                                // no block yet: stays stale
+    if(mq2Recalibrate.exchange(false) || !(mq2R0 > 0)) calibrateMq2();
+    s.mq2 = mq2.readSensor();
+    s.fresh |= SAMPLE_MQ2;
+}
+
+static void sampleEns160(SensorSample &s) {
+    MetricsScope timed(MET_READ_ENS160);
+    uint8_t d[6];
+    Wire.beginTransmission(kEns160Addr);
+    Wire.write(kEns160Status);
+    bool ok = Wire.endTransmission(false) == 0 &&
+              Wire.requestFrom((int)kEns160Addr, (int)sizeof(d)) == sizeof(d);
+    if(ok) for(size_t i = 0; i < sizeof(d); i++) d[i] = Wire.read();
+    if(!ok || (d[0] & kEns160Error) || (d[0] & kEns160Invalid) == kEns160Invalid) {
+        s.invalid |= SAMPLE_ECO2 | SAMPLE_TVOC;
+        return;
+    }
+    if(!(d[0] & kEns160NewData)) return;       // no new result: keep the last one
+    s.tvoc = (float)(d[2] | (d[3] << 8));
+    s.eco2 = (float)(d[4] | (d[5] << 8));
+    s.fresh |= SAMPLE_ECO2 | SAMPLE_TVOC;
+}
+
+void sensorsSample(SensorSample &s) {
+    s.ms = millis();
+    s.fresh = 0;
+    s.invalid = 0;
+
+    sampleMq2(s);
+    sampleEns160(s);
+
+    sensors_event_t h, t;
+    uint32_t start = micros();
+    bool ok = aht21.getEvent(&h, &t);
+    metricsTime(MET_READ_AHT21, micros() - start);
+    if(ok) {
+        s.temp = t.temperature;
+        s.rh = h.relative_humidity;
+        s.fresh |= SAMPLE_TEMP | SAMPLE_RH;
+    } else {
+        s.invalid |= SAMPLE_TEMP | SAMPLE_RH;
+    }
+
+    start = micros();
+    ok = sdp810.read(s.pressure);
+    metricsTime(MET_READ_SDP810, micros() - start);
+    if(ok) s.fresh |= SAMPLE_PRESSURE;
+    else s.invalid |= SAMPLE_PRESSURE;
+}
@@ -0,0 +1,34 @@
+#include "Topics.h"
+#include "Config.h"
+
+static const size_t kTopicLen = 48;    // "site/" + 24-char name + longest suffix
+static const char *kSuffixes[TOPIC_COUNT] = {"heartbeat", "debug", "scan", "status", "event/"};
+
+static char topics[2][TOPIC_COUNT][kTopicLen];
+static char builtFor[sizeof(Settings::siteName)];
+static volatile uint8_t active;
+static bool built;
+
+void topicsRefresh() {
+    SettingsRef cfg;
+    if(built && strcmp(builtFor, cfg->siteName) == 0) return;
+    strlcpy(builtFor, cfg->siteName, sizeof(builtFor));
+    uint8_t next = active ^ 1;
+    for(uint8_t i = 0; i < TOPIC_COUNT; i++)
+        snprintf(topics[next][i], kTopicLen, "site/%s/%s", builtFor, kSuffixes[i]);
+    active = next;
+    built = true;
+}
+
+const char *topic(Topic t) {
+    if(!built) topicsRefresh();
+    return topics[active][t];
+}
+
+bool eventTopic(char *buf, size_t len, const char *name) {
+    const char *prefix = topic(TOPIC_EVENT);
+    size_t n = strlen(prefix);
+    if(n >= len) return false;
+    memcpy(buf, prefix, n);
+    return strlcpy(buf + n, name, len - n) < len - n;
+}
@@ -0,0 +1,193 @@
+#include "Trace.h"
+#include "Config.h"
+#include "MqttPub.h"
+#include "Topics.h"
+#include <atomic>
+
+static const uint8_t kCores = 2;
+
+enum TraceArgs : uint8_t { ARGS_NONE, ARGS_ONE, ARGS_TWO, ARGS_VALUE };
+
+struct TraceRecord {
+    uint32_t ms;
+    uint8_t event;
+    uint8_t core;
+    int32_t a;
+    int32_t b;                  // the float's bits for ARGS_VALUE
+    const char *tag;
+};
+
+struct Slot {
+    std::atomic<uint32_t> seq;  // position + 1 once written, 0 while being written
+    TraceRecord rec;
+};
+
+struct Ring {
+    std::atomic<uint32_t> head; // next position to claim
+    Slot slot[kTraceSlots];
+};
+
+enum SlotState : uint8_t { SLOT_OK, SLOT_PENDING, SLOT_LOST };
+
+static const struct {
+    const char *name;
+    TraceArgs args;
+} kEvents[TR_COUNT] = {
+    {"wifi_ap", ARGS_NONE},       {"wifi_settings", ARGS_NONE}, {"mqtt_settings", ARGS_NONE},
+    {"wifi_up", ARGS_NONE},       {"wifi_lost", ARGS_NONE},     {"mqtt_up", ARGS_NONE},
+    {"mqtt_fail", ARGS_ONE},      {"mqtt_lost", ARGS_NONE},     {"event", ARGS_VALUE},
+    {"heartbeat", ARGS_NONE},     {"scan_start", ARGS_NONE},    {"scan_abort", ARGS_NONE},
+    {"servo", ARGS_TWO},          {"lidar_nodata", ARGS_NONE},
+};
+
+static Ring rings[kCores];
+static uint32_t sendPos[kCores];        // next record for MQTT; trace task only
+static uint32_t dropped;                // overwritten before they were sent
+static TraceRecord dump[kCores][kTraceSlots];   // traceWrite() only
+
+static void put(TraceEvent e, int32_t a, int32_t b, const char *tag) {
+    uint8_t core = (uint8_t)xPortGetCoreID() % kCores;
+    Ring &r = rings[core];
+    uint32_t pos = r.head.fetch_add(1, std::memory_order_relaxed);
+    Slot &s = r.slot[pos % kTraceSlots];
+    s.seq.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    s.rec = {(uint32_t)millis(), (uint8_t)e, core, a, b, tag};
+    s.seq.store(pos + 1, std::memory_order_release);
+}
+
+void trace(TraceEvent e, int32_t a, int32_t b) {
+    put(e, a, b, nullptr);
+}
+
+void traceValue(TraceEvent e, const char *tag, float value) {
+    int32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    put(e, 0, bits, tag);
+}
+
+// Copy the record at ``pos`` of ring ``core``: PENDING while its writer
+// has not finished, LOST once a newer record took the slot.
+static SlotState readSlot(uint8_t core, uint32_t pos, TraceRecord &out) {
+    const Slot &s = rings[core].slot[pos % kTraceSlots];
+    uint32_t seq = s.seq.load(std::memory_order_acquire);
+    if(seq != pos + 1) return seq && (int32_t)(seq - (pos + 1)) > 0 ? SLOT_LOST : SLOT_PENDING;
+    out = s.rec;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return s.seq.load(std::memory_order_relaxed) == seq ? SLOT_OK : SLOT_LOST;
+}
+
+static bool earlier(const TraceRecord &x, const TraceRecord &y) {
+    return (int32_t)(x.ms - y.ms) < 0;
+}
+
+// One text line for ``r``: "<ms> <core> <event>[ <args>]\n".  Returns its
+// length, which may exceed ``len`` like snprintf().
+static size_t format(const TraceRecord &r, char *buf, size_t len) {
+    const char *name = r.event < TR_COUNT ? kEvents[r.event].name : "?";
+    unsigned long ms = r.ms;
+    int n;
+    switch(r.event < TR_COUNT ? kEvents[r.event].args : ARGS_NONE) {
+        case ARGS_ONE:
+            n = snprintf(buf, len, "%lu %u %s %ld\n", ms, r.core, name, (long)r.a);
+            break;
+        case ARGS_TWO:
+            n = snprintf(buf, len, "%lu %u %s %ld %ld\n", ms, r.core, name, (long)r.a, (long)r.b);
+            break;
+        case ARGS_VALUE: {
+            float v;
+            memcpy(&v, &r.b, sizeof(v));
+            n = snprintf(buf, len, "%lu %u %s %s %.2f\n", ms, r.core, name, r.tag ? r.tag : "", v);
+            break;
+        }
+        default:
+            n = snprintf(buf, len, "%lu %u %s\n", ms, r.core, name);
+            break;
+    }
+    return n > 0 ? n : 0;
+}
+
+// The oldest record not sent yet from either ring, up to ``head``.
+// Returns its core, or -1 when none is ready.
+static int nextRecord(const uint32_t head[kCores], TraceRecord &out) {
+    int pick = -1;
+    TraceRecord rec;
+    for(uint8_t c = 0; c < kCores; c++) {
+        SlotState st = SLOT_PENDING;
+        while(sendPos[c] != head[c] && (st = readSlot(c, sendPos[c], rec)) == SLOT_LOST) {
+            sendPos[c]++;
+            dropped++;
+        }
+        if(sendPos[c] == head[c] || st != SLOT_OK) continue;
+        if(pick < 0 || earlier(rec, out)) {
+            out = rec;
+            pick = c;
+        }
+    }
+    return pick;
+}
+
+void traceDrain() {
+    uint32_t head[kCores];
+    for(uint8_t c = 0; c < kCores; c++) head[c] = rings[c].head.load(std::memory_order_acquire);
+    if(!SettingsRef()->debugEnable) {
+        // Nothing goes out: skip to the present so that turning the stream
+        // on does not replay old records.
+        memcpy(sendPos, head, sizeof(sendPos));
+        dropped = 0;
+        return;
+    }
+    for(uint8_t c = 0; c < kCores; c++) {
+        if(head[c] - sendPos[c] <= kTraceSlots) continue;
+        dropped += head[c] - kTraceSlots - sendPos[c];
+        sendPos[c] = head[c] - kTraceSlots;
+    }
+    char batch[kTraceBatchLen + 1];
+    for(uint8_t sent = 0; sent < kTraceBatches; sent++) {
+        size_t len = 0;
+        if(dropped) {
+            len = snprintf(batch, sizeof(batch), "dropped %lu\n", (unsigned long)dropped);
+            dropped = 0;
+        }
+        TraceRecord rec;
+        int core;
+        while((core = nextRecord(head, rec)) >= 0) {
+            size_t n = format(rec, batch + len, sizeof(batch) - len);
+            if(len + n > kTraceBatchLen) break;     // goes in the next batch
+            len += n;
+            sendPos[core]++;
+        }
+        if(!len) return;
+        batch[len] = 0;
+        pubEnqueue(topic(TOPIC_DEBUG), batch, false);   // never worth buffering offline
+        if(core < 0) return;
+    }
+}
+
+void traceTask(void*) {
+    for(;;) {
+        traceDrain();
+        vTaskDelay(pdMS_TO_TICKS(kTraceDrainMs));
+    }
+}
+
+void traceWrite(Print &out) {
+    uint16_t count[kCores] = {0};
+    for(uint8_t c = 0; c < kCores; c++) {
+        uint32_t head = rings[c].head.load(std::memory_order_acquire);
+        for(uint32_t pos = head - min(head, (uint32_t)kTraceSlots); pos != head; pos++)
+            if(readSlot(c, pos, dump[c][count[c]]) == SLOT_OK) count[c]++;
+    }
+    out.print("# ms core event args\n");
+    char line[64];
+    uint16_t i[kCores] = {0};
+    for(;;) {
+        int pick = -1;
+        for(uint8_t c = 0; c < kCores; c++)
+            if(i[c] < count[c] && (pick < 0 || earlier(dump[c][i[c]], dump[pick][i[pick]])))
+                pick = c;
+        if(pick < 0) return;
+        size_t n = format(dump[pick][i[pick]++], line, sizeof(line));
+        out.write((const uint8_t*)line, min(n, sizeof(line) - 1));
+    }
+}
@@ -0,0 +1,30 @@
+#include "WebUi.h"
+#include "WebAssets.h"
+
+static const char *kCacheImmutable = "public, max-age=31536000, immutable";
+static const char *kCacheRevalidate = "no-cache";
+
+static void serve(AsyncWebServerRequest *req, const WebAsset &asset) {
+    const char *cache = asset.immutable ? kCacheImmutable : kCacheRevalidate;
+    // If-None-Match may list several tags; ours are unique hex strings.
+    const String &match = req->header("If-None-Match");
+    AsyncWebServerResponse *resp;
+    if(match.length() && strstr(match.c_str(), asset.etag)) {
+        resp = req->beginResponse(304);
+    } else {
+        resp = req->beginResponse_P(200, asset.type, asset.data, asset.len);
+        resp->addHeader("Content-Encoding", "gzip");
+    }
+    resp->addHeader("ETag", asset.etag);
+    resp->addHeader("Cache-Control", cache);
+    req->send(resp);
+}
+
+void webUiBegin(AsyncWebServer &server) {
+    for(const WebAsset &asset : kWebAssets) {
+        const WebAsset *a = &asset;
+        server.on(a->path, HTTP_GET, [a](AsyncWebServerRequest *req) { serve(req, *a); });
+        if(strcmp(a->path, "/index.html") == 0)
+            server.on("/", HTTP_GET, [a](AsyncWebServerRequest *req) { serve(req, *a); });
+    }
+}
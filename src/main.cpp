@@ -6,19 +6,28 @@
 #include <Update.h>
 #include <Wire.h>
 #include "Config.h"
-#include "mbedtls/sha256.h"
-#include "mbedtls/base64.h"
-#include <vector>
+#include <memory>
 #include "LedFSM.h"
 #include "NtpSync.h"
 #include "MsgBuffer.h"
-#include "Debug.h"
+#include "MqttPub.h"
+#include "NetMgr.h"
 #include "Filter.h"
 #include <ArduinoJson.h>
-#include <MQUnifiedsensor.h>
-#include "SparkFun_ENS160.h"
-#include <Adafruit_AHTX0.h>
-#include "SDP810.h"
+#include "Scheduler.h"
+#include "Sensors.h"
+#include "Lidar.h"
+#include "Scan.h"
+#include "History.h"
+#include "LivePush.h"
+#include "Readings.h"
+#include "ClogDetect.h"
+#include "Metrics.h"
+#include "Trace.h"
+#include "OtaStream.h"
+#include "Topics.h"
+#include "Auth.h"
+#include "WebUi.h"
 
 WiFiClient espClient;
 PubSubClient mqtt(espClient);
@@ -28,15 +37,27 @@ Servo servoX, servoY;
 
 TaskHandle_t sensorsTaskHandle;
 TaskHandle_t servoTaskHandle;
+TaskHandle_t pubTaskHandle;
+TaskHandle_t traceTaskHandle;
 
-static volatile int servoXAngle = 90;
-static volatile int servoYAngle = 90;
-// Timestamp when the next lidar reading should occur.  Set by the
-// servo task whenever the head is moved.
-static volatile uint32_t lidarDueMs = 0;
+// Head position, owned by servoTask; other tasks read it from Readings.
+static int servoXAngle = 90;
+static int servoYAngle = 90;
+
+// Notification bits for sensorsTask.
+static const uint32_t NOTIFY_LIDAR = 1 << 0;      // head moved: measure now
+static const uint32_t NOTIFY_PERIODS = 1 << 1;    // sampling periods changed
+static const uint32_t NOTIFY_ENV = 1 << 2;        // read the gas/climate sensors now
+
+// A lidar reading averages this many frames, waiting at most kLidarWaitMs
+// for them after the head moved.
+static const uint16_t kLidarFrames = 4;
+static const uint32_t kLidarWaitMs = 500;
+
+enum ServoOp : uint8_t { SERVO_REL, SERVO_ABS, SERVO_SCAN };
 
 struct ServoCmd {
-    bool absolute;
+    ServoOp op;
     int x;
     int y;
 };
@@ -46,44 +67,45 @@ struct ServoCmd {
 static QueueHandle_t servoQueue;
 
 void setServoAngles(int x, int y) {
-    ServoCmd cmd{true, x, y};
+    ServoCmd cmd{SERVO_ABS, x, y};
     if(servoQueue) xQueueSend(servoQueue, &cmd, 0);
 }
 
+// Ask the servo task for a depth-map scan.  Returns false when one is
+// already running or the queue is full.
+bool requestScan() {
+    ServoCmd cmd{SERVO_SCAN, 0, 0};
+    if(!servoQueue || scanStatus().running) return false;
+    return xQueueSend(servoQueue, &cmd, 0) == pdTRUE;
+}
+
 void wsEvent(AsyncWebSocket *server, AsyncWebSocketClient *client,
-             AwsEventType type, void *arg, uint8_t *data, size_t len) {
-    if(type != WS_EVT_DATA) return;
-    String msg = String((char*)data).substring(0, len);
-    ServoCmd cmd{false,0,0};
-    if(msg == "X+") cmd.x = 1;
-    else if(msg == "X-") cmd.x = -1;
-    else if(msg == "Y+") cmd.y = 1;
-    else if(msg == "Y-") cmd.y = -1;
-    else return;
+             AwsEventType type, void*, uint8_t *data, size_t len) {
+    if(type == WS_EVT_CONNECT || type == WS_EVT_DISCONNECT) {
+        liveOnEvent(client, type);
+        metricsSet(MET_WS_CLIENTS, server->count());
+    }
+    // Commands are "X+", "X-", "Y+" and "Y-".
+    if(type != WS_EVT_DATA || len != 2) return;
+    int step = data[1] == '+' ? 1 : data[1] == '-' ? -1 : 0;
+    ServoCmd cmd{SERVO_REL,0,0};
+    if(data[0] == 'X') cmd.x = step;
+    else if(data[0] == 'Y') cmd.y = step;
+    if(!cmd.x && !cmd.y) return;
     if(servoQueue) xQueueSend(servoQueue, &cmd, 0);
 }
 
 TaskHandle_t ledTaskHandle;
-// Filter objects and sensor instances
-MQUnifiedsensor mq2("ESP32", 3.3, 12, 34, "MQ-2");
-SparkFun_ENS160 ens160;
-Adafruit_AHTX0 aht21;
-SDP810 sdp810;
-
-SMAFilter<float, 5> mq2Filter;
+// Filter objects
+// Median for MQ-2: a bag dropping past the sensor gives a one-sample spike
+// that an average would smear into a false smoke alarm.
+MedianFilter<float, 5> mq2Filter;
 SMAFilter<float, 5> eco2Filter;
 SMAFilter<float, 5> tvocFilter;
 SMAFilter<float, 5> tempFilter;
 SMAFilter<float, 5> rhFilter;
 SMAFilter<float, 5> presFilter;
 
-float lastMq2 = 0;
-float lastEco2 = 0;
-float lastTvoc = 0;
-float lastTemp = 0;
-float lastRh = 0;
-float lastLidar = 0;
-float lastPressure = 0;
 unsigned long lastHeartbeat = 0;
 
 // Current alarm state for each sensor used to implement hysteresis
@@ -93,153 +115,67 @@ static bool eco2Alarm  = false;
 static bool tvocAlarm  = false;
 static bool presAlarm  = false;
 
-String hashPassword(const char *pwd) {
-    unsigned char hash[32];
-    mbedtls_sha256_context ctx;
-    mbedtls_sha256_init(&ctx);
-    mbedtls_sha256_starts_ret(&ctx, 0);
-    mbedtls_sha256_update_ret(&ctx, (const unsigned char*)pwd, strlen(pwd));
-    mbedtls_sha256_finish_ret(&ctx, hash);
-    mbedtls_sha256_free(&ctx);
-    char hex[65];
-    for (int i = 0; i < 32; ++i) sprintf(hex + i*2, "%02x", hash[i]);
-    hex[64] = 0;
-    return String(hex);
-}
-
-bool checkAuth(AsyncWebServerRequest *req) {
-    if(!req->hasHeader("Authorization")) return false;
-    String hdr = req->header("Authorization");
-    if(!hdr.startsWith("Basic ")) return false;
-    String enc = hdr.substring(6);
-    size_t enclen = enc.length();
-    size_t outlen = 0;
-    std::vector<unsigned char> out(enclen * 3 / 4 + 1);
-    if(mbedtls_base64_decode(out.data(), out.size(), &outlen,
-                             (const unsigned char*)enc.c_str(), enclen) != 0)
-        return false;
-    out[outlen] = 0;
-    String decoded = String((char*)out.data());
-    int sep = decoded.indexOf(':');
-    if(sep <= 0) return false;
-    String user = decoded.substring(0, sep);
-    String pass = decoded.substring(sep + 1);
-    if(user != settings.uiUser) return false;
-    String hashed = hashPassword(pass.c_str());
-    return hashed == settings.uiPass;
-}
-
-// Connect to Wi-Fi using credentials from Settings.  When no
-// credentials are configured the board starts in AP mode so that
-// the user can provide them via the web interface.
-void connectWiFi() {
-    if(strlen(settings.wifiSSID) == 0) {
-        WiFi.softAP("start", "starttrats");
-        ledSetState(LedState::ERROR);
-        debugPublish("WiFi AP mode");
-        return;
-    }
-    WiFi.mode(WIFI_STA);
-    WiFi.begin(settings.wifiSSID, settings.wifiPass);
-    unsigned long start = millis();
-    while(WiFi.status() != WL_CONNECTED && millis() - start < 10000) {
-        delay(500);
-    }
-    if(WiFi.status() != WL_CONNECTED) {
-        ledSetState(LedState::ERROR);
-        debugPublish("WiFi connect fail");
-    } else {
-        debugPublish("WiFi connected");
-    }
-}
-
-void mqttCallback(char* topic, byte* payload, unsigned int length) {
-    // handle incoming messages
-}
-
-// Establish connection to the MQTT broker defined in Settings and
-// publish the online status.  A Last Will message is registered so
-// that clients are notified when the device goes offline.
-void connectMQTT() {
-    mqtt.setServer(settings.mqttHost, settings.mqttPort);
-    mqtt.setCallback(mqttCallback);
-    char willTopic[64];
-    snprintf(willTopic, sizeof(willTopic), "site/%s/status", settings.siteName);
-    String clientId = String("client-") + String((uint32_t)ESP.getEfuseMac(), HEX);
-    if(!mqtt.connect(clientId.c_str(), settings.mqttUser, settings.mqttPass,
-                     willTopic, settings.mqttQos, true, "offline")) {
-        ledSetState(LedState::ERROR);
-        debugPublish("MQTT connect fail");
-    } else {
-        ledSetState(LedState::NORMAL);
-        debugPublish("MQTT connected");
-        mqtt.publish(willTopic, "online", settings.mqttQos, true);
-    }
-}
-
 // -------- Sensor stubs and publishing helpers --------
 
-float readMQ2() {
-    mq2.update();
-    return mq2.readSensor();
-}
-
-float readEco2() {
-    if(ens160.checkDataStatus())
-        return ens160.getECO2();
-    return lastEco2;
-}
-
-float readTvoc() {
-    if(ens160.checkDataStatus())
-        return ens160.getTVOC();
-    return lastTvoc;
-}
-
-float readTemp() {
-    sensors_event_t h, t;
-    aht21.getEvent(&h, &t);
-    return t.temperature;
-}
-
-float readRh() {
-    sensors_event_t h, t;
-    aht21.getEvent(&h, &t);
-    return h.relative_humidity;
-}
-
-float readPressure() {
-    return sdp810.readPressure();
+// Encode an MQTT payload in the configured format into ``buf``.  Returns
+// its length, or 0 when it does not fit (counted as a failed publish).
+static size_t encodePayload(const JsonDocument &doc, char *buf, size_t len) {
+    bool pack = SettingsRef()->mqttFormat == MQTT_MSGPACK;
+    size_t need = pack ? measureMsgPack(doc) : measureJson(doc);
+    size_t n = 0;
+    if(need > 0 && need < len)          // serializeJson() also writes a terminator
+        n = pack ? serializeMsgPack(doc, buf, len) : serializeJson(doc, buf, len);
+    if(n != need || n == 0) {
+        metricsCount(MET_PUBLISH_FAILS);
+        return 0;
+    }
+    return n;
 }
 
+// Publish an event.  ``name`` must be a string literal: the trace log
+// keeps the pointer.
 void publishEvent(const char* name, float value) {
-    char topic[64];
-    snprintf(topic, sizeof(topic), "site/%s/event/%s", settings.siteName, name);
+    char t[64];
+    if(!eventTopic(t, sizeof(t), name)) return;
     char payload[32];
-    snprintf(payload, sizeof(payload), "%.2f", value);
-    if(mqtt.connected()) mqtt.publish(topic, payload, settings.mqttQos, false);
-    else bufferStore(topic, payload);
-    char dbg[64];
-    snprintf(dbg, sizeof(dbg), "event %s %.2f", name, value);
-    debugPublish(dbg);
+    size_t n;
+    if(SettingsRef()->mqttFormat == MQTT_MSGPACK) {
+        StaticJsonDocument<16> doc;
+        doc.set(value);
+        n = serializeMsgPack(doc, payload, sizeof(payload));
+    } else {
+        n = (size_t)snprintf(payload, sizeof(payload), "%.2f", value);
+    }
+    pubEnqueueBytes(t, payload, n);
+    traceValue(TR_EVENT, name, value);
 }
 
 void publishHeartbeat() {
-    char topic[64];
-    snprintf(topic, sizeof(topic), "site/%s/heartbeat", settings.siteName);
-    StaticJsonDocument<256> doc;
-    doc["smoke"] = lastMq2;
-    doc["lidar"] = lastLidar;
-    doc["pressure"] = lastPressure;
-    doc["eco2"] = lastEco2;
-    doc["tvoc"] = lastTvoc;
-    doc["temp"] = lastTemp;
-    doc["rh"] = lastRh;
+    Readings r;
+    readingsGet(r);
+    StaticJsonDocument<384> doc;
+    doc["smoke"] = r.value[READ_SMOKE];
+    doc["lidar"] = r.value[READ_LIDAR];
+    doc["pressure"] = r.value[READ_PRESSURE];
+    doc["eco2"] = r.value[READ_ECO2];
+    doc["tvoc"] = r.value[READ_TVOC];
+    doc["temp"] = r.value[READ_TEMP];
+    doc["rh"] = r.value[READ_RH];
     doc["heap"] = ESP.getFreeHeap();
-    String out; serializeJson(doc, out);
-    if(mqtt.connected()) mqtt.publish(topic, out.c_str(), settings.mqttQos, false);
-    else bufferStore(topic, out);
-    debugPublish("heartbeat");
+    MetricsSummary ms = metricsSummary();
+    auto m = doc.createNestedObject("metrics");
+    m["block"] = ms.maxBlock;
+    m["stack"] = ms.minStack;
+    m["loopMs"] = ms.loopMs;
+    m["pubMs"] = ms.publishMs;
+    m["flushMs"] = ms.flushMs;
+    m["backlog"] = ms.backlog;
+    m["ws"] = ms.wsClients;
+    m["reconn"] = ms.reconnects;
+    char payload[kPubMaxPayload];
+    size_t n = encodePayload(doc, payload, sizeof(payload));
+    if(n) pubEnqueueBytes(topic(TOPIC_HEARTBEAT), payload, n);
+    trace(TR_HEARTBEAT);
 }
 
 // Apply hysteresis to sensor thresholds. When the current alarm state is
@@ -266,34 +202,74 @@ void checkThreshold(const char *name, float value,
     }
 }
 
+// Publish a new clog grade: ``filling`` with the fill rate in mm/min (0
+// once clear), ``clog_eta`` with the minutes left, or ``clog`` with the
+// distance once blocked.
+static void reportClog() {
+    ClogStatus c = clogStatus();
+    ledSetAlarm(c.level == CLOG_BLOCKED);
+    switch(c.level) {
+        case CLOG_CLEAR:     publishEvent("filling", 0); break;
+        case CLOG_FILLING:   publishEvent("filling", c.rateMmMin); break;
+        case CLOG_PREDICTED: publishEvent("clog_eta", c.etaMin); break;
+        case CLOG_BLOCKED:   publishEvent("clog", c.readMm); break;
+    }
+}
+
 void checkSensors() {
-    mq2Filter.add(readMQ2());
-    eco2Filter.add(readEco2());
-    tvocFilter.add(readTvoc());
-    tempFilter.add(readTemp());
-    rhFilter.add(readRh());
-    presFilter.add(readPressure());
-
-    lastMq2 = mq2Filter.average();
-    lastEco2 = eco2Filter.average();
-    lastTvoc = tvocFilter.average();
-    lastTemp = tempFilter.average();
-    lastRh = rhFilter.average();
-    lastPressure = presFilter.average();
+    static SensorSample sample;
+    sensorsSample(sample);
+    // Only new readings enter the filters; a stale value would count twice.
+    if(sample.isFresh(SAMPLE_MQ2)) mq2Filter.add(sample.mq2);
+    if(sample.isFresh(SAMPLE_ECO2)) eco2Filter.add(sample.eco2);
+    if(sample.isFresh(SAMPLE_TVOC)) tvocFilter.add(sample.tvoc);
+    if(sample.isFresh(SAMPLE_TEMP)) tempFilter.add(sample.temp);
+    if(sample.isFresh(SAMPLE_RH)) rhFilter.add(sample.rh);
+    if(sample.isFresh(SAMPLE_PRESSURE)) presFilter.add(sample.pressure);
+
+    float v[READ_COUNT];
+    v[READ_LIDAR] = NAN;
+    v[READ_SMOKE] = mq2Filter.value();
+    v[READ_ECO2] = eco2Filter.value();
+    v[READ_TVOC] = tvocFilter.value();
+    v[READ_TEMP] = tempFilter.value();
+    v[READ_RH] = rhFilter.value();
+    v[READ_PRESSURE] = presFilter.value();
+
+    // Publish the sensors that were measured, and mark failed ones.
+    static const struct { SampleField field; Reading reading; } kMap[] = {
+        {SAMPLE_MQ2, READ_SMOKE}, {SAMPLE_ECO2, READ_ECO2}, {SAMPLE_TVOC, READ_TVOC},
+        {SAMPLE_TEMP, READ_TEMP}, {SAMPLE_RH, READ_RH}, {SAMPLE_PRESSURE, READ_PRESSURE}};
+    float pub[READ_COUNT];
+    uint8_t mask = 0;
+    for(const auto &m : kMap) {
+        if(sample.isFresh(m.field)) pub[m.reading] = v[m.reading];
+        else if(sample.invalid & m.field) pub[m.reading] = NAN;
+        else continue;
+        mask |= 1 << m.reading;
+    }
+    readingsPublish(mask, pub);
+
+    // Record the filtered values of the sensors that were measured.
+    static_assert((int)READ_COUNT == (int)HIST_COUNT && (int)READ_LIDAR == (int)HIST_LIDAR,
+                  "Reading and HistSensor share one order");
+    float hist[HIST_COUNT];
+    for(float &h : hist) h = NAN;
+    for(const auto &m : kMap)
+        if(sample.isFresh(m.field)) hist[m.reading] = v[m.reading];
+    historyAdd(ntpNow(), hist);
+    if(sample.isFresh(SAMPLE_PRESSURE) && clogAddPressure(v[READ_PRESSURE])) reportClog();
 
     // Check each sensor with 5% hysteresis before publishing alarm events
-    checkThreshold("smoke", lastMq2,
-                   settings.thr.smokeMin, settings.thr.smokeMax, smokeAlarm);
-    checkThreshold("eco2", lastEco2,
-                   settings.thr.eco2Min, settings.thr.eco2Max, eco2Alarm);
-    checkThreshold("tvoc", lastTvoc,
-                   settings.thr.tvocMin, settings.thr.tvocMax, tvocAlarm);
-    checkThreshold("pressure", lastPressure,
-                   settings.thr.presMin, settings.thr.presMax, presAlarm);
+    Thresholds thr = SettingsRef()->thr;
+    checkThreshold("smoke", v[READ_SMOKE], thr.smokeMin, thr.smokeMax, smokeAlarm);
+    checkThreshold("eco2", v[READ_ECO2], thr.eco2Min, thr.eco2Max, eco2Alarm);
+    checkThreshold("tvoc", v[READ_TVOC], thr.tvocMin, thr.tvocMax, tvocAlarm);
+    checkThreshold("pressure", v[READ_PRESSURE], thr.presMin, thr.presMax, presAlarm);
 }
 
-StaticJsonDocument<512> buildSettingsJson() {
-    StaticJsonDocument<512> doc;
+StaticJsonDocument<1280> buildSettingsJson() {
+    StaticJsonDocument<1280> doc;
     doc["siteName"] = settings.siteName;
     auto wifi = doc.createNestedObject("wifi");
     wifi["ssid"] = settings.wifiSSID;
@@ -304,6 +280,8 @@ StaticJsonDocument<512> buildSettingsJson() {
     mqttj["user"] = settings.mqttUser;
     mqttj["pass"] = settings.mqttPass;
     mqttj["qos"]  = settings.mqttQos;
+    mqttj["spillSec"] = settings.bufSpillSec;
+    mqttj["format"] = settings.mqttFormat == MQTT_MSGPACK ? "msgpack" : "json";
     auto thr = doc.createNestedObject("thresholds");
     auto l = thr.createNestedObject("lidar");
     l["min"] = settings.thr.lidarMin; l["max"] = settings.thr.lidarMax;
@@ -318,14 +296,28 @@ StaticJsonDocument<512> buildSettingsJson() {
     auto clog = doc.createNestedObject("clog");
     clog["clogMin"] = settings.clogMin;
     clog["clogHold"] = settings.clogHold;
+    clog["driftMm"] = settings.detect.driftMm;
+    clog["alarmMm"] = settings.detect.alarmMm;
+    clog["driftPa"] = settings.detect.driftPa;
+    clog["alarmPa"] = settings.detect.alarmPa;
+    clog["horizonMin"] = settings.detect.horizonMin;
+    auto periods = doc.createNestedObject("periods");
+    periods["env"] = settings.envPeriodSec;
+    periods["lidar"] = settings.lidarPeriodSec;
+    periods["lidarFast"] = settings.lidarFastSec;
+    auto scan = doc.createNestedObject("scan");
+    scan["xMin"] = settings.scan.xMin; scan["xMax"] = settings.scan.xMax;
+    scan["yMin"] = settings.scan.yMin; scan["yMax"] = settings.scan.yMax;
+    scan["cols"] = settings.scan.cols; scan["rows"] = settings.scan.rows;
+    scan["periodMin"] = settings.scan.periodMin;
     doc["debugEnable"] = settings.debugEnable;
     doc["uiUser"] = settings.uiUser;
     return doc;
 }
 
 void handleSettingsPost(AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t, size_t) {
-    if(!checkAuth(request)) { request->requestAuthentication(); return; }
-    StaticJsonDocument<512> doc;
+    if(!authCheck(request)) { request->requestAuthentication(); return; }
+    StaticJsonDocument<1280> doc;
     if(deserializeJson(doc, data, len)) {
         request->send(400, "text/plain", "Bad JSON");
         return;
@@ -341,6 +333,9 @@ void handleSettingsPost(AsyncWebServerRequest *request, uint8_t *data, size_t le
         strlcpy(settings.mqttUser, mqttj["user"] | settings.mqttUser, sizeof(settings.mqttUser));
         strlcpy(settings.mqttPass, mqttj["pass"] | settings.mqttPass, sizeof(settings.mqttPass));
         settings.mqttQos = mqttj["qos"] | settings.mqttQos;
+        settings.bufSpillSec = mqttj["spillSec"] | settings.bufSpillSec;
+        const char *format = mqttj["format"] | "";
+        if(*format) settings.mqttFormat = strcmp(format, "msgpack") == 0 ? MQTT_MSGPACK : MQTT_JSON;
     }
     JsonObject thr = doc["thresholds"]; if(!thr.isNull()) {
         JsonObject l = thr["lidar"]; if(!l.isNull()) { settings.thr.lidarMin = l["min"] | settings.thr.lidarMin; settings.thr.lidarMax = l["max"] | settings.thr.lidarMax; }
@@ -349,46 +344,148 @@ void handleSettingsPost(AsyncWebServerRequest *request, uint8_t *data, size_t le
         JsonObject t = thr["tvoc"]; if(!t.isNull()) { settings.thr.tvocMin = t["min"] | settings.thr.tvocMin; settings.thr.tvocMax = t["max"] | settings.thr.tvocMax; }
         JsonObject p = thr["pressure"]; if(!p.isNull()) { settings.thr.presMin = p["min"] | settings.thr.presMin; settings.thr.presMax = p["max"] | settings.thr.presMax; }
     }
-    JsonObject clog = doc["clog"]; if(!clog.isNull()) { settings.clogMin = clog["clogMin"] | settings.clogMin; settings.clogHold = clog["clogHold"] | settings.clogHold; }
+    JsonObject clog = doc["clog"]; if(!clog.isNull()) {
+        settings.clogMin = clog["clogMin"] | settings.clogMin;
+        settings.clogHold = clog["clogHold"] | settings.clogHold;
+        // A zero alarm level would latch the alarm, a zero drift stop the
+        // empty-chute distance from following the chute back up.
+        ClogDetectSettings &d = settings.detect;
+        d.driftMm = constrain(clog["driftMm"] | (int)d.driftMm, 1, 1000);
+        d.alarmMm = constrain(clog["alarmMm"] | (int)d.alarmMm, 10, 5000);
+        d.driftPa = constrain(clog["driftPa"] | d.driftPa, 0.0f, 500.0f);
+        d.alarmPa = constrain(clog["alarmPa"] | d.alarmPa, 1.0f, 5000.0f);
+        d.horizonMin = constrain(clog["horizonMin"] | (int)d.horizonMin, 1, 10080);
+    }
+    JsonObject periods = doc["periods"]; if(!periods.isNull()) {
+        uint16_t env = periods["env"] | 0, lidar = periods["lidar"] | 0;   // 0: keep
+        if(env) settings.envPeriodSec = env;
+        if(lidar) settings.lidarPeriodSec = lidar;
+        uint16_t fast = periods["lidarFast"] | 0;
+        if(fast) settings.lidarFastSec = fast;
+    }
+    JsonObject scan = doc["scan"]; if(!scan.isNull()) {
+        ScanSettings &g = settings.scan;
+        g.xMin = constrain(scan["xMin"] | g.xMin, 0, 180);
+        g.xMax = constrain(scan["xMax"] | g.xMax, 0, 180);
+        g.yMin = constrain(scan["yMin"] | g.yMin, 0, 180);
+        g.yMax = constrain(scan["yMax"] | g.yMax, 0, 180);
+        g.cols = constrain(scan["cols"] | g.cols, 2, kScanMaxDim);
+        g.rows = constrain(scan["rows"] | g.rows, 2, kScanMaxDim);
+        g.periodMin = scan["periodMin"] | g.periodMin;
+    }
     settings.debugEnable = doc["debugEnable"] | settings.debugEnable;
-    const char *user = doc["uiUser"] | settings.uiUser; strlcpy(settings.uiUser, user, sizeof(settings.uiUser));
-    saveSettings();
+    strlcpy(settings.uiUser, doc["uiUser"] | settings.uiUser, sizeof(settings.uiUser));
+    settingsCommit();                   // the listeners apply what changed
     request->send(200, "text/plain", "OK");
 }
 
 void handlePasswordPost(AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t, size_t) {
-    if(!checkAuth(request)) { request->requestAuthentication(); return; }
+    if(!authCheck(request)) { request->requestAuthentication(); return; }
     StaticJsonDocument<128> doc;
     if(deserializeJson(doc, data, len)) { request->send(400, "text/plain", "Bad JSON"); return; }
     const char* p = doc["password"];
     if(p) {
-        String hashed = hashPassword(p);
-        strlcpy(settings.uiPass, hashed.c_str(), sizeof(settings.uiPass));
-        saveSettings();
+        authHashPassword(p, settings.uiPass);
+        settingsCommit();
     }
     request->send(200, "text/plain", "OK");
 }
 
-float readLidar() {
-    // Read distance value from SF11c via UART1
-    while(Serial1.available()) Serial1.read();
-    Serial1.setTimeout(50);
-    String resp = Serial1.readStringUntil('\n');
-    return resp.toFloat();
+// Answer a successful login with a session token, both as a cookie for the
+// web UI and in the body for scripts sending it as a bearer token.
+static void sendSession(AsyncWebServerRequest *request) {
+    char token[kTokenLen + 1];
+    authIssue(token);
+    char cookie[112];
+    snprintf(cookie, sizeof(cookie), "session=%s; Path=/; Max-Age=%lu; HttpOnly; SameSite=Strict",
+             token, (unsigned long)kSessionSec);
+    char body[80];
+    snprintf(body, sizeof(body), "{\"token\":\"%s\",\"expires\":%lu}", token,
+             (unsigned long)kSessionSec);
+    AsyncWebServerResponse *resp = request->beginResponse(200, "application/json", body);
+    resp->addHeader("Set-Cookie", cookie);
+    request->send(resp);
+}
+
+void handleLoginPost(AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t, size_t) {
+    StaticJsonDocument<192> doc;
+    if(deserializeJson(doc, data, len)) { request->send(400, "text/plain", "Bad JSON"); return; }
+    if(!authVerify(doc["user"] | "", doc["password"] | "")) {
+        request->send(401, "text/plain", "Unauthorized");
+        return;
+    }
+    sendSession(request);
+}
+
+static void scanMove(int x, int y) {
+    servoX.write(x);
+    servoY.write(y);
+}
+
+// A manual command stops the scan; it is handled once the scan returns.
+static bool scanAbort() {
+    return uxQueueMessagesWaiting(servoQueue) > 0;
+}
+
+// Scan the chute, publish the fill metrics and return the head to the
+// manually set position.
+static void runScan() {
+    trace(TR_SCAN_START);
+    ScanSettings grid;
+    uint16_t clogMin;
+    {
+        SettingsRef cfg;                // not held for the whole scan
+        grid = cfg->scan;
+        clogMin = cfg->clogMin;
+    }
+    bool ok = scanRun(grid, clogMin, scanMove, scanAbort);
+    servoX.write(servoXAngle);
+    servoY.write(servoYAngle);
+    if(!ok) {
+        trace(TR_SCAN_ABORT);
+        return;
+    }
+    ScanMetrics m;
+    scanMetrics(m);
+    StaticJsonDocument<128> doc;
+    doc["min"] = m.minMm;
+    doc["blocked"] = m.blockedPct;
+    doc["changed"] = m.changedPct;
+    doc["delta"] = m.meanDeltaMm;
+    doc["valid"] = m.validPct;
+    doc["ms"] = scanStatus().durationMs;
+    char payload[160];
+    size_t n = encodePayload(doc, payload, sizeof(payload));
+    if(n) pubEnqueueBytes(topic(TOPIC_SCAN), payload, n);
 }
 
 // Task controlling the two servos that aim the lidar sensor. After
-// moving to the requested position a measurement is triggered via
-// ``lidarDueMs``.
+// moving to the requested position a measurement is requested from
+// sensorsTask with a task notification.  Between commands the task runs
+// the scheduled depth-map scans.
 void servoTask(void*) {
     servoX.attach(4);
     servoY.attach(5);
     servoX.write(servoXAngle);
     servoY.write(servoYAngle);
     ServoCmd cmd;
+    uint32_t lastScan = millis();
     for(;;) {
-        if(xQueueReceive(servoQueue, &cmd, portMAX_DELAY)) {
-            if(cmd.absolute) {
+        // Re-read the period on every pass so that settings changes apply;
+        // with scheduling off, look again once a minute.
+        uint32_t period = SettingsRef()->scan.periodMin * 60000UL;
+        uint32_t wait = 60000;
+        if(period) {
+            uint32_t since = millis() - lastScan;
+            wait = since < period ? period - since : 0;
+        }
+        bool got = xQueueReceive(servoQueue, &cmd, pdMS_TO_TICKS(wait));
+        if(!got && !period) continue;
+        if(!got || cmd.op == SERVO_SCAN) {
+            runScan();
+            lastScan = millis();
+        } else {
+            if(cmd.op == SERVO_ABS) {
                 servoXAngle = constrain(cmd.x, 0, 180);
                 servoYAngle = constrain(cmd.y, 0, 180);
             } else {
@@ -397,95 +494,249 @@ void servoTask(void*) {
             }
             servoX.write(servoXAngle);
             servoY.write(servoYAngle);
-            char buf[32];
-            snprintf(buf, sizeof(buf), "servo %d %d", servoXAngle, servoYAngle);
-            debugPublish(buf);
-            vTaskDelay(pdMS_TO_TICKS(100));
-            lidarDueMs = millis();
+            readingsSetHead(servoXAngle, servoYAngle);
+            trace(TR_SERVO, servoXAngle, servoYAngle);
         }
+        vTaskDelay(pdMS_TO_TICKS(100));
+        lidarFlush();                   // average only frames from the new position
+        xTaskNotify(sensorsTaskHandle, NOTIFY_LIDAR, eSetBits);
     }
 }
 
-// Background task that periodically samples all sensors and triggers
-// lidar measurements.  Gas and pressure sensors are checked once a
-// minute while the lidar runs every ten minutes or when requested by
-// the servo task.
+// Take a lidar reading and run clog detection on it.  Without a recent
+// frame from the sensor the reading is skipped rather than taken as zero.
+static void lidarJob() {
+    if(scanStatus().running) return;   // the head is sweeping; measure after the scan
+    LidarReading r;
+    {
+        MetricsScope timed(MET_READ_LIDAR);
+        lidarWait(r, kLidarFrames, kLidarWaitMs);
+    }
+    float v[READ_COUNT];
+    v[READ_LIDAR] = r.valid ? r.distance : NAN;
+    readingsPublish(1 << READ_LIDAR, v);
+    if(!r.valid) {
+        trace(TR_LIDAR_NODATA);
+        return;
+    }
+    float dist = r.distance;
+    float hist[HIST_COUNT];
+    for(float &h : hist) h = NAN;
+    hist[HIST_LIDAR] = dist;
+    historyAdd(ntpNow(), hist);
+    Thresholds thr = SettingsRef()->thr;
+    // Apply hysteresis when checking distance limits
+    checkThreshold("lidar", dist, thr.lidarMin, thr.lidarMax, lidarAlarm);
+    if(clogAddLidar(millis(), dist)) reportClog();
+    ledSetAlarm(clogStatus().level == CLOG_BLOCKED);    // the link state is NetMgr's
+}
+
+// Lidar period for the fill state of the chute, between lidarFastSec and
+// lidarPeriodSec (see clogSamplePeriodMs()).
+static uint32_t lidarPeriodMs() {
+    SettingsRef cfg;
+    uint32_t fast = max<uint32_t>(cfg->lidarFastSec, 1) * 1000UL;
+    return clogSamplePeriodMs(fast, max<uint32_t>(cfg->lidarPeriodSec, 1) * 1000UL);
+}
+
+// Background task that samples all sensors.  Each sensor group is a
+// scheduler job with its own period from Settings; the lidar period is
+// adapted after every run to how close the chute is to clogging.  The task
+// sleeps until the next deadline or until notified by the servo task or a
+// settings change.
 void sensorsTask(void*) {
-    const TickType_t delayStep = pdMS_TO_TICKS(100);    // task loop period
-    const uint32_t lidarPeriod = 600000;                // 10 min between lidar scans
     Wire.begin(8, 3);
-    Serial1.begin(115200, SERIAL_8N1, 9, 10);
-    mq2.init();
-    mq2.setRegressionMethod(1);
-    mq2.setA(574.25); mq2.setB(-2.222);
-    mq2.setRL(5);
-    mq2.calibrate(9.83);
-    ens160.begin();
-    aht21.begin();
-    sdp810.begin();
-    uint32_t lastLidarTs = 0;          // last time the lidar was triggered
-    uint8_t clogCnt = 0;               // consecutive readings below clogMin
-    uint32_t lastSensors = 0;          // last time environmental sensors were read
+    sensorsBegin();
+    Scheduler sched;
+    uint32_t now = millis();
+    int envJob = sched.add(checkSensors, SettingsRef()->envPeriodSec * 1000UL, now);
+    int lidarJobId = sched.add(lidarJob, lidarPeriodMs(), now);
     for(;;) {
-        uint32_t now = millis();
-        if(now - lastSensors >= 60000) {       // update environmental sensors once a minute
-            checkSensors();
-            lastSensors = now;
-        }
-        if((now - lastLidarTs >= lidarPeriod) || (lidarDueMs && now >= lidarDueMs)) {
-            float dist = readLidar();
-            lastLidar = dist;
-            lastLidarTs = now;
-            // Apply hysteresis when checking distance limits
-            checkThreshold("lidar", dist,
-                           settings.thr.lidarMin, settings.thr.lidarMax, lidarAlarm);
-            lidarDueMs = 0;
-            if(dist < settings.clogMin) {
-                if(++clogCnt >= settings.clogHold) {
-                    if(clogCnt == settings.clogHold) {
-                        publishEvent("clog", dist);
-                    }
-                    ledSetState(LedState::ALARM);
-                }
-            } else {
-                clogCnt = 0;
-                ledSetState(LedState::NORMAL);
-            }
+        {
+            MetricsScope timed(MET_SENSORS_LOOP);
+            sched.runDue(millis());
         }
-        vTaskDelay(delayStep);
+        sched.setPeriod(lidarJobId, lidarPeriodMs());
+        uint32_t bits = 0;
+        xTaskNotifyWait(0, UINT32_MAX, &bits, sched.msUntilNext(millis()) / portTICK_PERIOD_MS);
+        if(bits & NOTIFY_LIDAR) sched.trigger(lidarJobId, millis());
+        if(bits & NOTIFY_PERIODS) sched.setPeriod(envJob, SettingsRef()->envPeriodSec * 1000UL);
+        if(bits & NOTIFY_ENV) sched.trigger(envJob, millis());
     }
 }
 
+// Public key OTA packages are signed for: the 130 hex digits of the
+// uncompressed P-256 point, set at build time from $OTA_PUBLIC_KEY (see
+// platformio.ini and tools/ota_pack.py --public).  The private key is not
+// in the image.
+#ifndef OTA_PUBLIC_KEY
+#error "OTA_PUBLIC_KEY is not set"
+#endif
+static const char kOtaKeyHex[] = OTA_PUBLIC_KEY;
+static_assert(sizeof(kOtaKeyHex) == 2 * kOtaPublicKeyLen + 1,
+              "OTA_PUBLIC_KEY must be 130 hex digits, see tools/ota_pack.py --public");
+static uint8_t otaKey[kOtaPublicKeyLen];
+
+static uint8_t hexNibble(char c) {
+    if(c >= '0' && c <= '9') return c - '0';
+    if(c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if(c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return 0;
+}
+
+// Firmware upload in progress, owned by the web server task.
+static OtaStream ota;
+static AsyncWebServerRequest *otaOwner;
+static bool otaDone;
+
+// Flash the decoded image, opening the update on the first block with the
+// size from the manifest.
+static bool otaWrite(const uint8_t *data, size_t len) {
+    if(!Update.isRunning() && !Update.begin(ota.manifest().imageSize))
+        return false;
+    return Update.write((uint8_t*)data, len) == len;
+}
+
 void setupWeb() {
+    for(size_t i = 0; i < kOtaPublicKeyLen; i++)
+        otaKey[i] = hexNibble(kOtaKeyHex[2 * i]) << 4 | hexNibble(kOtaKeyHex[2 * i + 1]);
+    webUiBegin(server);
     server.on("/api/settings", HTTP_GET, [](AsyncWebServerRequest *req){
-        if(!checkAuth(req)) return req->requestAuthentication();
-        StaticJsonDocument<512> doc = buildSettingsJson();
-        String out; serializeJson(doc, out);
-        req->send(200, "application/json", out);
+        if(!authCheck(req)) return req->requestAuthentication();
+        AsyncResponseStream *res = req->beginResponseStream("application/json");
+        serializeJson(buildSettingsJson(), *res);
+        req->send(res);
     });
     server.on("/api/settings", HTTP_POST, [](AsyncWebServerRequest *request){
-        if(!checkAuth(request)) return request->requestAuthentication();
+        if(!authCheck(request)) return request->requestAuthentication();
     }, NULL, handleSettingsPost);
     server.on("/api/password", HTTP_POST, [](AsyncWebServerRequest *request){
-        if(!checkAuth(request)) return request->requestAuthentication();
+        if(!authCheck(request)) return request->requestAuthentication();
     }, NULL, handlePasswordPost);
+    // Without a body the login takes the Basic credentials the browser
+    // already holds; with one it checks {"user":..., "password":...}.
+    server.on("/api/login", HTTP_POST, [](AsyncWebServerRequest *request){
+        if(request->contentLength()) return;
+        if(!authCheck(request)) return request->requestAuthentication();
+        sendSession(request);
+    }, NULL, handleLoginPost);
     server.on("/api/live", HTTP_GET, [](AsyncWebServerRequest *req){
-        StaticJsonDocument<256> doc;
-        doc["lidar"] = lastLidar;
-        doc["smoke"] = lastMq2;
-        doc["eco2"] = lastEco2;
-        doc["tvoc"] = lastTvoc;
-        doc["pressure"] = lastPressure;
-        doc["temp"] = lastTemp;
-        doc["rh"] = lastRh;
-        doc["x"] = servoXAngle;
-        doc["y"] = servoYAngle;
-        String out; serializeJson(doc, out);
-        req->send(200, "application/json", out);
+        Readings r;
+        readingsGet(r);
+        StaticJsonDocument<384> doc;
+        doc["lidar"] = r.value[READ_LIDAR];
+        doc["smoke"] = r.value[READ_SMOKE];
+        doc["eco2"] = r.value[READ_ECO2];
+        doc["tvoc"] = r.value[READ_TVOC];
+        doc["pressure"] = r.value[READ_PRESSURE];
+        doc["temp"] = r.value[READ_TEMP];
+        doc["rh"] = r.value[READ_RH];
+        doc["x"] = r.headX;
+        doc["y"] = r.headY;
+        BufferStats bs = bufferStats();
+        ClogStatus c = clogStatus();
+        auto clog = doc.createNestedObject("clog");
+        clog["level"] = (int)c.level;
+        clog["rate"] = c.rateMmMin;
+        clog["eta"] = c.etaMin;
+        auto buf = doc.createNestedObject("buffer");
+        buf["ram"] = bs.ram;
+        buf["spilled"] = bs.spilled;
+        buf["dropped"] = bs.dropped;
+        PubStats ps = pubStats();
+        auto pub = doc.createNestedObject("mqtt");
+        pub["depth"] = ps.depth;
+        pub["maxDepth"] = ps.maxDepth;
+        pub["lastUs"] = ps.lastUs;
+        pub["maxUs"] = ps.maxUs;
+        AsyncResponseStream *res = req->beginResponseStream("application/json");
+        serializeJson(doc, *res);
+        req->send(res);
+    });
+
+    // Health metrics in the Prometheus text format, for scraping.
+    server.on("/api/metrics", HTTP_GET, [](AsyncWebServerRequest *req){
+        AsyncResponseStream *res = req->beginResponseStream("text/plain; version=0.0.4");
+        metricsWrite(*res);
+        req->send(res);
+    });
+
+    // The last kTraceSlots trace records of each core, as text.
+    server.on("/api/trace", HTTP_GET, [](AsyncWebServerRequest *req){
+        if(!authCheck(req)) return req->requestAuthentication();
+        AsyncResponseStream *res = req->beginResponseStream("text/plain");
+        traceWrite(*res);
+        req->send(res);
+    });
+
+    // Recalibrate the MQ-2 in clean air with the next reading, taken now.
+    server.on("/api/calibrate", HTTP_POST, [](AsyncWebServerRequest *req){
+        if(!authCheck(req)) return req->requestAuthentication();
+        sensorsRecalibrateMq2();
+        if(sensorsTaskHandle) xTaskNotify(sensorsTaskHandle, NOTIFY_ENV, eSetBits);
+        req->send(202, "text/plain", "Calibration queued");
+    });
+
+    server.on("/api/scan", HTTP_POST, [](AsyncWebServerRequest *req){
+        if(!authCheck(req)) return req->requestAuthentication();
+        if(requestScan()) req->send(202, "text/plain", "Scan queued");
+        else req->send(409, "text/plain", "Scan busy");
+    });
+    // Latest depth map as rows of millimetres (0 = no reading) with its
+    // fill metrics, written straight to the response without a JSON doc.
+    server.on("/api/scan", HTTP_GET, [](AsyncWebServerRequest *req){
+        static DepthMap map;            // too large for the web task's stack
+        ScanMetrics m;
+        bool have = scanLatest(map, m);
+        ScanStatus st = scanStatus();
+        AsyncResponseStream *out = req->beginResponseStream("application/json");
+        out->printf("{\"running\":%s,\"done\":%u,\"total\":%u",
+                    st.running ? "true" : "false", st.done, st.total);
+        if(have) {
+            out->printf(",\"age\":%lu,\"durationMs\":%lu,\"min\":%u,\"valid\":%u,"
+                        "\"blocked\":%u,\"changed\":%u,\"delta\":%d,\"cols\":%u,\"rows\":%u,\"grid\":[",
+                        (unsigned long)((millis() - map.ms) / 1000), (unsigned long)st.durationMs,
+                        m.minMm, m.validPct, m.blockedPct, m.changedPct, m.meanDeltaMm,
+                        map.cols, map.rows);
+            for(int r = 0; r < map.rows; r++) {
+                out->print(r ? ",[" : "[");
+                for(int c = 0; c < map.cols; c++)
+                    out->printf(c ? ",%u" : "%u", map.mm[r * map.cols + c]);
+                out->print("]");
+            }
+            out->print("]");
+        }
+        out->print("}");
+        req->send(out);
+    });
+
+    // /api/history?sensor=lidar&from=<unix>&to=<unix>&step=<s>.  Defaults to
+    // the last 24 h in about 300 points.  The reader lives as long as the
+    // response and produces it one chunk at a time.
+    server.on("/api/history", HTTP_GET, [](AsyncWebServerRequest *req){
+        HistSensor sensor;
+        if(!req->hasParam("sensor") ||
+           !historySensorFromName(req->getParam("sensor")->value().c_str(), sensor)) {
+            req->send(400, "text/plain", "Unknown sensor");
+            return;
+        }
+        uint32_t to = req->hasParam("to") ? req->getParam("to")->value().toInt() : (uint32_t)ntpNow();
+        uint32_t from = req->hasParam("from") ? req->getParam("from")->value().toInt() : to - 86400;
+        uint32_t step = req->hasParam("step") ? req->getParam("step")->value().toInt() : 0;
+        if(from > to) {
+            req->send(400, "text/plain", "Bad range");
+            return;
+        }
+        if(!step) step = max((to - from) / 300, (uint32_t)1);
+        std::shared_ptr<HistoryReader> reader(new HistoryReader(sensor, from, to, step));
+        req->send(req->beginChunkedResponse("application/json",
+            [reader](uint8_t *buf, size_t maxLen, size_t) -> size_t {
+                return reader->readJson(buf, maxLen);
+            }));
     });
 
     server.on("/api/servo", HTTP_POST, [](AsyncWebServerRequest *request){
-        if(!checkAuth(request))
+        if(!authCheck(request))
             return request->requestAuthentication();
     }, NULL, [](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t, size_t){
         StaticJsonDocument<128> doc;
@@ -493,44 +744,65 @@ void setupWeb() {
             request->send(400, "text/plain", "Bad JSON");
             return;
         }
-        int x = doc["x"] | servoXAngle;
-        int y = doc["y"] | servoYAngle;
+        Readings r;
+        readingsGet(r);
+        int x = doc["x"] | (int)r.headX;
+        int y = doc["y"] | (int)r.headY;
         setServoAngles(x, y);
         request->send(200, "text/plain", "OK");
     });
     server.on("/update", HTTP_POST,
         [](AsyncWebServerRequest *request){
-            if(!checkAuth(request))
+            if(!authCheck(request))
                 return request->requestAuthentication();
-            bool ok = !Update.hasError();
+            bool ok = request == otaOwner && otaDone;
+            otaOwner = nullptr;
             AsyncWebServerResponse *resp = request->beginResponse(200, "text/plain", ok ? "OK" : "FAIL");
             resp->addHeader("Connection", "close");
             resp->addHeader("X-Site-Name", settings.siteName);
             request->send(resp);
-            if(ok) ESP.restart();
+            if(ok) {
+                settingsFlush();
+                historySave();
+                ESP.restart();
+            }
         },
-        [](AsyncWebServerRequest *request, String filename, size_t index, uint8_t *data, size_t len, bool final){
+        [](AsyncWebServerRequest *request, String, size_t index, uint8_t *data, size_t len, bool final){
             static AsyncResponseStream *progress = nullptr;
             static size_t last = 0;
             if(!index){
-                if(!checkAuth(request)) return;
-                if(!Update.begin(UPDATE_SIZE_UNKNOWN)) Update.printError(Serial);
+                // Only an authenticated request starts an upload, and only
+                // its own later chunks are written.
+                if(!authCheck(request)) return;
+                if(Update.isRunning()) Update.abort();  // an upload that never finished
+                otaOwner = request;
+                otaDone = false;
+                ota.begin(otaWrite, otaKey);
                 progress = request->beginResponseStream("text/plain");
                 progress->addHeader("X-Site-Name", settings.siteName);
                 last = 0;
             }
-            if(!Update.hasError()){
-                if(Update.write(data, len) != len) Update.printError(Serial);
-            }
-            size_t p = (index + len) * 100 / request->contentLength();
-            if(progress && (p - last >= 5 || final)){
-                progress->printf("%u\n", p);
+            if(request != otaOwner) return;
+            ota.feed(data, len);
+            // Without a Content-Length there is no percentage to report.
+            size_t length = request->contentLength();
+            size_t p = length ? (index + len) * 100 / length : 0;
+            if(progress && length && (p - last >= 5 || final)){
+                progress->printf("%u\n", (unsigned)p);
                 last = p;
             }
             if(final){
-                if(Update.end(true)) Serial.printf("Update Success: %u bytes\n", index + len);
-                else Update.printError(Serial);
+                otaDone = ota.finish() && Update.end(true);
+                if(otaDone) {
+                    Serial.printf("Update Success: %lu bytes\n", (unsigned long)ota.written());
+                } else {
+                    if(ota.error()) Serial.printf("Update rejected: %s\n", OtaStream::errorText(ota.error()));
+                    else Update.printError(Serial);
+                    if(Update.isRunning()) Update.abort();
+                }
                 if(progress){
+                    if(otaDone) progress->print("OK\n");
+                    else progress->printf("FAIL %s\n", ota.error() ? OtaStream::errorText(ota.error()) : "flash");
                     progress->addHeader("Connection", "close");
                     progress->addHeader("X-Site-Name", settings.siteName);
                     request->send(progress);
@@ -538,38 +810,53 @@ void setupWeb() {
                 }
             }
         });
+    liveBegin(&ws);
     ws.onEvent(wsEvent);
     server.addHandler(&ws);
     server.begin();
 }
 
+// Apply a settings commit to the state kept here.  Thresholds, the scan
+// grid and the payload format need nothing: their readers take a snapshot
+// on every use.
+static void onSettingsChanged(uint32_t changed) {
+    if(changed & SET_SITE) topicsRefresh();
+    if(changed & SET_UI) authReset();   // sessions belong to the old credentials
+    if((changed & SET_PERIODS) && sensorsTaskHandle)
+        xTaskNotify(sensorsTaskHandle, NOTIFY_PERIODS, eSetBits);
+}
+
 void setup() {
     Serial.begin(115200);
     loadSettings();
+    topicsRefresh();
+    settingsSubscribe(SET_SITE | SET_UI | SET_PERIODS, onSettingsChanged);
     ledInit(2);
     xTaskCreate(ledTask, "led", 1024, nullptr, 1, &ledTaskHandle);
-    connectWiFi();                       // establish network connection
-    ntpBegin();                          // start periodic NTP time sync
-    connectMQTT();                       // connect to broker and publish status
     bufferInit();
+    historyInit();
+    pubInit();                           // queue trace output from here on
+    netBegin();                          // start connecting, never blocks
+    ntpBegin();                          // start periodic NTP time sync
+    xTaskCreatePinnedToCore(pubTask, "mqtt", 6144, nullptr, 2, &pubTaskHandle, 0);
+    xTaskCreatePinnedToCore(traceTask, "trace", 3072, nullptr, 1, &traceTaskHandle, 0);
     setupWeb();
+    lidarBegin(Serial1, 9, 10);
     servoQueue = xQueueCreate(4, sizeof(ServoCmd));
-    xTaskCreatePinnedToCore(servoTask, "servo", 2048, nullptr, 1, &servoTaskHandle, 1);
+    // The servo task also runs scans and publishes their metrics.
+    xTaskCreatePinnedToCore(servoTask, "servo", 4096, nullptr, 1, &servoTaskHandle, 1);
     xTaskCreatePinnedToCore(sensorsTask, "sensors", 4096, nullptr, 1, &sensorsTaskHandle, 1);
+    metricsWatchTask("led", ledTaskHandle);
+    metricsWatchTask("mqtt", pubTaskHandle);
+    metricsWatchTask("trace", traceTaskHandle);
+    metricsWatchTask("servo", servoTaskHandle);
+    metricsWatchTask("sensors", sensorsTaskHandle);
 }
 
 void loop() {
-    static bool wasConnected = false;
-    mqtt.loop();                       // maintain MQTT connection
     ntpLoop();                         // refresh NTP time if needed
-    if(!mqtt.connected()) {
-        connectMQTT();
-    }
-    bool connected = mqtt.connected();
-    if(connected && !wasConnected) {
-        bufferFlush();
-    }
-    wasConnected = connected;
+    livePush();                        // changed live values to the web UI
+    settingsService();                 // write settings saved 2 s ago
 
     unsigned long now = millis();
     // Send a summary of sensor readings every hour (3600000 ms)
@@ -0,0 +1,120 @@
+"""Pack web/ into include/WebAssets.h.
+
+Each asset is minified, gzipped and emitted as a byte array with its
+content type and an ETag taken from the compressed bytes.  index.html
+refers to the other assets with ``?v=<etag>`` so that they can be cached
+for a year: a firmware with a changed UI also changes the URLs.
+
+Runs before every PlatformIO build (``extra_scripts``) and rewrites the
+header only when its contents change.  Can also be run by hand:
+
+    python3 tools/embed_web.py
+"""
+import gzip
+import hashlib
+import os
+import re
+
+ASSETS = [
+    # name, content type, cached for a year
+    ("style.css", "text/css", True),
+    ("script.js", "application/javascript; charset=utf-8", True),
+    ("index.html", "text/html; charset=utf-8", False),
+]
+
+
+def minify_css(text):
+    text = re.sub(r"/\*.*?\*/", "", text, flags=re.S)
+    text = re.sub(r"\s+", " ", text)
+    return re.sub(r"\s*([{};:,>])\s*", r"\1", text).strip()
+
+
+def minify_js(text):
+    # Only layout is removed: indentation, blank lines and whole-line
+    # comments.  Nothing inside a line is touched, so strings are safe.
+    lines = (line.strip() for line in text.splitlines())
+    return "\n".join(l for l in lines if l and not l.startswith("//"))
+
+
+def minify_html(text):
+    text = re.sub(r"<!--.*?-->", "", text, flags=re.S)
+    lines = (line.strip() for line in text.splitlines())
+    return "\n".join(l for l in lines if l)
+
+
+MINIFY = {".css": minify_css, ".js": minify_js, ".html": minify_html}
+
+
+def c_name(name):
+    stem, ext = os.path.splitext(name)
+    return "k" + "".join(p.capitalize() for p in re.split(r"[^A-Za-z0-9]", stem)) + ext[1:].capitalize()
+
+
+def build(root):
+    web = os.path.join(root, "web")
+    etags = {}
+    out = [
+        "// Generated by tools/embed_web.py from web/ -- do not edit.",
+        "#ifndef WEB_ASSETS_H",
+        "#define WEB_ASSETS_H",
+        "#include <stddef.h>",
+        "#include <stdint.h>",
+        "",
+        "struct WebAsset {",
+        "    const char *path;",
+        "    const char *type;",
+        "    const char *etag;           // quoted, as sent in the header",
+        "    const uint8_t *data;        // gzip",
+        "    size_t len;",
+        "    bool immutable;             // URL carries the version",
+        "};",
+        "",
+    ]
+    table = []
+    for name, ctype, immutable in ASSETS:
+        with open(os.path.join(web, name), encoding="utf-8") as f:
+            text = f.read()
+        ext = os.path.splitext(name)[1]
+        text = MINIFY[ext](text)
+        if name == "index.html":
+            for ref, tag in etags.items():
+                text = re.sub(r'(["\'])%s\1' % re.escape(ref), r'\g<1>%s?v=%s\1' % (ref, tag), text)
+        data = gzip.compress(text.encode("utf-8"), compresslevel=9, mtime=0)
+        tag = hashlib.sha256(data).hexdigest()[:16]
+        etags[name] = tag
+        var = c_name(name)
+        out.append("// %s: %d bytes minified, %d gzipped" % (name, len(text.encode("utf-8")), len(data)))
+        out.append("static const uint8_t %s[] = {" % var)
+        for i in range(0, len(data), 16):
+            out.append("    " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+        out.append("};")
+        out.append("")
+        table.append('    {"/%s", "%s", "\\"%s\\"", %s, sizeof(%s), %s},'
+                     % (name, ctype, tag, var, var, "true" if immutable else "false"))
+    out.append("static const WebAsset kWebAssets[] = {")
+    out.extend(table)
+    out.append("};")
+    out.append("")
+    out.append("#endif // WEB_ASSETS_H")
+    return "\n".join(out) + "\n"
+
+
+def write(root):
+    path = os.path.join(root, "include", "WebAssets.h")
+    text = build(root)
+    try:
+        with open(path, encoding="utf-8") as f:
+            if f.read() == text:
+                return
+    except OSError:
+        pass
+    with open(path, "w", encoding="utf-8") as f:
+        f.write(text)
+    print("embed_web: wrote " + path)
+
+
+try:
+    Import("env")  # noqa: F821 -- defined when run by PlatformIO
+    write(env["PROJECT_DIR"])  # noqa: F821
+except NameError:
+    write(os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
@@ -0,0 +1,206 @@
+"""Pack a firmware image into a signed .ota upload (see include/OtaStream.h).
+
+The package is a 108-byte manifest (magic, version, format, heatshrink
+window and lookahead, image size, SHA-256 of the image, ECDSA P-256
+signature of the manifest) followed by the image, heatshrink-compressed
+unless --raw is given.  The signing key is a P-256 private key in PEM, as
+openssl makes it:
+
+    openssl ecparam -name prime256v1 -genkey -noout -out ota_key.pem
+    export OTA_SIGNING_KEY=$PWD/ota_key.pem
+    export OTA_PUBLIC_KEY=$(python3 tools/ota_pack.py --public)
+    pio run
+    python3 tools/ota_pack.py .pio/build/esp32-s3-devkitc-1/firmware.bin
+
+writes firmware.ota next to the image.  The firmware only holds the public
+key; keep the PEM off the device and out of the repository.
+"""
+import argparse
+import base64
+import hashlib
+import os
+import re
+import secrets
+import struct
+import sys
+
+MAGIC = b"CHPO"
+VERSION = 2
+FORMAT_PLAIN = 0
+FORMAT_HEATSHRINK = 1
+WINDOW = 11         # heatshrink -w: 2 KB window, the most the firmware decodes
+LOOKAHEAD = 4       # heatshrink -l: copies of up to 16 bytes
+MAX_CHAIN = 32      # candidates tried per position
+
+
+# P-256 (SEC 2) in plain Python.  Not constant-time: sign on the build
+# machine, not on a shared server.
+P = 0xFFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF
+N = 0xFFFFFFFF00000000FFFFFFFFFFFFFFFFBCE6FAADA7179E84F3B9CAC2FC632551
+G = (0x6B17D1F2E12C4247F8BCE6E563A440F277037D812DEB33A0F4A13945D898C296,
+     0x4FE342E2FE1A7F9B8EE7EB4A7C0F9E162BCE33576B315ECECBB6406837BF51F5)
+CURVE_OID = bytes.fromhex("06082a8648ce3d030107")      # prime256v1
+
+
+def point_add(a, b):
+    if a is None:
+        return b
+    if b is None:
+        return a
+    if a[0] == b[0]:
+        if (a[1] + b[1]) % P == 0:
+            return None
+        m = 3 * (a[0] * a[0] - 1) * pow(2 * a[1], -1, P)
+    else:
+        m = (b[1] - a[1]) * pow(b[0] - a[0], -1, P)
+    x = (m * m - a[0] - b[0]) % P
+    return x, (m * (a[0] - x) - a[1]) % P
+
+
+def point_mul(k, pt=G):
+    acc = None
+    for bit in bin(k)[2:]:
+        acc = point_add(acc, acc)
+        if bit == "1":
+            acc = point_add(acc, pt)
+    return acc
+
+
+def public_key(d):
+    """Uncompressed SEC1 point, as the firmware takes it."""
+    x, y = point_mul(d)
+    return b"\x04" + x.to_bytes(32, "big") + y.to_bytes(32, "big")
+
+
+def sign(d, message):
+    """ECDSA-SHA256, r || s big-endian."""
+    e = int.from_bytes(hashlib.sha256(message).digest(), "big")
+    while True:
+        k = secrets.randbelow(N - 1) + 1
+        r = point_mul(k)[0] % N
+        s = pow(k, -1, N) * (e + r * d) % N
+        if r and s:
+            return r.to_bytes(32, "big") + s.to_bytes(32, "big")
+
+
+def load_key(path):
+    """The private scalar from a SEC1 ("EC PRIVATE KEY") or PKCS#8 PEM."""
+    with open(path) as f:
+        text = f.read()
+    m = re.search(r"-----BEGIN (EC )?PRIVATE KEY-----(.*?)-----END", text, re.S)
+    if not m:
+        sys.exit("ota_pack: %s: no private key in PEM" % path)
+    der = base64.b64decode(m.group(2))
+    # Both forms hold the SEC1 structure: version 1, then the 32-byte key.
+    at = der.find(b"\x02\x01\x01\x04\x20")
+    if at < 0 or CURVE_OID not in der:
+        sys.exit("ota_pack: %s: not a P-256 private key" % path)
+    d = int.from_bytes(der[at + 5:at + 37], "big")
+    if not 0 < d < N:
+        sys.exit("ota_pack: %s: bad private key" % path)
+    return d
+
+
+class BitWriter:
+    def __init__(self):
+        self.out = bytearray()
+        self.acc = 0
+        self.bits = 0
+
+    def put(self, value, n):
+        self.acc = (self.acc << n) | value
+        self.bits += n
+        while self.bits >= 8:
+            self.bits -= 8
+            self.out.append((self.acc >> self.bits) & 0xFF)
+        self.acc &= (1 << self.bits) - 1
+
+    def finish(self):
+        if self.bits:
+            self.out.append((self.acc << (8 - self.bits)) & 0xFF)
+        return bytes(self.out)
+
+
+def heatshrink(data, window=WINDOW, lookahead=LOOKAHEAD):
+    """Greedy LZSS in the heatshrink bit format."""
+    size = 1 << window
+    longest = 1 << lookahead
+    # A copy costs 1 + window + lookahead bits, a literal 9.
+    shortest = (1 + window + lookahead) // 9 + 1
+    chains = {}
+    w = BitWriter()
+    i = 0
+    n = len(data)
+    while i < n:
+        best_len, best_dist = 0, 0
+        if i + shortest <= n:
+            key = data[i:i + shortest]
+            limit = min(longest, n - i)
+            for j in reversed(chains.get(key, ())[-MAX_CHAIN:]):
+                dist = i - j
+                if dist > size:
+                    break
+                k = shortest
+                while k < limit and data[j + k] == data[i + k]:
+                    k += 1
+                if k > best_len:
+                    best_len, best_dist = k, dist
+                    if k == limit:
+                        break
+        step = best_len if best_len >= shortest else 1
+        if step > 1:
+            w.put(0, 1)
+            w.put(best_dist - 1, window)
+            w.put(best_len - 1, lookahead)
+        else:
+            w.put(1, 1)
+            w.put(data[i], 8)
+        for p in range(i, i + step):
+            if p + shortest <= n:
+                chain = chains.setdefault(data[p:p + shortest], [])
+                chain.append(p)
+                if len(chain) > 2 * MAX_CHAIN:
+                    del chain[:MAX_CHAIN]
+        i += step
+    return w.finish()
+
+
+def pack(image, d, raw=False):
+    fmt = FORMAT_PLAIN if raw else FORMAT_HEATSHRINK
+    body = image if raw else heatshrink(image)
+    manifest = MAGIC + struct.pack("<BBBBI", VERSION, fmt, WINDOW, LOOKAHEAD, len(image))
+    manifest += hashlib.sha256(image).digest()
+    return manifest + sign(d, manifest) + body
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("image", nargs="?")
+    ap.add_argument("-o", "--output", help="default: the image with .ota")
+    ap.add_argument("--raw", action="store_true", help="do not compress")
+    ap.add_argument("--key", default=os.environ.get("OTA_SIGNING_KEY"),
+                    help="private key PEM (default: $OTA_SIGNING_KEY)")
+    ap.add_argument("--public", action="store_true",
+                    help="print the public key for OTA_PUBLIC_KEY and exit")
+    args = ap.parse_args()
+    if not args.key:
+        sys.exit("ota_pack: no signing key: pass --key or set OTA_SIGNING_KEY")
+    d = load_key(args.key)
+    if args.public:
+        print(public_key(d).hex())
+        return
+    if not args.image:
+        ap.error("no image")
+    with open(args.image, "rb") as f:
+        image = f.read()
+    package = pack(image, d, args.raw)
+    output = args.output or os.path.splitext(args.image)[0] + ".ota"
+    with open(output, "wb") as f:
+        f.write(package)
+    print("ota_pack: %s, %d -> %d bytes (%.0f%%)" % (
+        output, len(image), len(package), 100.0 * len(package) / max(len(image), 1)),
+        file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
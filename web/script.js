@@ -14,18 +14,23 @@
         localStorage.setItem('theme', theme);
     });
 
+    // Frames pushed over the socket carry only the fields that changed, so
+    // they are merged into the last known values.
+    const live = {};
+
     function updateLive(data) {
+        Object.assign(live, data);
         const row = document.createElement('tr');
         row.innerHTML = [
-            data.lidar,
-            data.smoke,
-            data.eco2,
-            data.tvoc,
-            data.temp,
-            data.rh,
-            data.x,
-            data.y
-        ].map(v => `<td>${v}</td>`).join('');
+            live.lidar,
+            live.smoke,
+            live.eco2,
+            live.tvoc,
+            live.temp,
+            live.rh,
+            live.x,
+            live.y
+        ].map(v => `<td>${v ?? '—'}</td>`).join('');
         liveTable.innerHTML = '';
         liveTable.appendChild(row);
         if(lastUpdate) lastUpdate.textContent = new Date().toLocaleTimeString();
@@ -35,8 +40,109 @@
         fetch('/api/live').then(r => r.json()).then(updateLive).catch(() => {});
     }
 
-    setInterval(fetchLive, 5000);
+    // The device pushes live values over the WebSocket, which also carries
+    // the servo commands.  While it is down, poll the REST API instead.
+    let ws = null;
+    let pollTimer = null;
+
+    function connectWs() {
+        ws = new WebSocket(`ws://${location.host}/ws`);
+        ws.onopen = () => {
+            clearInterval(pollTimer);
+            pollTimer = null;
+        };
+        ws.onmessage = ev => {
+            try { updateLive(JSON.parse(ev.data)); } catch (e) {}
+        };
+        ws.onclose = () => {
+            if (!pollTimer) pollTimer = setInterval(fetchLive, 5000);
+            setTimeout(connectWs, 3000);
+        };
+    }
+
     fetchLive();
+    connectWs();
+
+    // Depth map: near cells red, far cells green, no reading grey.
+    const scanCanvas = document.getElementById('scan-canvas');
+    const scanMetrics = document.getElementById('scan-metrics');
+    const scanButton = document.getElementById('scan-button');
+    let scanTimer = null;
+
+    function drawScan(data) {
+        const ctx = scanCanvas.getContext('2d');
+        ctx.clearRect(0, 0, scanCanvas.width, scanCanvas.height);
+        if (!data.grid) return;
+        const cw = scanCanvas.width / data.cols;
+        const ch = scanCanvas.height / data.rows;
+        const cells = data.grid.flat().filter(v => v > 0);
+        const lo = Math.min(...cells), hi = Math.max(...cells);
+        data.grid.forEach((row, r) => row.forEach((v, c) => {
+            const t = hi > lo ? (v - lo) / (hi - lo) : 1;
+            ctx.fillStyle = v > 0 ? `hsl(${Math.round(t * 120)},70%,50%)` : '#888';
+            ctx.fillRect(c * cw, r * ch, cw, ch);
+        }));
+    }
+
+    function fetchScan() {
+        fetch('/api/scan').then(r => r.json()).then(data => {
+            if (data.running) {
+                scanMetrics.textContent = `Сканирование: ${data.done}/${data.total}`;
+            } else if (data.grid) {
+                scanMetrics.textContent = `min ${data.min} мм, перекрыто ${data.blocked}%, ` +
+                    `изменение ${data.changed}% (${data.delta} мм), ${Math.round(data.durationMs / 1000)} с`;
+            }
+            drawScan(data);
+            clearTimeout(scanTimer);
+            scanTimer = setTimeout(fetchScan, data.running ? 2000 : 30000);
+        }).catch(() => {});
+    }
+
+    scanButton.addEventListener('click', () => {
+        fetch('/api/scan', { method: 'POST' }).then(() => setTimeout(fetchScan, 500));
+    });
+    fetchScan();
+
+    // Trend chart: min/max band with the average on top.
+    const historyCanvas = document.getElementById('history-canvas');
+    const historySensor = document.getElementById('history-sensor');
+    const historyRange = document.getElementById('history-range');
+
+    function drawHistory(data) {
+        const ctx = historyCanvas.getContext('2d');
+        const w = historyCanvas.width, h = historyCanvas.height;
+        ctx.clearRect(0, 0, w, h);
+        const pts = data.points || [];
+        if (pts.length < 2) return;
+        const t0 = pts[0][0], t1 = pts[pts.length - 1][0];
+        const lo = Math.min(...pts.map(p => p[1])), hi = Math.max(...pts.map(p => p[2]));
+        const x = t => (t - t0) / (t1 - t0 || 1) * w;
+        const y = v => h - 4 - (v - lo) / (hi - lo || 1) * (h - 8);
+        ctx.fillStyle = 'rgba(70,130,180,0.3)';
+        ctx.beginPath();
+        pts.forEach((p, i) => i ? ctx.lineTo(x(p[0]), y(p[2])) : ctx.moveTo(x(p[0]), y(p[2])));
+        pts.slice().reverse().forEach(p => ctx.lineTo(x(p[0]), y(p[1])));
+        ctx.fill();
+        ctx.strokeStyle = 'steelblue';
+        ctx.beginPath();
+        pts.forEach((p, i) => i ? ctx.lineTo(x(p[0]), y(p[3])) : ctx.moveTo(x(p[0]), y(p[3])));
+        ctx.stroke();
+        ctx.fillStyle = getComputedStyle(document.body).color;
+        ctx.fillText(hi, 2, 10);
+        ctx.fillText(lo, 2, h - 2);
+    }
+
+    function fetchHistory() {
+        const to = Math.floor(Date.now() / 1000);
+        const from = to - Number(historyRange.value);
+        fetch(`/api/history?sensor=${historySensor.value}&from=${from}&to=${to}`)
+            .then(r => r.json()).then(drawHistory).catch(() => {});
+    }
+
+    historySensor.addEventListener('change', fetchHistory);
+    historyRange.addEventListener('change', fetchHistory);
+    setInterval(fetchHistory, 60000);
+    fetchHistory();
 
     function loadSettings() {
         fetch('/api/settings')
@@ -52,6 +158,8 @@
                 document.getElementById('mqtt-user').value = mqtt.user || '';
                 document.getElementById('mqtt-pass').value = mqtt.pass || '';
                 document.getElementById('mqtt-qos').value = mqtt.qos || 0;
+                document.getElementById('mqtt-spill').value = mqtt.spillSec || 0;
+                document.getElementById('mqtt-format').value = mqtt.format || 'json';
                 const thr = data.thresholds || {};
                 if (thr.lidar) {
                     document.getElementById('lidar-min').value = thr.lidar.min;
@@ -76,13 +184,32 @@
                 const clog = data.clog || {};
                 document.getElementById('clog-min').value = clog.clogMin || '';
                 document.getElementById('clog-hold').value = clog.clogHold || '';
+                document.getElementById('clog-drift-mm').value = clog.driftMm ?? '';
+                document.getElementById('clog-alarm-mm').value = clog.alarmMm ?? '';
+                document.getElementById('clog-drift-pa').value = clog.driftPa ?? '';
+                document.getElementById('clog-alarm-pa').value = clog.alarmPa ?? '';
+                document.getElementById('clog-horizon').value = clog.horizonMin ?? '';
+                const periods = data.periods || {};
+                document.getElementById('period-env').value = periods.env || '';
+                document.getElementById('period-lidar').value = periods.lidar || '';
+                document.getElementById('period-lidar-fast').value = periods.lidarFast || '';
+                const scan = data.scan || {};
+                document.getElementById('scan-xmin').value = scan.xMin ?? '';
+                document.getElementById('scan-xmax').value = scan.xMax ?? '';
+                document.getElementById('scan-ymin').value = scan.yMin ?? '';
+                document.getElementById('scan-ymax').value = scan.yMax ?? '';
+                document.getElementById('scan-cols').value = scan.cols ?? '';
+                document.getElementById('scan-rows').value = scan.rows ?? '';
+                document.getElementById('scan-period').value = scan.periodMin ?? '';
                 document.getElementById('debug-enable').checked = !!data.debugEnable;
                 document.getElementById('ui-user').value = data.uiUser || '';
             })
             .catch(() => {});
     }
 
-    loadSettings();
+    // Trade the browser's Basic credentials for a session cookie, which the
+    // device checks without hashing the password on every request.
+    fetch('/api/login', { method: 'POST' }).finally(loadSettings);
 
     // Settings submit
     const settingsForm = document.getElementById('settings-form');
@@ -99,7 +226,9 @@
                 port: Number(document.getElementById('mqtt-port').value),
                 user: document.getElementById('mqtt-user').value,
                 pass: document.getElementById('mqtt-pass').value,
-                qos: Number(document.getElementById('mqtt-qos').value)
+                qos: Number(document.getElementById('mqtt-qos').value),
+                spillSec: Number(document.getElementById('mqtt-spill').value),
+                format: document.getElementById('mqtt-format').value
             },
             thresholds: {
                 lidar: {
@@ -125,7 +254,26 @@
             },
             clog: {
                 clogMin: Number(document.getElementById('clog-min').value),
-                clogHold: Number(document.getElementById('clog-hold').value)
+                clogHold: Number(document.getElementById('clog-hold').value),
+                driftMm: Number(document.getElementById('clog-drift-mm').value),
+                alarmMm: Number(document.getElementById('clog-alarm-mm').value),
+                driftPa: Number(document.getElementById('clog-drift-pa').value),
+                alarmPa: Number(document.getElementById('clog-alarm-pa').value),
+                horizonMin: Number(document.getElementById('clog-horizon').value)
+            },
+            periods: {
+                env: Number(document.getElementById('period-env').value),
+                lidar: Number(document.getElementById('period-lidar').value),
+                lidarFast: Number(document.getElementById('period-lidar-fast').value)
+            },
+            scan: {
+                xMin: Number(document.getElementById('scan-xmin').value),
+                xMax: Number(document.getElementById('scan-xmax').value),
+                yMin: Number(document.getElementById('scan-ymin').value),
+                yMax: Number(document.getElementById('scan-ymax').value),
+                cols: Number(document.getElementById('scan-cols').value),
+                rows: Number(document.getElementById('scan-rows').value),
+                periodMin: Number(document.getElementById('scan-period').value)
             },
             debugEnable: document.getElementById('debug-enable').checked,
             uiUser: document.getElementById('ui-user').value
@@ -137,6 +285,13 @@
         });
     });
 
+    // MQ-2 calibration: the next reading is taken as clean air.
+    document.getElementById('mq2-calibrate').addEventListener('click', () => {
+        if (confirm('Датчик MQ-2 сейчас в чистом воздухе?')) {
+            fetch('/api/calibrate', { method: 'POST' });
+        }
+    });
+
     // Password change
     const pwForm = document.getElementById('password-form');
     pwForm.addEventListener('submit', ev => {
@@ -157,9 +312,7 @@
     otaButton.addEventListener('click', () => otaModal.classList.add('show'));
     otaCancel.addEventListener('click', () => otaModal.classList.remove('show'));
 
-    // WebSocket for servo control
-    const ws = new WebSocket(`ws://${location.host}/ws`);
-
+    // Servo control
     function sendCmd(cmd) {
         if (ws.readyState === WebSocket.OPEN) {
             ws.send(cmd);